@@ -109,6 +109,8 @@ struct State {
 	uint8_t nEnabledOutputPorts;
 	uint8_t nEnabledInputPorts;
 	uint8_t DiagPriority;				///< ArtPoll : Field 6 : The lowest priority of diagnostics message that should be sent.
+	uint32_t nDmxAccepted;				///< ArtDmx packets output on at least one port
+	uint32_t nDmxRejected;				///< ArtDmx packets for an unpatched Port-Address or discarded by the merge
 	struct {
 		uint32_t nDiscoveryMillis;
 		uint32_t nDiscoveryPortIndex;
@@ -133,15 +135,53 @@ struct Node {
 	bool bMapUniverse0;										///< Art-Net 4
 };
 
-struct Source {
-	uint32_t nMillis;	///< The latest time of the data received from port
-	uint32_t nIp;		///< The IP address for port
-	uint16_t nPhysical;	///< The physical input port from which DMX512 data was input.
+/**
+ * Port-Address -> output port index lookup table, used by HandleDmx.
+ * Rebuilt by UpdatePortAddressMap whenever the address, direction or protocol of a port changes.
+ */
+struct PortAddressMap {
+	static constexpr uint32_t FILTER_WORDS = 256 / 32;
+	uint32_t Filter[FILTER_WORDS];			///< One bit per Port-Address bits 7-0 (Sub-Net + Universe)
+	uint16_t PortAddress[MAX_PORTS];		///< Sorted, ports sharing a Port-Address are adjacent
+	uint8_t nPortIndex[MAX_PORTS];
+	uint32_t nEntries;
+
+	bool IsFiltered(const uint16_t nPortAddress) const {
+		const auto nBit = static_cast<uint32_t>(nPortAddress & 0xFF);
+		return (Filter[nBit >> 5] & (1U << (nBit & 0x1F))) == 0;
+	}
 };
 
+namespace diag {
+enum class Event : uint8_t {
+	FIRST_PACKET, SOURCE_SET, SOURCE_NEW, SOURCE_MERGE, SOURCE_IGNORED, DISCARD,
+	OUT_OF_SEQUENCE,
+	BUFFERING_DATA, SEND_DATA, LEAVING_MERGE,
+	SYNC_PORT, SYNC_ALL,
+	INPUT_SENT, INPUT_SENT_TIMEOUT, INPUT_LOCAL_MERGE, INPUT_NO_UPDATES, INPUT_TIMEOUT,
+	UNDEFINED
+};
+
+static constexpr uint32_t RING_SIZE = 32;	///< Must be a power of 2
+static constexpr uint32_t SEND_MAX = 4;		///< ArtDiagData packets sent per SendDiagRun
+
+/**
+ * Single producer (SendDiag), single consumer (SendDiagRun)
+ */
+struct Ring {
+	struct {
+		Event event;
+		uint8_t nPriority;
+		uint16_t nArg0;
+		uint16_t nArg1;
+	} Entry[RING_SIZE];
+	uint32_t nHead;
+	uint32_t nTail;
+	uint32_t nOverruns;
+};
+}  // namespace diag
+
 struct OutputPort {
-	Source SourceA ALIGNED;
-	Source SourceB ALIGNED;
 	uint32_t nIpRdm;
 	uint8_t GoodOutput;
 	uint8_t GoodOutputB;
@@ -187,13 +227,24 @@ public:
 	void Start();
 	void Stop();
 
-	void Run() {
+	/**
+	 * @return true when a datagram was received, more may be waiting
+	 */
+	bool Run() {
 		uint16_t nForeignPort;
 		const auto nBytesReceived = Network::Get()->RecvFrom(m_nHandle, const_cast<const void **>(reinterpret_cast<void **>(&m_pReceiveBuffer)), &m_nIpAddressFrom, &nForeignPort);
 		m_nCurrentPacketMillis = Hardware::Get()->Millis();
 
 		Process(nBytesReceived);
 
+#if defined (ARTNET_ENABLE_SENDDIAG)
+		if (__builtin_expect((m_DiagRing.nHead != m_DiagRing.nTail), 0)) {
+			if ((nBytesReceived == 0) || ((m_DiagRing.nHead - m_DiagRing.nTail) >= (artnetnode::diag::RING_SIZE / 2))) {
+				SendDiagRun();
+			}
+		}
+#endif
+
 #if (ARTNET_VERSION >= 4)
 		E131Bridge::Run();
 #endif
@@ -250,6 +301,8 @@ public:
 #if defined (DMXCONFIGUDP_H)
 		m_DmxConfigUdp.Run();
 #endif
+
+		return (nBytesReceived != 0);
 	}
 
 #if defined (ARTNET_SHOWFILE)
@@ -458,6 +511,14 @@ public:
 		return m_State.bDisableMergeTimeout;
 	}
 
+	uint32_t GetDmxAccepted() const {
+		return m_State.nDmxAccepted;
+	}
+
+	uint32_t GetDmxRejected() const {
+		return m_State.nDmxRejected;
+	}
+
 #if defined (ARTNET_HAVE_TIMECODE)
 	void SendTimeCode(const struct artnet::TimeCode *pArtNetTimeCode) {
 		assert(pArtNetTimeCode != nullptr);
@@ -578,9 +639,12 @@ private:
 	void SetNetSwitch(const uint32_t nPortIndex, const uint8_t nNetSwitch);
 	void SetSubnetSwitch(const uint32_t nPortIndex, const uint8_t nSubnetSwitch);
 
-	void SendDiag([[maybe_unused]] const artnet::PriorityCodes priorityCode, [[maybe_unused]] const char *format, ...) {
+	/**
+	 * Only records the event, formatting and sending the ArtDiagData is done from SendDiagRun
+	 */
+	void SendDiag([[maybe_unused]] const artnet::PriorityCodes priorityCode, [[maybe_unused]] const artnetnode::diag::Event event, [[maybe_unused]] const uint32_t nArg0 = 0, [[maybe_unused]] const uint32_t nArg1 = 0) {
 #if defined (ARTNET_ENABLE_SENDDIAG)
-		if (!m_State.SendArtDiagData) {
+		if (__builtin_expect((!m_State.SendArtDiagData), 1)) {
 			return;
 		}
 
@@ -588,25 +652,25 @@ private:
 			return;
 		}
 
-		m_DiagData.Priority = static_cast<uint8_t>(priorityCode);
-
-		va_list arp;
-
-		va_start(arp, format);
-
-		auto i = vsnprintf(reinterpret_cast<char *>(m_DiagData.Data), sizeof(m_DiagData.Data) - 1, format, arp);
+		auto& ring = m_DiagRing;
 
-		va_end(arp);
-
-		m_DiagData.Data[sizeof(m_DiagData.Data) - 1] = '\0';	// Just be sure we have a last '\0'
-		m_DiagData.LengthLo = static_cast<uint8_t>(i + 1);		// Text length including the '\0'
+		if ((ring.nHead - ring.nTail) == artnetnode::diag::RING_SIZE) {
+			ring.nOverruns++;
+			return;
+		}
 
-		const uint16_t nSize = sizeof(struct artnet::ArtDiagData) - sizeof(m_DiagData.Data) + m_DiagData.LengthLo;
+		auto& entry = ring.Entry[ring.nHead & (artnetnode::diag::RING_SIZE - 1)];
+		entry.event = event;
+		entry.nPriority = static_cast<uint8_t>(priorityCode);
+		entry.nArg0 = static_cast<uint16_t>(nArg0);
+		entry.nArg1 = static_cast<uint16_t>(nArg1);
 
-		Network::Get()->SendTo(m_nHandle, &m_DiagData, nSize, m_State.ArtDiagIpAddress, artnet::UDP_PORT);
+		ring.nHead++;
 #endif
 	}
 
+	void SendDiagRun();
+
 	void HandlePoll();
 	void HandleDmx();
 	void HandleSync();
@@ -629,8 +693,10 @@ private:
 		return artnet::make_port_address(m_Node.Port[nPage].NetSwitch, m_Node.Port[nPage].SubSwitch, nUniverse);
 	}
 
+	void UpdatePortAddressMap();
+	bool HandleDmxPort(const uint32_t nPortIndex, const artnet::ArtDmx *pArtDmx, const uint32_t nDmxSlots);
 	void UpdateMergeStatus(const uint32_t nPortIndex);
-	void CheckMergeTimeouts(const uint32_t nPortIndex);
+	void ClearMergeStatus(const uint32_t nPortIndex);
 
 	void ProcessPollRelply(const uint32_t nPortIndex, uint32_t& NumPortsInput, uint32_t& NumPortsOutput);
 	void SendPollRelply(const uint32_t nBindIndex, const uint32_t nDestinationIp, artnet::ArtPollQueue *pQueue = nullptr);
@@ -704,6 +770,7 @@ private:
 	artnetnode::State m_State;
 	artnetnode::OutputPort m_OutputPort[artnetnode::MAX_PORTS];
 	artnetnode::InputPort m_InputPort[artnetnode::MAX_PORTS];
+	artnetnode::PortAddressMap m_PortAddressMap;
 
 	artnet::ArtPollReply m_ArtPollReply;
 #if defined (ARTNET_HAVE_DMXIN)
@@ -728,6 +795,7 @@ private:
 #endif
 #if defined (ARTNET_ENABLE_SENDDIAG)
 	artnet::ArtDiagData m_DiagData;
+	artnetnode::diag::Ring m_DiagRing;
 #endif
 #if defined (DMXCONFIGUDP_H_)
 	DmxConfigUdp m_DmxConfigUdp;
@@ -170,10 +170,6 @@ private:
 		return static_cast<lightset::PortDir>((m_Params.nDirection >> (nPortIndex * 2)) & 0x3);
 	}
 
-	uint16_t portdir_set(const uint32_t nPortIndex, const lightset::PortDir portDir) {
-		return static_cast<uint16_t>((static_cast<uint32_t>(portDir) & 0x3) << (nPortIndex * 2));
-	}
-
 	lightset::MergeMode mergemode_get(const uint32_t nPortIndex) {
 		return static_cast<lightset::MergeMode>((m_Params.nMergeMode >> (nPortIndex * 2)) & 0x3);
 	}
@@ -184,7 +180,6 @@ private:
 
 	void Dump();
 	void callbackFunction(const char *pLine);
-	void SetBool(const uint8_t nValue, const uint32_t nMask);
 	bool isMaskSet(uint32_t nMask) const {
 		return (m_Params.nSetList & nMask) == nMask;
 	}
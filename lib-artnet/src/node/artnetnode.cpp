@@ -105,14 +105,14 @@ ArtNetNode::ArtNetNode() {
 		port.direction = lightset::PortDir::DISABLE;
 	}
 
+	UpdatePortAddressMap();
+
 	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
 		SetShortName(nPortIndex, nullptr);	// Set default port label
 	}
 
 	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
 		memset(&m_OutputPort[nPortIndex], 0, sizeof(struct artnetnode::OutputPort));
-		m_OutputPort[nPortIndex].SourceA.nPhysical = 0x100;
-		m_OutputPort[nPortIndex].SourceB.nPhysical = 0x100;
 		m_OutputPort[nPortIndex].GoodOutputB = artnet::GoodOutputB::RDM_DISABLED | artnet::GoodOutputB::DISCOVERY_NOT_RUNNING;
 		memset(&m_InputPort[nPortIndex], 0, sizeof(struct artnetnode::InputPort));
 		m_InputPort[nPortIndex].nDestinationIp = Network::Get()->GetBroadcastIp();
@@ -139,6 +139,7 @@ ArtNetNode::ArtNetNode() {
 	memcpy(m_DiagData.Id, artnet::NODE_ID, sizeof(m_DiagData.Id));
 	m_DiagData.OpCode = static_cast<uint16_t>(artnet::OpCodes::OP_DIAGDATA);
 	m_DiagData.ProtVerLo = artnet::PROTOCOL_REVISION;
+	memset(&m_DiagRing, 0, sizeof(struct artnetnode::diag::Ring));
 #endif
 
 	DEBUG_EXIT
@@ -384,7 +385,7 @@ void ArtNetNode::SetNetworkDataLossCondition() {
 			continue;
 		}
 #endif
-		nIpCount += (m_OutputPort[nPortIndex].SourceA.nIp + m_OutputPort[nPortIndex].SourceB.nIp);
+		nIpCount += lightset::Data::GetSourceCount(nPortIndex);
 		if (nIpCount != 0) {
 			break;
 		}
@@ -419,8 +420,7 @@ void ArtNetNode::SetNetworkDataLossCondition() {
 	}
 
 	for (uint32_t i = 0; i < artnetnode::MAX_PORTS; i++) {
-		m_OutputPort[i].SourceA.nIp = 0;
-		m_OutputPort[i].SourceB.nIp = 0;
+		lightset::Data::ClearSources(i);
 		lightset::Data::ClearLength(i);
 	}
 
@@ -0,0 +1,102 @@
+/**
+ * @file artnetnodediag.cpp
+ *
+ */
+/**
+ * Art-Net Designed by and Copyright Artistic Licence Holdings Ltd.
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "artnetnode.h"
+#include "artnet.h"
+
+#include "network.h"
+
+#if defined (ARTNET_ENABLE_SENDDIAG)
+namespace artnetnode {
+namespace diag {
+static constexpr const char *FORMAT[] = {
+	"%u:%u First packet",
+	"%u:%u Continued transmission",
+	"%u:%u New source, start the merge",
+	"%u:%u Continue merge",
+	"%u:%u Lower priority source, ignored",
+	"%u:%u Source table full, discarding data",
+	"%u:%u Out of sequence, discarding data",
+	"%u: Buffering data",
+	"%u: Send data",
+	"%u: Leaving Merging Mode",
+	"Sync individual %u",
+	"Sync all",
+	"%u: Input DMX sent",
+	"%u: Input DMX sent (timeout)",
+	"%u: Input DMX local merge",
+	"%u: Input DMX updates per second is 0",
+	"%u: Input DMX timeout 1 second"
+};
+
+static_assert(sizeof(FORMAT) / sizeof(FORMAT[0]) == static_cast<uint32_t>(Event::UNDEFINED), "FORMAT and Event are out of sync");
+}  // namespace diag
+}  // namespace artnetnode
+#endif
+
+/**
+ * Called from Run when there is time to spare: formats the recorded events and sends them as ArtDiagData.
+ * Events are dropped when the controller is no longer interested.
+ */
+void ArtNetNode::SendDiagRun() {
+#if defined (ARTNET_ENABLE_SENDDIAG)
+	auto& ring = m_DiagRing;
+
+	if (!m_State.SendArtDiagData) {
+		ring.nTail = ring.nHead;
+		return;
+	}
+
+	for (uint32_t nSent = 0; (nSent < artnetnode::diag::SEND_MAX) && (ring.nTail != ring.nHead); ring.nTail++) {
+		const auto& entry = ring.Entry[ring.nTail & (artnetnode::diag::RING_SIZE - 1)];
+
+		if (entry.nPriority < m_State.DiagPriority) {
+			continue;
+		}
+
+		m_DiagData.Priority = entry.nPriority;
+
+		const auto i = snprintf(reinterpret_cast<char *>(m_DiagData.Data), sizeof(m_DiagData.Data) - 1,
+				artnetnode::diag::FORMAT[static_cast<uint32_t>(entry.event)],
+				static_cast<unsigned int>(entry.nArg0),
+				static_cast<unsigned int>(entry.nArg1));
+
+		m_DiagData.Data[sizeof(m_DiagData.Data) - 1] = '\0';	// Just be sure we have a last '\0'
+		m_DiagData.LengthLo = static_cast<uint8_t>(i + 1);		// Text length including the '\0'
+
+		const uint16_t nSize = sizeof(struct artnet::ArtDiagData) - sizeof(m_DiagData.Data) + m_DiagData.LengthLo;
+
+		Network::Get()->SendTo(m_nHandle, &m_DiagData, nSize, m_State.ArtDiagIpAddress, artnet::UDP_PORT);
+
+		nSent++;
+	}
+#endif
+}
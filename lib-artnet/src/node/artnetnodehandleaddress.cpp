@@ -27,6 +27,7 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <cassert>
 
@@ -66,13 +67,7 @@ void ArtNetNode::SetLocalMerging() {
 			if ((m_Node.Port[nInputPortIndex].protocol == m_Node.Port[nOutputPortIndex].protocol) &&
 				(m_Node.Port[nInputPortIndex].PortAddress == m_Node.Port[nOutputPortIndex].PortAddress)) {
 
-				if (!m_Node.Port[nOutputPortIndex].bLocalMerge) {
-					m_OutputPort[nOutputPortIndex].SourceA.nIp = Network::Get()->GetIp();
-					DEBUG_PUTS("Local merge Source A");
-				} else {
-					m_OutputPort[nOutputPortIndex].SourceB.nIp = Network::Get()->GetIp();
-					DEBUG_PUTS("Local merge Source B");
-				}
+				DEBUG_PRINTF("Local merge %u -> %u", nInputPortIndex, nOutputPortIndex);
 
 				m_Node.Port[nInputPortIndex].bLocalMerge = true;
 				m_Node.Port[nOutputPortIndex].bLocalMerge = true;
@@ -87,6 +82,38 @@ void ArtNetNode::SetLocalMerging() {
 	DEBUG_EXIT
 }
 
+void ArtNetNode::UpdatePortAddressMap() {
+	auto& map = m_PortAddressMap;
+
+	memset(map.Filter, 0, sizeof(map.Filter));
+	map.nEntries = 0;
+
+	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
+		if ((m_Node.Port[nPortIndex].direction != lightset::PortDir::OUTPUT) || (m_Node.Port[nPortIndex].protocol != artnet::PortProtocol::ARTNET)) {
+			continue;
+		}
+
+		const auto nPortAddress = m_Node.Port[nPortIndex].PortAddress;
+		const auto nBit = static_cast<uint32_t>(nPortAddress & 0xFF);
+		map.Filter[nBit >> 5] |= (1U << (nBit & 0x1F));
+
+		// Insertion sort, stable so that ports sharing a Port-Address keep the port order
+		auto i = map.nEntries;
+
+		while ((i > 0) && (map.PortAddress[i - 1] > nPortAddress)) {
+			map.PortAddress[i] = map.PortAddress[i - 1];
+			map.nPortIndex[i] = map.nPortIndex[i - 1];
+			i--;
+		}
+
+		map.PortAddress[i] = nPortAddress;
+		map.nPortIndex[i] = static_cast<uint8_t>(nPortIndex);
+		map.nEntries++;
+	}
+
+	DEBUG_PRINTF("nEntries=%u", map.nEntries);
+}
+
 void ArtNetNode::SetUniverse(const uint32_t nPortIndex, const lightset::PortDir dir, const uint16_t nUniverse) {
 	assert(nPortIndex < artnetnode::MAX_PORTS);
 
@@ -159,6 +186,8 @@ void ArtNetNode::SetUniverseSwitch(const uint32_t nPortIndex, const lightset::Po
 	SetUniverse4(nPortIndex, dir);
 #endif
 
+	UpdatePortAddressMap();
+
 	if (m_State.status == artnet::Status::ON) {
 		ArtNetStore::SaveUniverseSwitch(nPortIndex, nAddress);
 		artnet::display_universe_switch(nPortIndex, nAddress);
@@ -178,6 +207,8 @@ void ArtNetNode::SetSubnetSwitch(const uint32_t nPortIndex, const uint8_t nSubne
 	m_Node.Port[nPortIndex].SubSwitch = nSubnetSwitch;
 	m_Node.Port[nPortIndex].PortAddress = MakePortAddress(m_Node.Port[nPortIndex].PortAddress, nPortIndex);
 
+	UpdatePortAddressMap();
+
 	if (m_State.status == artnet::Status::ON) {
 		ArtNetStore::SaveSubnetSwitch(nPortIndex, nSubnetSwitch);
 	}
@@ -192,6 +223,8 @@ void ArtNetNode::SetNetSwitch(const uint32_t nPortIndex, const uint8_t nNetSwitc
 	m_Node.Port[nPortIndex].NetSwitch = nNetSwitch;
 	m_Node.Port[nPortIndex].PortAddress = MakePortAddress(m_Node.Port[nPortIndex].PortAddress, nPortIndex);
 
+	UpdatePortAddressMap();
+
 	if (m_State.status == artnet::Status::ON) {
 		ArtNetStore::SaveNetSwitch(nPortIndex, nNetSwitch);
 	}
@@ -336,8 +369,7 @@ void ArtNetNode::HandleAddress() {
 	case artnet::PortCommand::CANCEL:
 		m_State.IsMergeMode = false;
 		for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
-			m_OutputPort[nPortIndex].SourceA.nIp = 0;
-			m_OutputPort[nPortIndex].SourceB.nIp = 0;
+			lightset::Data::ClearSources(nPortIndex);
 			m_OutputPort[nPortIndex].GoodOutput &= static_cast<uint8_t>(~artnet::GoodOutput::OUTPUT_IS_MERGING);
 		}
 		break;
@@ -5,7 +5,7 @@
 /**
  * Art-Net Designed by and Copyright Artistic Licence Holdings Ltd.
  */
-/* Copyright (C) 2021-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2021-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -51,20 +51,11 @@ void ArtNetNode::UpdateMergeStatus(const uint32_t nPortIndex) {
 	m_OutputPort[nPortIndex].GoodOutput |= artnet::GoodOutput::OUTPUT_IS_MERGING;
 }
 
-void ArtNetNode::CheckMergeTimeouts(const uint32_t nPortIndex) {
-	const auto nTimeOutAMillis = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].SourceA.nMillis;
-
-	if (nTimeOutAMillis > (artnet::MERGE_TIMEOUT_SECONDS * 1000U)) {
-		m_OutputPort[nPortIndex].SourceA.nIp = 0;
-		m_OutputPort[nPortIndex].GoodOutput &= static_cast<uint8_t>(~artnet::GoodOutput::OUTPUT_IS_MERGING);
-	}
-
-	const auto nTimeOutBMillis = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].SourceB.nMillis;
-
-	if (nTimeOutBMillis > (artnet::MERGE_TIMEOUT_SECONDS * 1000U)) {
-		m_OutputPort[nPortIndex].SourceB.nIp = 0;
-		m_OutputPort[nPortIndex].GoodOutput &= static_cast<uint8_t>(~artnet::GoodOutput::OUTPUT_IS_MERGING);
-	}
+/**
+ * The per-source timeouts are done by the merge engine, see lightset::Data::Merge
+ */
+void ArtNetNode::ClearMergeStatus(const uint32_t nPortIndex) {
+	m_OutputPort[nPortIndex].GoodOutput &= static_cast<uint8_t>(~artnet::GoodOutput::OUTPUT_IS_MERGING);
 
 	auto bIsMerging = false;
 
@@ -75,153 +66,98 @@ void ArtNetNode::CheckMergeTimeouts(const uint32_t nPortIndex) {
 	if (!bIsMerging) {
 		m_State.IsChanged = true;
 		m_State.IsMergeMode = false;
-		SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Leaving Merging Mode", nPortIndex);
+		SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::LEAVING_MERGE, nPortIndex);
 	}
 }
 
+static_assert(static_cast<uint32_t>(lightset::source::Result::DISCARD) == static_cast<uint32_t>(artnetnode::diag::Event::DISCARD), "lightset::source::Result and diag::Event are out of sync");
+
 void ArtNetNode::HandleDmx() {
 	const auto *const pArtDmx = reinterpret_cast<artnet::ArtDmx *>(m_pReceiveBuffer);
+	const uint16_t nPortAddress = pArtDmx->PortAddress;
+	const auto& map = m_PortAddressMap;
+
+	if (map.IsFiltered(nPortAddress)) {
+		m_State.nDmxRejected++;
+		return;
+	}
+
+	const auto *pPortAddress = std::lower_bound(map.PortAddress, map.PortAddress + map.nEntries, nPortAddress);
 	const auto nDmxSlots = std::min(static_cast<uint32_t>(((pArtDmx->LengthHi << 8) & 0xff00) | pArtDmx->Length), artnet::DMX_LENGTH);
+	auto bIsAccepted = false;
 
-	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
-		if ((m_Node.Port[nPortIndex].direction == lightset::PortDir::OUTPUT)
-		 && (m_Node.Port[nPortIndex].protocol == artnet::PortProtocol::ARTNET)
-		 && (m_Node.Port[nPortIndex].PortAddress == pArtDmx->PortAddress)) {
-
-			m_OutputPort[nPortIndex].GoodOutput |= artnet::GoodOutput::DATA_IS_BEING_TRANSMITTED;
-
-			if (m_State.IsMergeMode) {
-				if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
-					CheckMergeTimeouts(nPortIndex);
-				}
-			}
-
-			const auto ipA = m_OutputPort[nPortIndex].SourceA.nIp;
-			const auto ipB = m_OutputPort[nPortIndex].SourceB.nIp;
-			const auto mergeMode = ((m_OutputPort[nPortIndex].GoodOutput & artnet::GoodOutput::MERGE_MODE_LTP) == artnet::GoodOutput::MERGE_MODE_LTP) ? lightset::MergeMode::LTP : lightset::MergeMode::HTP;
-
-			if (__builtin_expect((ipA == 0 && ipB == 0), 0)) {							// Case 1.
-				m_OutputPort[nPortIndex].SourceA.nIp = m_nIpAddressFrom;
-				m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-				m_OutputPort[nPortIndex].SourceA.nPhysical = pArtDmx->Physical;
-				lightset::Data::SetSourceA(nPortIndex, pArtDmx->Data, nDmxSlots);
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 1. First packet", nPortIndex, pArtDmx->Physical);
-			} else if (ipA == m_nIpAddressFrom && ipB == 0) {							// Case 2.
-				if (m_OutputPort[nPortIndex].SourceA.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-					lightset::Data::SetSourceA(nPortIndex, pArtDmx->Data, nDmxSlots);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 2. continued transmission from the same ip (source A)", nPortIndex, pArtDmx->Physical);
-				} else if (m_OutputPort[nPortIndex].SourceB.nPhysical != pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceB.nIp = m_nIpAddressFrom;
-					m_OutputPort[nPortIndex].SourceB.nMillis = m_nCurrentPacketMillis;
-					m_OutputPort[nPortIndex].SourceB.nPhysical = pArtDmx->Physical;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceB(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 2. New source from same ip (source B), start the merge", nPortIndex, pArtDmx->Physical);
-				} else {
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 2. More than two sources, discarding data", nPortIndex, pArtDmx->Physical);
-					return;
-				}
-			} else if (ipA == 0 && ipB == m_nIpAddressFrom) {							// Case 3.
-				if (m_OutputPort[nPortIndex].SourceB.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceB.nMillis = m_nCurrentPacketMillis;
-					lightset::Data::SetSourceB(nPortIndex, pArtDmx->Data, nDmxSlots);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 3. continued transmission from the same ip (source B)", nPortIndex, pArtDmx->Physical);
-				} else if (m_OutputPort[nPortIndex].SourceA.nPhysical != pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceA.nIp = m_nIpAddressFrom;
-					m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-					m_OutputPort[nPortIndex].SourceA.nPhysical = pArtDmx->Physical;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceA(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 3. New source from same ip (source A), start the merge", nPortIndex, pArtDmx->Physical);
-				} else {
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 3. More than two sources, discarding data", nPortIndex, pArtDmx->Physical);
-					return;
-				}
-			} else if (ipA != m_nIpAddressFrom && ipB == 0) {							// Case 4.
-				m_OutputPort[nPortIndex].SourceB.nIp = m_nIpAddressFrom;
-				m_OutputPort[nPortIndex].SourceB.nMillis = m_nCurrentPacketMillis;
-				m_OutputPort[nPortIndex].SourceB.nPhysical = pArtDmx->Physical;
-				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceB(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 4. new source, start the merge", nPortIndex, pArtDmx->Physical);
-			} else if (ipA == 0 && ipB != m_nIpAddressFrom) {							// Case 5.
-				m_OutputPort[nPortIndex].SourceA.nIp = m_nIpAddressFrom;
-				m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-				m_OutputPort[nPortIndex].SourceA.nPhysical = pArtDmx->Physical;
-				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceA(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 5. new source, start the merge", nPortIndex, pArtDmx->Physical);
-			} else if (ipA == m_nIpAddressFrom && ipB != m_nIpAddressFrom) {			// Case 6.
-				if (m_OutputPort[nPortIndex].SourceA.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceA(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 6. continue merge (Source A)", nPortIndex, pArtDmx->Physical);
-				} else {
-					SendDiag(artnet::PriorityCodes::DIAG_MED, "%u:%u 6. More than two sources, discarding data", nPortIndex, pArtDmx->Physical);
-					return;
-				}
-			} else if (ipA != m_nIpAddressFrom && ipB == m_nIpAddressFrom) {			// Case 7.
-				if (m_OutputPort[nPortIndex].SourceB.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceB.nMillis = m_nCurrentPacketMillis;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceB(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 7. continue merge (Source B)", nPortIndex, pArtDmx->Physical);
-				} else {
-					SendDiag(artnet::PriorityCodes::DIAG_MED, "%u:%u 7. More than two sources, discarding data", nPortIndex, pArtDmx->Physical);
-					puts("WARN: 7. More than two sources, discarding data");
-					return;
-				}
-			} else if (ipA == m_nIpAddressFrom && ipB == m_nIpAddressFrom) {			// Case 8.
-				if (m_OutputPort[nPortIndex].SourceA.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceA.nMillis = m_nCurrentPacketMillis;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceA(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 8. Source matches both ip, merging Physical (SourceA)", nPortIndex, pArtDmx->Physical);
-				} else if (m_OutputPort[nPortIndex].SourceB.nPhysical == pArtDmx->Physical) {
-					m_OutputPort[nPortIndex].SourceB.nMillis = m_nCurrentPacketMillis;
-					UpdateMergeStatus(nPortIndex);
-					lightset::Data::MergeSourceB(nPortIndex, pArtDmx->Data, nDmxSlots, mergeMode);
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 8. Source matches both ip, merging Physical (SourceB)", nPortIndex, pArtDmx->Physical);
-				} else {
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u:%u 8. Source matches both ip, more than two sources, discarding data", nPortIndex, pArtDmx->Physical);
-					puts("WARN: 8. Source matches both ip, discarding data");
-					return;
-				}
-			}
-#ifndef NDEBUG
-			else if (ipA != m_nIpAddressFrom && ipB != m_nIpAddressFrom) {				// Case 9.
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: 9. More than two sources, discarding data", nPortIndex);
-				puts("WARN: 9. More than two sources, discarding data");
-				return;
-			}
-#endif
-			else {																		// Case 0.
-				SendDiag(artnet::PriorityCodes::DIAG_HIGH, "%u: 0. No cases matched, this shouldn't happen!", nPortIndex);
-#ifndef NDEBUG
-				puts("ERROR: 0. No cases matched, this shouldn't happen!");
-#endif
-				return;
-			}
-
-			if ((m_State.IsSynchronousMode) && ((m_OutputPort[nPortIndex].GoodOutput & artnet::GoodOutput::OUTPUT_IS_MERGING) != artnet::GoodOutput::OUTPUT_IS_MERGING)) {
-				lightset::Data::Set(m_pLightSet, nPortIndex);
-				m_OutputPort[nPortIndex].IsDataPending = true;
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Buffering data", nPortIndex);
-			} else {
-				lightset::Data::Output(m_pLightSet, nPortIndex);
-
-				if (!m_OutputPort[nPortIndex].IsTransmitting) {
-					m_pLightSet->Start(nPortIndex);
-					m_State.IsChanged = true;
-					m_OutputPort[nPortIndex].IsTransmitting = true;
-				}
-
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Send data", nPortIndex);
-			}
-
-			m_State.nReceivingDmx |= (1U << static_cast<uint8_t>(lightset::PortDir::OUTPUT));
+	for (auto i = static_cast<uint32_t>(pPortAddress - map.PortAddress); (i < map.nEntries) && (map.PortAddress[i] == nPortAddress); i++) {
+		bIsAccepted |= HandleDmxPort(map.nPortIndex[i], pArtDmx, nDmxSlots);
+	}
+
+	if (bIsAccepted) {
+		m_State.nDmxAccepted++;
+	} else {
+		m_State.nDmxRejected++;
+	}
+}
+
+bool ArtNetNode::HandleDmxPort(const uint32_t nPortIndex, const artnet::ArtDmx *pArtDmx, const uint32_t nDmxSlots) {
+	using lightset::source::Result;
+
+	auto& outputPort = m_OutputPort[nPortIndex];
+	const auto nPhysical = pArtDmx->Physical;
+	const auto id = lightset::source::make_id(m_nIpAddressFrom, nPhysical);
+	const auto nTimeoutMillis = __builtin_expect((m_State.bDisableMergeTimeout), 0) ? 0 : artnet::MERGE_TIMEOUT_SECONDS * 1000U;
+
+	/*
+	 * A Sequence of 0 disables the sequence feature, the sequence wraps from 255 to 1.
+	 * A stale frame would command the outputs backwards, it is dropped before the merge.
+	 */
+	if ((pArtDmx->Sequence != 0) && !lightset::Data::CheckSequence(nPortIndex, id, pArtDmx->Sequence, m_nCurrentPacketMillis, nTimeoutMillis, lightset::source::sequence::Wrap::SKIP_ZERO)) {
+		SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::OUT_OF_SEQUENCE, nPortIndex, nPhysical);
+		return false;
+	}
+
+	outputPort.GoodOutput |= artnet::GoodOutput::DATA_IS_BEING_TRANSMITTED;
+
+	const auto mergeMode = ((outputPort.GoodOutput & artnet::GoodOutput::MERGE_MODE_LTP) == artnet::GoodOutput::MERGE_MODE_LTP) ? lightset::MergeMode::LTP : lightset::MergeMode::HTP;
+	const auto result = lightset::Data::Merge(nPortIndex, id, lightset::source::PRIORITY_DEFAULT, m_nCurrentPacketMillis, pArtDmx->Data, nDmxSlots, mergeMode, nTimeoutMillis);
+
+	SendDiag(result == Result::DISCARD ? artnet::PriorityCodes::DIAG_MED : artnet::PriorityCodes::DIAG_LOW, static_cast<artnetnode::diag::Event>(result), nPortIndex, nPhysical);
+
+	switch (result) {
+	case Result::FIRST:
+	case Result::SET:
+		if ((outputPort.GoodOutput & artnet::GoodOutput::OUTPUT_IS_MERGING) == artnet::GoodOutput::OUTPUT_IS_MERGING) {
+			ClearMergeStatus(nPortIndex);
 		}
+		break;
+	case Result::NEW:
+	case Result::MERGE:
+		UpdateMergeStatus(nPortIndex);
+		break;
+	case Result::IGNORED:
+	case Result::DISCARD:
+		return false;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
 	}
+
+	if ((m_State.IsSynchronousMode) && ((outputPort.GoodOutput & artnet::GoodOutput::OUTPUT_IS_MERGING) != artnet::GoodOutput::OUTPUT_IS_MERGING)) {
+		lightset::Data::Set(m_pLightSet, nPortIndex);
+		outputPort.IsDataPending = true;
+		SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::BUFFERING_DATA, nPortIndex);
+	} else {
+		lightset::Data::Output(m_pLightSet, nPortIndex);
+
+		if (!outputPort.IsTransmitting) {
+			m_pLightSet->Start(nPortIndex);
+			m_State.IsChanged = true;
+			outputPort.IsTransmitting = true;
+		}
+
+		SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::SEND_DATA, nPortIndex);
+	}
+
+	m_State.nReceivingDmx |= (1U << static_cast<uint8_t>(lightset::PortDir::OUTPUT));
+
+	return true;
 }
@@ -47,13 +47,13 @@ void ArtNetNode::HandleSync() {
 	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
 		if (m_OutputPort[nPortIndex].IsDataPending) {
 			m_pLightSet->Sync(nPortIndex);
-			SendDiag(artnet::PriorityCodes::DIAG_LOW, "Sync individual %u", nPortIndex);
+			SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::SYNC_PORT, nPortIndex);
 		}
 	}
 
 	m_pLightSet->Sync();
 
-	SendDiag(artnet::PriorityCodes::DIAG_LOW, "Sync all");
+	SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::SYNC_ALL);
 
 	for (auto &outputPort : m_OutputPort) {
 		if (outputPort.IsDataPending) {
@@ -5,7 +5,7 @@
 /**
  * Art-Net Designed by and Copyright Artistic Licence Holdings Ltd.
  */
-/* Copyright (C) 2016-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2016-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -54,6 +54,7 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertiesschema.h"
 
 #include "propertiesbuilder.h"
 
@@ -73,8 +74,258 @@ static constexpr bool is_set(const uint16_t nValue, const uint32_t i) {
 	return (nValue & static_cast<uint16_t>(1U << (i + 8))) == static_cast<uint16_t>(1U << (i + 8));
 }
 #endif
+
+static constexpr uint16_t portdir_set(const uint32_t nPortIndex, const lightset::PortDir portDir) {
+	return static_cast<uint16_t>((static_cast<uint32_t>(portDir) & 0x3) << (nPortIndex * 2));
+}
 }  // namespace artnetparams
 
+namespace {
+using namespace artnetparams;
+using namespace properties::schema;
+
+void set_mask(Params *pParams, const uint32_t nMask, const bool bSet) {
+	if (bSet) {
+		pParams->nSetList |= nMask;
+	} else {
+		pParams->nSetList &= ~nMask;
+	}
+}
+
+void set_bool(void *p, const char *pValue, const uint32_t nMask) {
+	uint8_t nValue8;
+
+	if (Sscan::Uint8(pValue, nValue8) == Sscan::OK) {
+		set_mask(static_cast<Params *>(p), nMask, nValue8 != 0);
+	}
+}
+
+/*
+ * Node
+ */
+
+void universe(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint16_t nValue16;
+
+	if ((Sscan::Uint16(pValue, nValue16) == Sscan::OK) && (nValue16 != 0)) {
+		pParams->nUniverse[nPortIndex] = nValue16;
+		set_mask(pParams, Mask::UNIVERSE_A << nPortIndex, nValue16 != static_cast<uint16_t>(nPortIndex + 1));
+	}
+}
+
+void direction(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[8];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) != Sscan::OK) {
+		return;
+	}
+
+	aValue[nLength] = '\0';
+	const auto portDir = lightset::get_direction(aValue);
+
+	pParams->nDirection &= portdir_clear(nPortIndex);
+
+#if defined (ARTNET_HAVE_DMXIN)
+	if (portDir == lightset::PortDir::INPUT) {
+		pParams->nDirection |= portdir_set(nPortIndex, lightset::PortDir::INPUT);
+	} else
+#endif
+	if (portDir == lightset::PortDir::DISABLE) {
+		pParams->nDirection |= portdir_set(nPortIndex, lightset::PortDir::DISABLE);
+	} else {
+		pParams->nDirection |= portdir_set(nPortIndex, lightset::PortDir::OUTPUT);
+	}
+}
+
+void merge_mode(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[4];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		pParams->nMergeMode &= mergemode_clear(nPortIndex);
+		pParams->nMergeMode |= mergemode_set(nPortIndex, lightset::get_merge_mode(aValue));
+	}
+}
+
+void label(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	auto *pLabel = reinterpret_cast<char *>(pParams->aLabel[nPortIndex]);
+	uint32_t nLength = artnet::SHORT_NAME_LENGTH - 1;
+
+	if (Sscan::Char(pValue, pLabel, nLength) == Sscan::OK) {
+		pLabel[nLength] = '\0';
+		char aDefault[artnet::SHORT_NAME_LENGTH];
+		lightset::node::get_short_name_default(nPortIndex, aDefault);
+		set_mask(pParams, Mask::LABEL_A << nPortIndex, strcmp(pLabel, aDefault) != 0);
+	}
+}
+
+#if defined (OUTPUT_HAVE_STYLESWITCH)
+void output_style(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[7];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		if (lightset::get_output_style(aValue) != lightset::OutputStyle::DELTA) {
+			pParams->nOutputStyle |= static_cast<uint8_t>(1U << nPortIndex);
+		} else {
+			pParams->nOutputStyle &= static_cast<uint8_t>(~(1U << nPortIndex));
+		}
+	}
+}
+#endif
+
+void failsafe(void *p, const char *pValue, [[maybe_unused]] const uint32_t nIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[9];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		const auto failsafe = lightset::get_failsafe(aValue);
+		set_mask(pParams, Mask::FAILSAFE, failsafe != lightset::FailSafe::HOLD);
+		pParams->nFailSafe = static_cast<uint8_t>(failsafe);
+	}
+}
+
+void long_name(void *p, const char *pValue, [[maybe_unused]] const uint32_t nIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	auto *pLongName = reinterpret_cast<char *>(pParams->aLongName);
+	uint32_t nLength = artnet::LONG_NAME_LENGTH - 1;
+
+	if (Sscan::Char(pValue, pLongName, nLength) == Sscan::OK) {
+		pLongName[nLength] = '\0';
+		char aDefault[artnet::LONG_NAME_LENGTH];
+		ArtNetNode::Get()->GetLongNameDefault(aDefault);
+		set_mask(pParams, Mask::LONG_NAME, strcmp(pLongName, aDefault) != 0);
+	}
+}
+
+/*
+ * Art-Net
+ */
+
+void protocol(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[5];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		pParams->nProtocol &= protocol_clear(nPortIndex);
+		pParams->nProtocol |= protocol_set(nPortIndex, artnet::get_protocol_mode(aValue));
+	}
+}
+
+#if defined (ARTNET_HAVE_DMXIN)
+void destination_ip(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint32_t nValue32;
+
+	if (Sscan::IpAddress(pValue, nValue32) == Sscan::OK) {
+		pParams->nDestinationIp[nPortIndex] = nValue32;
+		set_mask(pParams, Mask::DESTINATION_IP_A << nPortIndex, nValue32 != 0);
+	}
+}
+#endif
+
+#if defined (E131_HAVE_DMXIN)
+void priority(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint8_t nValue8;
+
+	if (Sscan::Uint8(pValue, nValue8) == Sscan::OK) {
+		if ((nValue8 >= e131::priority::LOWEST) && (nValue8 <= e131::priority::HIGHEST) && (nValue8 != e131::priority::DEFAULT)) {
+			pParams->nPriority[nPortIndex] = nValue8;
+			pParams->nSetList |= (Mask::PRIORITY_A << nPortIndex);
+		} else {
+			pParams->nPriority[nPortIndex] = e131::priority::DEFAULT;
+			pParams->nSetList &= ~(Mask::PRIORITY_A << nPortIndex);
+		}
+	}
+}
+#endif
+
+#if defined (RDM_CONTROLLER)
+void rdm_enable(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint8_t nValue8;
+
+	if (Sscan::Uint8(pValue, nValue8) == Sscan::OK) {
+		pParams->nRdm &= clear_mask(nPortIndex);
+
+		if (nValue8 != 0) {
+			pParams->nRdm |= shift_left(1, nPortIndex);
+			pParams->nRdm |= static_cast<uint16_t>(1U << (nPortIndex + 8));
+		}
+	}
+}
+#endif
+
+constexpr Key s_Keys[] = {
+	Custom(LightSetParamsConst::UNIVERSE_PORT[0], universe, 0),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[1], universe, 1),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[2], universe, 2),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[3], universe, 3),
+	Custom(LightSetParamsConst::DIRECTION[0], direction, 0),
+	Custom(LightSetParamsConst::DIRECTION[1], direction, 1),
+	Custom(LightSetParamsConst::DIRECTION[2], direction, 2),
+	Custom(LightSetParamsConst::DIRECTION[3], direction, 3),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[0], merge_mode, 0),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[1], merge_mode, 1),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[2], merge_mode, 2),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[3], merge_mode, 3),
+	Custom(LightSetParamsConst::NODE_LABEL[0], label, 0),
+	Custom(LightSetParamsConst::NODE_LABEL[1], label, 1),
+	Custom(LightSetParamsConst::NODE_LABEL[2], label, 2),
+	Custom(LightSetParamsConst::NODE_LABEL[3], label, 3),
+#if defined (OUTPUT_HAVE_STYLESWITCH)
+	Custom(LightSetParamsConst::OUTPUT_STYLE[0], output_style, 0),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[1], output_style, 1),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[2], output_style, 2),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[3], output_style, 3),
+#endif
+	Custom(LightSetParamsConst::FAILSAFE, failsafe),
+	Custom(LightSetParamsConst::NODE_LONG_NAME, long_name),
+	Custom(ArtNetParamsConst::PROTOCOL_PORT[0], protocol, 0),
+	Custom(ArtNetParamsConst::PROTOCOL_PORT[1], protocol, 1),
+	Custom(ArtNetParamsConst::PROTOCOL_PORT[2], protocol, 2),
+	Custom(ArtNetParamsConst::PROTOCOL_PORT[3], protocol, 3),
+#if defined (ARTNET_HAVE_DMXIN)
+	Custom(ArtNetParamsConst::DESTINATION_IP_PORT[0], destination_ip, 0),
+	Custom(ArtNetParamsConst::DESTINATION_IP_PORT[1], destination_ip, 1),
+	Custom(ArtNetParamsConst::DESTINATION_IP_PORT[2], destination_ip, 2),
+	Custom(ArtNetParamsConst::DESTINATION_IP_PORT[3], destination_ip, 3),
+#endif
+#if defined (E131_HAVE_DMXIN)
+	Custom(LightSetParamsConst::PRIORITY[0], priority, 0),
+	Custom(LightSetParamsConst::PRIORITY[1], priority, 1),
+	Custom(LightSetParamsConst::PRIORITY[2], priority, 2),
+	Custom(LightSetParamsConst::PRIORITY[3], priority, 3),
+#endif
+#if defined (RDM_CONTROLLER)
+	Custom(ArtNetParamsConst::ENABLE_RDM, set_bool, Mask::ENABLE_RDM),
+	Custom(ArtNetParamsConst::RDM_ENABLE_PORT[0], rdm_enable, 0),
+	Custom(ArtNetParamsConst::RDM_ENABLE_PORT[1], rdm_enable, 1),
+	Custom(ArtNetParamsConst::RDM_ENABLE_PORT[2], rdm_enable, 2),
+	Custom(ArtNetParamsConst::RDM_ENABLE_PORT[3], rdm_enable, 3),
+#endif
+	Custom(ArtNetParamsConst::MAP_UNIVERSE0, set_bool, Mask::MAP_UNIVERSE0),
+	Custom(LightSetParamsConst::DISABLE_MERGE_TIMEOUT, set_bool, Mask::DISABLE_MERGE_TIMEOUT),
+};
+
+static_assert(artnet::PORTS == 4, "s_Keys has 4 entries per port key");
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 using namespace artnetparams;
 
 ArtNetParams::ArtNetParams() {
@@ -140,205 +391,10 @@ void ArtNetParams::Load(const char *pBuffer, uint32_t nLength) {
 	DEBUG_EXIT
 }
 
-void ArtNetParams::SetBool(const uint8_t nValue, const uint32_t nMask) {
-	if (nValue != 0) {
-		m_Params.nSetList |= nMask;
-	} else {
-		m_Params.nSetList &= ~nMask;
-	}
-}
-
 void ArtNetParams::callbackFunction(const char *pLine) {
 	assert(pLine != nullptr);
 
-	char aValue[artnet::LONG_NAME_LENGTH];
-	uint8_t nValue8;
-
-#if defined (RDM_CONTROLLER)
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::ENABLE_RDM, nValue8) == Sscan::OK) {
-		SetBool(nValue8, Mask::ENABLE_RDM);
-		return;
-	}
-#endif
-
-	/*
-	 * Node
-	 */
-
-	for (uint32_t nPortIndex = 0; nPortIndex < artnet::PORTS; nPortIndex++) {
-		uint16_t nValue16;
-
-		if (Sscan::Uint16(pLine, LightSetParamsConst::UNIVERSE_PORT[nPortIndex], nValue16) == Sscan::OK) {
-			if (nValue16 != 0) {
-				m_Params.nUniverse[nPortIndex] = nValue16;
-				if (nValue16 != static_cast<uint16_t>(nPortIndex + 1)) {
-					m_Params.nSetList |= (Mask::UNIVERSE_A << nPortIndex);
-				} else {
-					m_Params.nSetList &= ~(Mask::UNIVERSE_A << nPortIndex);
-				}
-			}
-			return;
-		}
-
-		uint32_t nLength = 7;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::DIRECTION[nPortIndex], aValue, nLength) == Sscan::OK) {
-			const auto portDir = lightset::get_direction(aValue);
-
-			m_Params.nDirection &= artnetparams::portdir_clear(nPortIndex);
-
-#if defined (ARTNET_HAVE_DMXIN)
-			if (portDir == lightset::PortDir::INPUT) {
-				m_Params.nDirection |= portdir_set(nPortIndex, lightset::PortDir::INPUT);
-			} else
-#endif
-			if (portDir == lightset::PortDir::DISABLE) {
-				m_Params.nDirection |= portdir_set(nPortIndex, lightset::PortDir::DISABLE);
-			} else {
-				m_Params.nDirection |= portdir_set(nPortIndex, lightset::PortDir::OUTPUT);
-			}
-
-			return;
-		}
-
-		nLength = 3;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::MERGE_MODE_PORT[nPortIndex], aValue, nLength) == Sscan::OK) {
-			m_Params.nMergeMode &= artnetparams::mergemode_clear(nPortIndex);
-			m_Params.nMergeMode |= mergemode_set(nPortIndex, lightset::get_merge_mode(aValue));
-			return;
-		}
-
-		nLength = artnet::SHORT_NAME_LENGTH - 1;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::NODE_LABEL[nPortIndex], reinterpret_cast<char*>(m_Params.aLabel[nPortIndex]), nLength) == Sscan::OK) {
-			m_Params.aLabel[nPortIndex][nLength] = '\0';
-			static_assert(sizeof(aValue) >= artnet::SHORT_NAME_LENGTH, "");
-			lightset::node::get_short_name_default(nPortIndex, aValue);
-
-			if (strcmp(reinterpret_cast<char*>(m_Params.aLabel[nPortIndex]), aValue) == 0) {
-				m_Params.nSetList &= ~(Mask::LABEL_A << nPortIndex);
-			} else {
-				m_Params.nSetList |= (Mask::LABEL_A << nPortIndex);
-			}
-			return;
-		}
-
-#if defined (OUTPUT_HAVE_STYLESWITCH)
-		nLength = 6;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::OUTPUT_STYLE[nPortIndex], aValue, nLength) == Sscan::OK) {
-			const auto nOutputStyle = lightset::get_output_style(aValue);
-
-			if (nOutputStyle != lightset::OutputStyle::DELTA) {
-				m_Params.nOutputStyle |= static_cast<uint8_t>(1U << nPortIndex);
-			} else {
-				m_Params.nOutputStyle &= static_cast<uint8_t>(~(1U << nPortIndex));
-			}
-
-			return;
-		}
-#endif
-	}
-
-	uint32_t nLength = 8;
-
-	if (Sscan::Char(pLine, LightSetParamsConst::FAILSAFE, aValue, nLength) == Sscan::OK) {
-		const auto failsafe = lightset::get_failsafe(aValue);
-
-		if (failsafe == lightset::FailSafe::HOLD) {
-			m_Params.nSetList &= ~Mask::FAILSAFE;
-		} else {
-			m_Params.nSetList |= Mask::FAILSAFE;
-		}
-
-		m_Params.nFailSafe = static_cast<uint8_t>(failsafe);
-		return;
-	}
-
-	nLength = artnet::LONG_NAME_LENGTH - 1;
-
-	if (Sscan::Char(pLine, LightSetParamsConst::NODE_LONG_NAME, reinterpret_cast<char*>(m_Params.aLongName), nLength) == Sscan::OK) {
-		m_Params.aLongName[nLength] = '\0';
-		static_assert(sizeof(aValue) >= artnet::LONG_NAME_LENGTH, "");
-		ArtNetNode::Get()->GetLongNameDefault(aValue);
-		if (strcmp(reinterpret_cast<char*>(m_Params.aLongName), aValue) == 0) {
-			m_Params.nSetList &= ~Mask::LONG_NAME;
-		} else {
-			m_Params.nSetList |= Mask::LONG_NAME;
-		}
-		return;
-	}
-
-	/*
-	 * Art-Net
-	 */
-
-	for (uint32_t nPortIndex = 0; nPortIndex < artnet::PORTS; nPortIndex++) {
-		uint32_t nLength = 4;
-
-		if (Sscan::Char(pLine, ArtNetParamsConst::PROTOCOL_PORT[nPortIndex], aValue, nLength) == Sscan::OK) {
-			m_Params.nProtocol &= artnetparams::protocol_clear(nPortIndex);
-			m_Params.nProtocol |= protocol_set(nPortIndex, artnet::get_protocol_mode(aValue));
-			return;
-		}
-
-#if defined (ARTNET_HAVE_DMXIN)
-		uint32_t nValue32;
-
-		if (Sscan::IpAddress(pLine, ArtNetParamsConst::DESTINATION_IP_PORT[nPortIndex], nValue32) == Sscan::OK) {
-			m_Params.nDestinationIp[nPortIndex] = nValue32;
-
-			if (nValue32 != 0) {
-				m_Params.nSetList |= (Mask::DESTINATION_IP_A << nPortIndex);
-			} else {
-				m_Params.nSetList &= ~(Mask::DESTINATION_IP_A << nPortIndex);
-			}
-			return;
-		}
-#endif
-
-#if defined (E131_HAVE_DMXIN)
-		uint8_t value8;
-
-		if (Sscan::Uint8(pLine, LightSetParamsConst::PRIORITY[nPortIndex], value8) == Sscan::OK) {
-			if ((value8 >= e131::priority::LOWEST) && (value8 <= e131::priority::HIGHEST) && (value8 != e131::priority::DEFAULT)) {
-				m_Params.nPriority[nPortIndex] = value8;
-				m_Params.nSetList |= (Mask::PRIORITY_A << nPortIndex);
-			} else {
-				m_Params.nPriority[nPortIndex] = e131::priority::DEFAULT;
-				m_Params.nSetList &= ~(Mask::PRIORITY_A << nPortIndex);
-			}
-			return;
-		}
-#endif
-
-#if defined (RDM_CONTROLLER)
-		if (Sscan::Uint8(pLine, ArtNetParamsConst::RDM_ENABLE_PORT[nPortIndex], nValue8) == Sscan::OK) {
-			m_Params.nRdm &= artnetparams::clear_mask(nPortIndex);
-
-			if (nValue8 != 0) {
-				m_Params.nRdm |= artnetparams::shift_left(1, nPortIndex);
-				m_Params.nRdm |= static_cast<uint16_t>(1U << (nPortIndex + 8));
-			}
-			return;
-		}
-#endif
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::MAP_UNIVERSE0, nValue8) == Sscan::OK) {
-		SetBool(nValue8, Mask::MAP_UNIVERSE0);
-		return;
-	}
-
-	/**
-	 * Extra's
-	 */
-
-	if (Sscan::Uint8(pLine, LightSetParamsConst::DISABLE_MERGE_TIMEOUT, nValue8) == Sscan::OK) {
-		SetBool(nValue8, Mask::DISABLE_MERGE_TIMEOUT);
-		return;
-	}
+	s_Schema.Parse(pLine, &m_Params);
 }
 
 void ArtNetParams::Builder(const struct Params *pParams, char *pBuffer, uint32_t nLength, uint32_t& nSize) {
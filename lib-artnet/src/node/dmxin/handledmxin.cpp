@@ -79,14 +79,14 @@ void ArtNetNode::HandleDmxIn() {
 
 				Network::Get()->SendTo(m_nHandle, &m_ArtDmx, sizeof(struct artnet::ArtDmx), m_InputPort[nPortIndex].nDestinationIp, artnet::UDP_PORT);
 
-				SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX sent", nPortIndex);
+				SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_SENT, nPortIndex);
 
 				if (m_Node.Port[nPortIndex].bLocalMerge) {
 					m_pReceiveBuffer = reinterpret_cast<uint8_t *>(&m_ArtDmx);
 					m_nIpAddressFrom = Network::Get()->GetIp();
 					HandleDmx();
 
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX local merge", nPortIndex);
+					SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_LOCAL_MERGE, nPortIndex);
 				}
 
 				if ((s_ReceivingMask & (1U << nPortIndex)) != (1U << nPortIndex)) {
@@ -113,14 +113,14 @@ void ArtNetNode::HandleDmxIn() {
 						m_State.nReceivingDmx &= static_cast<uint8_t>(~(1U << static_cast<uint8_t>(lightset::PortDir::INPUT)));
 					}
 
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX updates per second is 0", nPortIndex);
+					SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_NO_UPDATES, nPortIndex);
 				} else if (m_InputPort[nPortIndex].nMillis != 0) {
 					const auto nMillis = Hardware::Get()->Millis();
 					if ((nMillis - m_InputPort[nPortIndex].nMillis) > 1000) {
 						m_InputPort[nPortIndex].nMillis = nMillis;
 						sendArtDmx = true;
 
-						SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX timeout 1 second", nPortIndex);
+						SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_TIMEOUT, nPortIndex);
 					}
 				}
 
@@ -145,14 +145,14 @@ void ArtNetNode::HandleDmxIn() {
 
 					Network::Get()->SendTo(m_nHandle, &m_ArtDmx, sizeof(struct artnet::ArtDmx), m_InputPort[nPortIndex].nDestinationIp, artnet::UDP_PORT);
 
-					SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX sent (timeout)", nPortIndex);
+					SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_SENT_TIMEOUT, nPortIndex);
 
 					if (m_Node.Port[nPortIndex].bLocalMerge) {
 						m_pReceiveBuffer = reinterpret_cast<uint8_t *>(&m_ArtDmx);
 						m_nIpAddressFrom = Network::Get()->GetIp();
 						HandleDmx();
 
-						SendDiag(artnet::PriorityCodes::DIAG_LOW, "%u: Input DMX local merge", nPortIndex);
+						SendDiag(artnet::PriorityCodes::DIAG_LOW, artnetnode::diag::Event::INPUT_LOCAL_MERGE, nPortIndex);
 					}
 				}
 			}
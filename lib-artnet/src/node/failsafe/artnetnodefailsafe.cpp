@@ -2,7 +2,7 @@
  * @file artnetnodefailsafe.cpp
  *
  */
-/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2022-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -55,7 +55,7 @@ void ArtNetNode::FailSafePlayback() {
 
 	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
 		if (m_Node.Port[nPortIndex].direction == lightset::PortDir::OUTPUT) {
-			artnetnode::failsafe_read(nPortIndex, const_cast<uint8_t *>(lightset::Data::Backup(nPortIndex)));
+			artnetnode::failsafe_read(nPortIndex, lightset::Data::GetRestoreBuffer(nPortIndex));
 			lightset::Data::Output(m_pLightSet, nPortIndex);
 
 			if (!m_OutputPort[nPortIndex].IsTransmitting) {
@@ -2,7 +2,7 @@
  * @file storedevice.cpp
  *
  */
-/* Copyright (C) 2022-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2022-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,52 +25,190 @@
 
 #include <cstdint>
 #include <cstdio>
-#include <cassert>
+#include <cstring>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "configstoredevice.h"
 
 #include "debug.h"
 
+/*
+ * The emulated SPI flash is the file spiflash.bin, memory mapped.
+ *
+ * With CONFIG_STORE_LOG the records carry a CRC and a block becomes valid only after its header is
+ * written, so the mapping is shared and each Erase/Write is committed with msync of the touched pages.
+ *
+ * Without, ConfigStore erases and then rewrites the whole image, and a crash in between would lose it.
+ * The mapping is then private, and a completed Write is committed as a snapshot: written to
+ * spiflash.bin.tmp and renamed over spiflash.bin, so the file is always either the old or the new image.
+ */
+
 namespace storedevice {
 static constexpr auto FLASH_SECTOR_SIZE = 4096U;
 static constexpr auto FLASH_SIZE = (512 * FLASH_SECTOR_SIZE);
 static constexpr char FLASH_FILE_NAME[] = "spiflash.bin";
-static constexpr auto BLOCK_WRITE_LENGTH = 1024;
+static constexpr char FLASH_FILE_NAME_TMP[] = "spiflash.bin.tmp";
 
-static FILE *pFile;
+#if defined (CONFIG_STORE_LOG)
+static constexpr auto MAP_FLAGS = MAP_SHARED;
+#else
+static constexpr auto MAP_FLAGS = MAP_PRIVATE;
+#endif
 
-enum class State {
-	IDLE, RUNNING, ERROR
-};
+static int s_nFd = -1;
+static uint8_t *s_pFlash;
 
-static State s_State = State::IDLE;
-static uint32_t s_nIndex = 0;
-}  // namespace storedevice
+/**
+ * The whole image is written to the temporary file, which then atomically replaces spiflash.bin
+ */
+static bool snapshot(const uint8_t *pImage) {
+	const auto nFd = open(FLASH_FILE_NAME_TMP, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
 
-using namespace storedevice;
+	if (nFd < 0) {
+		perror("open(FLASH_FILE_NAME_TMP)");
+		return false;
+	}
 
-StoreDevice::StoreDevice() {
-	DEBUG_ENTRY
+	if (pImage == nullptr) {
+		const auto nError = posix_fallocate(nFd, 0, FLASH_SIZE);
 
-	if ((pFile = fopen(FLASH_FILE_NAME, "r+")) == nullptr) {
-		perror("fopen r+");
+		if (nError != 0) {
+			fprintf(stderr, "posix_fallocate: %s\n", strerror(nError));
+			close(nFd);
+			return false;
+		}
 
-		pFile = fopen(FLASH_FILE_NAME, "w+");
+		auto *p = static_cast<uint8_t *>(mmap(nullptr, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, nFd, 0));
 
-		for (uint32_t i = 0; i < FLASH_SIZE; i++) {
-			if (fputc(0xFF, pFile) == EOF) {
-				perror("fputc(0xFF, file)");
-				DEBUG_EXIT
-				return;
-			}
+		if (p == MAP_FAILED) {
+			perror("mmap");
+			close(nFd);
+			return false;
 		}
 
-		if (fflush(pFile) != 0) {
-			perror("fflush");
+		memset(p, 0xFF, FLASH_SIZE);
+		munmap(p, FLASH_SIZE);
+	} else {
+		uint32_t nIndex = 0;
+
+		while (nIndex < FLASH_SIZE) {
+			const auto nBytes = write(nFd, &pImage[nIndex], FLASH_SIZE - nIndex);
+
+			if (nBytes <= 0) {
+				perror("write");
+				close(nFd);
+				return false;
+			}
+
+			nIndex += static_cast<uint32_t>(nBytes);
 		}
 	}
 
+	if (fsync(nFd) != 0) {
+		perror("fsync");
+	}
+
+	close(nFd);
+
+	if (rename(FLASH_FILE_NAME_TMP, FLASH_FILE_NAME) != 0) {
+		perror("rename");
+		return false;
+	}
+
+	return true;
+}
+
+static void unmap() {
+	if (s_pFlash != nullptr) {
+		munmap(s_pFlash, FLASH_SIZE);
+		s_pFlash = nullptr;
+	}
+
+	if (s_nFd >= 0) {
+		close(s_nFd);
+		s_nFd = -1;
+	}
+}
+
+/**
+ * The current mapping is only replaced when spiflash.bin could be mapped
+ */
+static bool map() {
+	const auto nFd = open(FLASH_FILE_NAME, O_RDWR | O_CLOEXEC);
+
+	if (nFd < 0) {
+		perror("open(FLASH_FILE_NAME)");
+		return false;
+	}
+
+	struct stat sb;
+
+	if ((fstat(nFd, &sb) != 0) || (static_cast<uint32_t>(sb.st_size) != FLASH_SIZE)) {
+		fprintf(stderr, "%s: invalid size\n", FLASH_FILE_NAME);
+		close(nFd);
+		return false;
+	}
+
+	auto *p = mmap(nullptr, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_FLAGS, nFd, 0);
+
+	if (p == MAP_FAILED) {
+		perror("mmap");
+		close(nFd);
+		return false;
+	}
+
+	unmap();
+
+	s_nFd = nFd;
+	s_pFlash = static_cast<uint8_t *>(p);
+	return true;
+}
+
+static bool commit([[maybe_unused]] const uint32_t nOffset, [[maybe_unused]] const uint32_t nLength, [[maybe_unused]] const bool isWrite) {
+#if defined (CONFIG_STORE_LOG)
+	static const auto nPageSize = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+	const auto nBegin = nOffset & ~(nPageSize - 1);
+
+	if (msync(&s_pFlash[nBegin], nOffset + nLength - nBegin, MS_SYNC) != 0) {
+		perror("msync");
+		return false;
+	}
+
+	return true;
+#else
+	// The erase is committed together with the write that follows it
+	if (!isWrite) {
+		return true;
+	}
+
+	if (!snapshot(s_pFlash)) {
+		return false;
+	}
+
+	// Map the new file first, when that fails the current mapping already holds the new image
+	return map();
+#endif
+}
+}  // namespace storedevice
+
+using namespace storedevice;
+
+StoreDevice::StoreDevice() {
+	DEBUG_ENTRY
+
+	if ((access(FLASH_FILE_NAME, F_OK) != 0) && !snapshot(nullptr)) {
+		DEBUG_EXIT
+		return;
+	}
+
+	if (!map()) {
+		DEBUG_EXIT
+		return;
+	}
+
 	m_IsDetected = true;
 
 	DEBUG_EXIT
@@ -79,10 +217,7 @@ StoreDevice::StoreDevice() {
 StoreDevice::~StoreDevice() {
 	DEBUG_ENTRY
 
-	if (pFile != nullptr) {
-		fclose(pFile);
-		pFile = nullptr;
-	}
+	unmap();
 
 	DEBUG_EXIT
 }
@@ -96,141 +231,56 @@ uint32_t StoreDevice::GetSectorSize() const {
 }
 
 bool StoreDevice::Read(uint32_t nOffset, uint32_t nLength, uint8_t *pBuffer, result& nResult) {
-	assert(pFile != nullptr);
-	DEBUG_ENTRY
 	DEBUG_PRINTF("nOffset=%u, nLength=%u", nOffset, nLength);
-
-	if (fseek(pFile, static_cast<long int>(nOffset), SEEK_SET) != 0) {
+	if (__builtin_expect((s_pFlash == nullptr), 0)) {
 		nResult = result::ERROR;
-		perror("fseek");
-		DEBUG_EXIT
 		return true;
 	}
 
-	if (fread(pBuffer, 1, nLength, pFile) != nLength) {
+	if ((nOffset + nLength) > FLASH_SIZE) {
 		nResult = result::ERROR;
-		perror("fread");
-		DEBUG_EXIT
 		return true;
 	}
 
-	DEBUG_EXIT
+	memcpy(pBuffer, &s_pFlash[nOffset], nLength);
+
 	nResult = result::OK;
 	return true;
 }
 
 bool StoreDevice::Erase(uint32_t nOffset, uint32_t nLength, storedevice::result& nResult) {
-	DEBUG_ENTRY
-	DEBUG_PRINTF("nOffset=%u, nLength=%u, s_State=%d", nOffset, nLength, static_cast<int>(s_State));
-	assert(s_State != State::ERROR);
-	assert(pFile != nullptr);
-
-	if (s_State == State::IDLE) {
-		if (nOffset % FLASH_SECTOR_SIZE || nLength % FLASH_SECTOR_SIZE) {
-			s_State = State::ERROR;
-			nResult = result::ERROR;
-			DEBUG_PUTS("Erase offset/length not multiple of erase size");
-			DEBUG_EXIT
-			return true;
-		}
-
-		if (fseek(pFile, static_cast<long int>(nOffset), SEEK_SET) != 0) {
-			s_State = State::ERROR;
-			nResult = result::ERROR;
-			perror("fseek");
-			DEBUG_EXIT
-			return true;
-		}
-
-		s_nIndex = 0;
-		s_State = State::RUNNING;
-		nResult = result::OK;
-		DEBUG_EXIT
-		return false;
+	DEBUG_PRINTF("nOffset=%u, nLength=%u", nOffset, nLength);
+	if (__builtin_expect((s_pFlash == nullptr), 0)) {
+		nResult = result::ERROR;
+		return true;
 	}
 
-	if (s_State == State::RUNNING) {
-		for (uint32_t i = 0; i < nLength; i++) {
-			if (fputc(0xFF, pFile) == EOF) {
-				s_State = State::ERROR;
-				nResult = result::ERROR;
-				perror("fputc(0xFF, file)");
-				DEBUG_EXIT
-				return true;
-			}
-		}
-
-		s_State = State::IDLE;
-		nResult = result::OK;
-
-		if (fflush(pFile) != 0) {
-			perror("fflush");
-		}
-
-		sync();
-		DEBUG_EXIT
+	if ((nOffset % FLASH_SECTOR_SIZE) || (nLength % FLASH_SECTOR_SIZE) || ((nOffset + nLength) > FLASH_SIZE)) {
+		DEBUG_PUTS("Erase offset/length not multiple of erase size");
+		nResult = result::ERROR;
 		return true;
 	}
 
-	DEBUG_EXIT
-	assert(0);
+	memset(&s_pFlash[nOffset], 0xFF, nLength);
+
+	nResult = commit(nOffset, nLength, false) ? result::OK : result::ERROR;
 	return true;
 }
 
 bool StoreDevice::Write(uint32_t nOffset, uint32_t nLength, const uint8_t *pBuffer, storedevice::result& nResult) {
-	DEBUG_ENTRY
 	DEBUG_PRINTF("nOffset=%u, nLength=%u", nOffset, nLength);
-	assert(s_State != State::ERROR);
-	assert(pFile != nullptr);
-
-	if (s_State == State::IDLE) {
-		if (fseek(pFile, static_cast<long int>(nOffset), SEEK_SET) != 0) {
-			s_State = State::ERROR;
-			nResult = result::ERROR;
-			perror("fseek");
-			DEBUG_EXIT
-			return true;
-		}
-
-		s_nIndex = 0;
-		s_State = State::RUNNING;
-		nResult = result::OK;
-		DEBUG_EXIT
-		return false;
-	} else if (s_State == State::RUNNING) {
-		uint32_t nBlockWriteLength = nLength - s_nIndex;
-
-		if (nBlockWriteLength > BLOCK_WRITE_LENGTH) {
-			nBlockWriteLength = BLOCK_WRITE_LENGTH;
-		}
-
-		if (fwrite(&pBuffer[s_nIndex], 1, nBlockWriteLength, pFile) != nBlockWriteLength) {
-			s_State = State::ERROR;
-			nResult = result::ERROR;
-			perror("fwrite");
-			DEBUG_EXIT
-			return true;
-		}
-
-		s_nIndex += nBlockWriteLength;
-
-		if (s_nIndex == nLength) {
-			s_State = State::IDLE;
-
-			if (fflush(pFile) != 0) {
-				perror("fflush");
-			}
-
-			sync();
-			DEBUG_EXIT
-			return true;
-		}
+	if (__builtin_expect((s_pFlash == nullptr), 0)) {
+		nResult = result::ERROR;
+		return true;
+	}
 
-		nResult = result::OK;
-		DEBUG_EXIT
-		return false;
+	if ((nOffset + nLength) > FLASH_SIZE) {
+		nResult = result::ERROR;
+		return true;
 	}
 
-	DEBUG_EXIT
+	memcpy(&s_pFlash[nOffset], pBuffer, nLength);
+
+	nResult = commit(nOffset, nLength, true) ? result::OK : result::ERROR;
 	return true;
 }
@@ -69,7 +69,7 @@ enum class Store {
 };
 
 enum class State {
-	IDLE, CHANGED, CHANGED_WAITING, ERASING, ERASED, ERASED_WAITING, WRITING
+	IDLE, CHANGED, CHANGED_WAITING, ERASING, ERASED, ERASED_WAITING, WRITING, APPENDING
 };
 }  // namespace configstore
 
@@ -115,7 +115,9 @@ public:
 
 			if (p->nUtcOffset != nUtcOffset) {
 				p->nUtcOffset = nUtcOffset;
+				SetDirty(static_cast<uint32_t>(configstore::Store::LAST), FlashStore::SIGNATURE_SIZE, FlashStore::SIGNATURE_SIZE + sizeof(int32_t));
 				s_State = configstore::State::CHANGED;
+				s_nGeneration++;
 			}
 
 			DEBUG_EXIT
@@ -148,12 +150,33 @@ public:
 		return p->nUtcOffset;
 	}
 
+	/**
+	 * Incremented on every change of the stored data.
+	 * Lets derived data, such as the cached JSON responses, detect that it is stale.
+	 */
+	static uint32_t GetGeneration() {
+		return s_nGeneration;
+	}
+
 	static ConfigStore *Get() {
 		return s_pThis;
 	}
 
 private:
 	uint32_t GetStoreOffset(configstore::Store tStore);
+	/**
+	 * Region 0..Store::LAST-1 are the stores, region Store::LAST is the signature and environment
+	 */
+	void GetRegion(const uint32_t nRegion, uint32_t& nOffset, uint32_t& nSize);
+
+#if defined (CONFIG_STORE_LOG)
+	void LogMount();
+	bool LogFlash();
+	void LogDump();
+	static void SetDirty(const uint32_t nRegion, const uint32_t nBegin, const uint32_t nEnd);
+#else
+	static void SetDirty([[maybe_unused]] const uint32_t nRegion, [[maybe_unused]] const uint32_t nBegin, [[maybe_unused]] const uint32_t nEnd) {}
+#endif
 
 private:
 	struct Env {
@@ -166,6 +189,7 @@ private:
 		static constexpr uint32_t ENV_SIZE = 16;
 		static constexpr uint32_t OFFSET_STORES = SIGNATURE_SIZE + ENV_SIZE;
 		static constexpr uint32_t SIZE = 4096;
+		static constexpr uint32_t STORE_SIZE_MAX = 1024;
 	};
 
 	static_assert(sizeof(struct Env) == FlashStore::ENV_SIZE, "");
@@ -179,6 +203,7 @@ private:
 	static uint8_t s_SpiFlashData[FlashStore::SIZE];
 
 	static uint32_t s_nWaitMillis;
+	static uint32_t s_nGeneration;
 
 	static ConfigStore *s_pThis;
 };
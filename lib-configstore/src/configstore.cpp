@@ -44,6 +44,15 @@ using namespace configstore;
 
 static constexpr uint8_t s_aSignature[] = {'A', 'v', 'V', 0x01};
 static constexpr uint32_t s_aStorSize[static_cast<uint32_t>(Store::LAST)]  = {96,        32,    64,      64,    32,     32,        480,          64,         32,        96,           48,        32,      944,          48,        64,            32,        96,         32,      1024,     32,     32,       64,            96,               32,    32,          320,    32};
+
+static constexpr uint32_t store_size_max() {
+	uint32_t nMax = 0;
+	for (const auto nSize : s_aStorSize) {
+		nMax = nSize > nMax ? nSize : nMax;
+	}
+	return nMax;
+}
+
 #ifndef NDEBUG
 static constexpr char s_aStoreName[static_cast<uint32_t>(Store::LAST)][16] = {"Network", "DMX", "Pixel", "LTC", "MIDI", "LTC ETC", "OSC Server", "TLC59711", "USB Pro", "RDM Device", "RConfig", "TCNet", "OSC Client", "Display", "LTC Display", "Monitor", "SparkFun", "Slush", "Motors", "Show", "Serial", "RDM Sensors", "RDM SubDevices", "GPS", "RGB Panel", "Node", "PCA9685"};
 #endif
@@ -53,6 +62,7 @@ State ConfigStore::s_State;
 uint32_t ConfigStore::s_nStartAddress;
 uint32_t ConfigStore::s_nSpiFlashStoreSize;
 uint32_t ConfigStore::s_nWaitMillis;
+uint32_t ConfigStore::s_nGeneration;
 uint8_t ConfigStore::s_SpiFlashData[FlashStore::SIZE] SECTION_CONFIGSTORE;
 
 ConfigStore *ConfigStore::s_pThis;
@@ -61,6 +71,7 @@ ConfigStore::ConfigStore() {
 	DEBUG_ENTRY
 
 	static_assert(sizeof(s_aSignature) <= FlashStore::SIGNATURE_SIZE);
+	static_assert(store_size_max() <= FlashStore::STORE_SIZE_MAX);
 
 	assert(s_pThis == nullptr);
 	s_pThis = this;
@@ -69,6 +80,9 @@ ConfigStore::ConfigStore() {
 
 	s_bHaveFlashChip = StoreDevice::IsDetected();
 
+#if defined (CONFIG_STORE_LOG)
+	LogMount();
+#else
 	assert(FlashStore::SIZE <= StoreDevice::GetSize());
 
 	const auto nEraseSize = StoreDevice::GetSectorSize();
@@ -89,6 +103,7 @@ ConfigStore::ConfigStore() {
 		StoreDevice::Read(s_nStartAddress, FlashStore::SIZE, reinterpret_cast<uint8_t *>(&s_SpiFlashData), result);
 		assert(result == storedevice::result::OK);
 	}
+#endif
 
 	bool bSignatureOK = true;
 
@@ -147,10 +162,26 @@ uint32_t ConfigStore::GetStoreOffset(Store store) {
 	return nOffset;
 }
 
+void ConfigStore::GetRegion(const uint32_t nRegion, uint32_t& nOffset, uint32_t& nSize) {
+	assert(nRegion <= static_cast<uint32_t>(Store::LAST));
+
+	if (nRegion == static_cast<uint32_t>(Store::LAST)) {
+		nOffset = 0;
+		nSize = FlashStore::OFFSET_STORES;
+		return;
+	}
+
+	nOffset = GetStoreOffset(static_cast<Store>(nRegion));
+	nSize = s_aStorSize[nRegion];
+}
+
 void ConfigStore::ResetSetList(Store store) {
 	assert(store < Store::LAST);
 
-	auto *pbSetList = &s_SpiFlashData[GetStoreOffset(store)];
+	const auto nOffset = GetStoreOffset(store);
+	auto *pbSetList = &s_SpiFlashData[nOffset];
+
+	SetDirty(static_cast<uint32_t>(store), nOffset, nOffset + sizeof(uint32_t));
 
 	*pbSetList++ = 0x00;
 	*pbSetList++ = 0x00;
@@ -158,6 +189,7 @@ void ConfigStore::ResetSetList(Store store) {
 	*pbSetList = 0x00;
 
 	s_State = State::CHANGED;
+	s_nGeneration++;
 }
 
 void ConfigStore::Update(Store store, uint32_t nOffset, const void *pData, uint32_t nDataLength, uint32_t nSetList, uint32_t nOffsetSetList) {
@@ -169,7 +201,10 @@ void ConfigStore::Update(Store store, uint32_t nOffset, const void *pData, uint3
 	assert((nOffset + nDataLength) <= s_aStorSize[static_cast<uint32_t>(store)]);
 
 	auto bIsChanged = false;
-	const auto nBase = nOffset + GetStoreOffset(store);
+	const auto nStoreOffset = GetStoreOffset(store);
+	const auto nBase = nOffset + nStoreOffset;
+	uint32_t nFirst = 0;
+	uint32_t nLast = 0;
 
 	const auto *pSrc = static_cast<const uint8_t *>(pData);
 	auto *pDst = &s_SpiFlashData[nBase];
@@ -183,6 +218,10 @@ void ConfigStore::Update(Store store, uint32_t nOffset, const void *pData, uint3
 
 	for (uint32_t i = 0; i < nDataLength; i++) {
 		if (*pSrc != *pDst) {
+			if (!bIsChanged) {
+				nFirst = i;
+			}
+			nLast = i;
 			bIsChanged = true;
 			*pDst = *pSrc;
 		}
@@ -191,15 +230,22 @@ void ConfigStore::Update(Store store, uint32_t nOffset, const void *pData, uint3
 	}
 
 	if (bIsChanged){
-		auto *pSet = reinterpret_cast<uint32_t *>((&s_SpiFlashData[GetStoreOffset(store)] + nOffsetSetList));
+		auto *pSet = reinterpret_cast<uint32_t *>((&s_SpiFlashData[nStoreOffset] + nOffsetSetList));
 		*pSet |= nSetList;
+
+		SetDirty(static_cast<uint32_t>(store), nBase + nFirst, nBase + nLast + 1);
+
+		if (nSetList != 0) {
+			SetDirty(static_cast<uint32_t>(store), nStoreOffset + nOffsetSetList, nStoreOffset + nOffsetSetList + sizeof(uint32_t));
+		}
 	}
 
 	if (bIsChanged) {
 		s_State = State::CHANGED;
+		s_nGeneration++;
 	}
 
-	debug_dump(&s_SpiFlashData[GetStoreOffset(store)] + nOffsetSetList, 8);
+	debug_dump(&s_SpiFlashData[nStoreOffset] + nOffsetSetList, 8);
 	DEBUG_EXIT
 }
 
@@ -237,7 +283,12 @@ void ConfigStore::Copy(const Store store, void *pData, uint32_t nDataLength, uin
 }
 
 void ConfigStore::Delay() {
+#if defined (CONFIG_STORE_LOG)
+	// Only restart the hold-off, a record or an erase in progress must complete
+	if (s_State == State::CHANGED_WAITING) {
+#else
 	if (s_State != State::IDLE) {
+#endif
 		s_State = State::CHANGED;
 	}
 }
@@ -247,6 +298,10 @@ bool ConfigStore::Flash() {
 		return false;
 	}
 
+#if defined (CONFIG_STORE_LOG)
+	return LogFlash();
+#else
+
 	switch (s_State) {
 	case State::CHANGED:
 		s_nWaitMillis = Hardware::Get()->Millis();
@@ -300,6 +355,7 @@ bool ConfigStore::Flash() {
 	assert(0);
 	__builtin_unreachable();
 	return false;
+#endif
 }
 
 void ConfigStore::Dump() {
@@ -331,5 +387,8 @@ void ConfigStore::Dump() {
 	}
 
 	printf("m_tState=%d\n", static_cast<uint32_t>(s_State));
+#if defined (CONFIG_STORE_LOG)
+	LogDump();
+#endif
 #endif
 }
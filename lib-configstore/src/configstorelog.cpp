@@ -0,0 +1,424 @@
+/**
+ * @file configstorelog.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined (CONFIG_STORE_LOG)
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+
+#include "configstore.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+/*
+ * The log is a ring of BLOCKS blocks at the end of the StoreDevice.
+ * A block starts with a BlockHeader, followed by records. A record patches
+ * nLength bytes at nOffset of the RAM image s_SpiFlashData.
+ *
+ * Compaction erases the next block, writes a snapshot of all regions as records
+ * and then, as the very last step, the BlockHeader with the next sequence number.
+ * On boot the valid block with the highest sequence is replayed; a record with a bad
+ * CRC (power failure during an append) ends the replay and forces a compaction.
+ */
+
+namespace configstore {
+namespace log {
+#if !defined (CONFIG_STORE_LOG_BLOCKS)
+# define CONFIG_STORE_LOG_BLOCKS 4
+#endif
+static constexpr uint32_t BLOCKS = CONFIG_STORE_LOG_BLOCKS;
+static constexpr uint32_t BLOCK_NONE = BLOCKS;
+static constexpr uint32_t BLOCK_MAGIC = 0x4C567641;	// AvVL
+static constexpr uint16_t RECORD_MAGIC = 0x5243;	// CR
+static constexpr uint16_t ERASED = 0xFFFF;
+static constexpr uint32_t REGIONS = static_cast<uint32_t>(Store::LAST) + 1;
+
+static_assert(BLOCKS >= 2, "");
+static_assert(REGIONS <= 32, "");
+
+struct BlockHeader {
+	uint32_t nMagic;
+	uint32_t nSequence;
+	uint32_t nSequenceInverted;
+	uint32_t nReserved;
+};
+
+struct RecordHeader {
+	uint16_t nMagic;
+	uint16_t nOffset;
+	uint16_t nLength;
+	uint16_t nCrc;
+};
+
+static constexpr uint32_t RECORD_SIZE_MAX = sizeof(struct RecordHeader) + 1024 + 3;
+
+static uint32_t s_nBlockSize;
+static uint32_t s_nBlock = BLOCK_NONE;
+static uint32_t s_nSequence;
+static uint32_t s_nWriteOffset;		///< Append position in the current block
+static bool s_bCompact;
+
+static uint32_t s_nDirty;
+static uint16_t s_nDirtyBegin[REGIONS];
+static uint16_t s_nDirtyEnd[REGIONS];
+
+static uint8_t s_Record[RECORD_SIZE_MAX] __attribute__((aligned(4)));
+static uint32_t s_nRecordLength;	///< 0 is no write in progress
+static uint32_t s_nRecordAddress;
+
+static uint32_t s_nTargetBlock;
+static uint32_t s_nSnapshotRegion;
+static uint32_t s_nSnapshotOffset;
+
+static uint32_t s_nAppends;
+static uint32_t s_nCompactions;
+
+static uint16_t crc16(uint16_t nCrc, const uint8_t *pData, uint32_t nLength) {
+	while (nLength-- != 0) {
+		nCrc ^= static_cast<uint16_t>(*pData++ << 8);
+		for (uint32_t i = 0; i < 8; i++) {
+			nCrc = (nCrc & 0x8000) ? static_cast<uint16_t>((nCrc << 1) ^ 0x1021) : static_cast<uint16_t>(nCrc << 1);
+		}
+	}
+
+	return nCrc;
+}
+
+static uint16_t record_crc(const struct RecordHeader *pHeader, const uint8_t *pData) {
+	const auto nCrc = crc16(0xFFFF, reinterpret_cast<const uint8_t *>(&pHeader->nOffset), 2 * sizeof(uint16_t));
+	return crc16(nCrc, pData, pHeader->nLength);
+}
+
+/**
+ * @return the record size in the log, padded to 4 bytes
+ */
+static uint32_t record_build(const uint8_t *pImage, const uint32_t nOffset, const uint32_t nLength) {
+	assert((sizeof(struct RecordHeader) + nLength) <= RECORD_SIZE_MAX);
+
+	auto *pHeader = reinterpret_cast<struct RecordHeader *>(s_Record);
+	pHeader->nMagic = RECORD_MAGIC;
+	pHeader->nOffset = static_cast<uint16_t>(nOffset);
+	pHeader->nLength = static_cast<uint16_t>(nLength);
+
+	auto *pData = &s_Record[sizeof(struct RecordHeader)];
+	memcpy(pData, &pImage[nOffset], nLength);
+
+	pHeader->nCrc = record_crc(pHeader, pData);
+
+	const auto nSize = (sizeof(struct RecordHeader) + nLength + 3U) & ~3U;
+	memset(&pData[nLength], 0xFF, nSize - sizeof(struct RecordHeader) - nLength);
+
+	return nSize;
+}
+
+static uint32_t block_address(const uint32_t nStartAddress, const uint32_t nBlock) {
+	return nStartAddress + nBlock * s_nBlockSize;
+}
+
+/**
+ * @return true when the write is complete
+ */
+static bool record_write(StoreDevice& storeDevice) {
+	auto result = storedevice::result::OK;
+	const auto isDone = storeDevice.Write(s_nRecordAddress, s_nRecordLength, s_Record, result);
+	assert(result == storedevice::result::OK);
+	return isDone;
+}
+}  // namespace log
+}  // namespace configstore
+
+using namespace configstore;
+
+void ConfigStore::SetDirty(const uint32_t nRegion, const uint32_t nBegin, const uint32_t nEnd) {
+	assert(nRegion < log::REGIONS);
+	assert(nBegin < nEnd);
+
+	const auto nMask = 1U << nRegion;
+
+	if ((log::s_nDirty & nMask) == 0) {
+		log::s_nDirty |= nMask;
+		log::s_nDirtyBegin[nRegion] = static_cast<uint16_t>(nBegin);
+		log::s_nDirtyEnd[nRegion] = static_cast<uint16_t>(nEnd);
+		return;
+	}
+
+	if (nBegin < log::s_nDirtyBegin[nRegion]) {
+		log::s_nDirtyBegin[nRegion] = static_cast<uint16_t>(nBegin);
+	}
+
+	if (nEnd > log::s_nDirtyEnd[nRegion]) {
+		log::s_nDirtyEnd[nRegion] = static_cast<uint16_t>(nEnd);
+	}
+}
+
+void ConfigStore::LogMount() {
+	DEBUG_ENTRY
+
+	const auto nSectorSize = StoreDevice::GetSectorSize();
+	assert(nSectorSize != 0);
+
+	// A snapshot of all regions must fit with room to spare for appends
+	log::s_nBlockSize = ((2 * FlashStore::SIZE + nSectorSize - 1) / nSectorSize) * nSectorSize;
+
+	assert((log::BLOCKS * log::s_nBlockSize) <= StoreDevice::GetSize());
+	s_nStartAddress = StoreDevice::GetSize() - (log::BLOCKS * log::s_nBlockSize);
+
+	DEBUG_PRINTF("s_nStartAddress=%p, s_nBlockSize=%u", reinterpret_cast<void *>(s_nStartAddress), log::s_nBlockSize);
+
+	log::s_nBlock = log::BLOCK_NONE;
+	log::s_bCompact = true;
+
+	if (!s_bHaveFlashChip) {
+		DEBUG_EXIT
+		return;
+	}
+
+	storedevice::result result;
+
+	for (uint32_t nBlock = 0; nBlock < log::BLOCKS; nBlock++) {
+		struct log::BlockHeader header;
+		StoreDevice::Read(log::block_address(s_nStartAddress, nBlock), sizeof(header), reinterpret_cast<uint8_t *>(&header), result);
+
+		if ((result != storedevice::result::OK) || (header.nMagic != log::BLOCK_MAGIC) || (header.nSequence != ~header.nSequenceInverted)) {
+			continue;
+		}
+
+		if ((log::s_nBlock == log::BLOCK_NONE) || (static_cast<int32_t>(header.nSequence - log::s_nSequence) > 0)) {
+			log::s_nBlock = nBlock;
+			log::s_nSequence = header.nSequence;
+		}
+	}
+
+	if (log::s_nBlock == log::BLOCK_NONE) {
+		/*
+		 * Migrate the full image written by the non-log ConfigStore. It is in the last sector, which is the
+		 * last block to be erased by the compactions, so a power failure now does not lose it.
+		 */
+		DEBUG_PUTS("No log, reading the image");
+		StoreDevice::Read(StoreDevice::GetSize() - FlashStore::SIZE, FlashStore::SIZE, s_SpiFlashData, result);
+		assert(result == storedevice::result::OK);
+		s_State = State::CHANGED;
+		DEBUG_EXIT
+		return;
+	}
+
+	const auto nBlockAddress = log::block_address(s_nStartAddress, log::s_nBlock);
+	auto nOffset = static_cast<uint32_t>(sizeof(struct log::BlockHeader));
+	bool isCorrupt = false;
+
+	while ((nOffset + sizeof(struct log::RecordHeader)) <= log::s_nBlockSize) {
+		auto *pHeader = reinterpret_cast<struct log::RecordHeader *>(log::s_Record);
+		StoreDevice::Read(nBlockAddress + nOffset, sizeof(struct log::RecordHeader), log::s_Record, result);
+
+		if ((pHeader->nMagic == log::ERASED) && (pHeader->nLength == log::ERASED)) {
+			break;
+		}
+
+		const auto nSize = (sizeof(struct log::RecordHeader) + pHeader->nLength + 3U) & ~3U;
+
+		if ((pHeader->nMagic != log::RECORD_MAGIC)
+				|| ((pHeader->nOffset + pHeader->nLength) > FlashStore::SIZE)
+				|| (nSize > log::RECORD_SIZE_MAX)
+				|| ((nOffset + nSize) > log::s_nBlockSize)) {
+			isCorrupt = true;
+			break;
+		}
+
+		auto *pData = &log::s_Record[sizeof(struct log::RecordHeader)];
+		StoreDevice::Read(nBlockAddress + nOffset + sizeof(struct log::RecordHeader), pHeader->nLength, pData, result);
+
+		if (log::record_crc(pHeader, pData) != pHeader->nCrc) {
+			isCorrupt = true;
+			break;
+		}
+
+		memcpy(&s_SpiFlashData[pHeader->nOffset], pData, pHeader->nLength);
+		nOffset += nSize;
+	}
+
+	log::s_nWriteOffset = nOffset;
+	log::s_bCompact = isCorrupt;
+
+	if (isCorrupt) {
+		printf("ConfigStore: log block %u is corrupt at %u\n", log::s_nBlock, nOffset);
+		s_State = State::CHANGED;
+	}
+
+	DEBUG_PRINTF("s_nBlock=%u, s_nSequence=%u, s_nWriteOffset=%u", log::s_nBlock, log::s_nSequence, log::s_nWriteOffset);
+	DEBUG_EXIT
+}
+
+bool ConfigStore::LogFlash() {
+	switch (s_State) {
+	case State::CHANGED:
+		s_nWaitMillis = Hardware::Get()->Millis();
+		s_State = State::CHANGED_WAITING;
+		return true;
+	case State::CHANGED_WAITING:
+		if ((Hardware::Get()->Millis() - s_nWaitMillis) < 100) {
+			return true;
+		}
+		s_State = log::s_bCompact ? State::ERASING : State::APPENDING;
+		return true;
+	case State::APPENDING: {
+		if (log::s_nRecordLength == 0) {
+			if (log::s_nDirty == 0) {
+				// Compact ahead, so that the next change is an append again
+				if (log::s_nWriteOffset > ((log::s_nBlockSize * 3) / 4)) {
+					log::s_bCompact = true;
+					s_State = State::ERASING;
+					return true;
+				}
+
+				s_State = State::IDLE;
+				return false;
+			}
+
+			const auto nRegion = static_cast<uint32_t>(__builtin_ctz(log::s_nDirty));
+			const auto nBegin = log::s_nDirtyBegin[nRegion];
+			const auto nLength = static_cast<uint32_t>(log::s_nDirtyEnd[nRegion] - nBegin);
+			const auto nSize = (sizeof(struct log::RecordHeader) + nLength + 3U) & ~3U;
+
+			if ((log::s_nWriteOffset + nSize) > log::s_nBlockSize) {
+				log::s_bCompact = true;
+				s_State = State::ERASING;
+				return true;
+			}
+
+			log::s_nDirty &= ~(1U << nRegion);
+			log::s_nRecordLength = log::record_build(s_SpiFlashData, nBegin, nLength);
+			log::s_nRecordAddress = log::block_address(s_nStartAddress, log::s_nBlock) + log::s_nWriteOffset;
+		}
+
+		if (log::record_write(*this)) {
+			log::s_nWriteOffset += log::s_nRecordLength;
+			log::s_nRecordLength = 0;
+			log::s_nAppends++;
+		}
+
+		return true;
+	}
+		break;
+	case State::ERASING: {
+		log::s_nTargetBlock = (log::s_nBlock == log::BLOCK_NONE) ? 0 : (log::s_nBlock + 1) % log::BLOCKS;
+
+		storedevice::result result;
+		if (StoreDevice::Erase(log::block_address(s_nStartAddress, log::s_nTargetBlock), log::s_nBlockSize, result)) {
+			s_nWaitMillis = Hardware::Get()->Millis();
+			s_State = State::ERASED_WAITING;
+		}
+		assert(result == storedevice::result::OK);
+		return true;
+	}
+		break;
+	case State::ERASED_WAITING:
+		if ((Hardware::Get()->Millis() - s_nWaitMillis) < 100) {
+			return true;
+		}
+		s_State = State::ERASED;
+		return true;
+		break;
+	case State::ERASED:
+		log::s_nSnapshotRegion = 0;
+		log::s_nSnapshotOffset = sizeof(struct log::BlockHeader);
+		log::s_nRecordLength = 0;
+		s_State = State::WRITING;
+		return true;
+		break;
+	case State::WRITING: {
+		const auto nTargetAddress = log::block_address(s_nStartAddress, log::s_nTargetBlock);
+
+		if (log::s_nRecordLength == 0) {
+			if (log::s_nSnapshotRegion < log::REGIONS) {
+				uint32_t nOffset, nSize;
+				GetRegion(log::s_nSnapshotRegion, nOffset, nSize);
+
+				log::s_nDirty &= ~(1U << log::s_nSnapshotRegion);
+				log::s_nRecordLength = log::record_build(s_SpiFlashData, nOffset, nSize);
+				log::s_nRecordAddress = nTargetAddress + log::s_nSnapshotOffset;
+			} else {
+				// The header is written last, it makes the new block valid
+				auto *pHeader = reinterpret_cast<struct log::BlockHeader *>(log::s_Record);
+				pHeader->nMagic = log::BLOCK_MAGIC;
+				pHeader->nSequence = log::s_nSequence + 1;
+				pHeader->nSequenceInverted = ~pHeader->nSequence;
+				pHeader->nReserved = UINT32_MAX;
+
+				log::s_nRecordLength = sizeof(struct log::BlockHeader);
+				log::s_nRecordAddress = nTargetAddress;
+			}
+		}
+
+		if (!log::record_write(*this)) {
+			return true;
+		}
+
+		if (log::s_nSnapshotRegion < log::REGIONS) {
+			log::s_nSnapshotOffset += log::s_nRecordLength;
+			log::s_nSnapshotRegion++;
+			log::s_nRecordLength = 0;
+			return true;
+		}
+
+		log::s_nRecordLength = 0;
+		log::s_nBlock = log::s_nTargetBlock;
+		log::s_nSequence++;
+		log::s_nWriteOffset = log::s_nSnapshotOffset;
+		log::s_bCompact = false;
+		log::s_nCompactions++;
+
+		DEBUG_PRINTF("s_nBlock=%u, s_nSequence=%u, s_nWriteOffset=%u", log::s_nBlock, log::s_nSequence, log::s_nWriteOffset);
+
+		if (log::s_nDirty != 0) {
+			s_State = State::APPENDING;
+			return true;
+		}
+
+		s_State = State::IDLE;
+		return false;
+	}
+		break;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
+	}
+
+	assert(0);
+	__builtin_unreachable();
+	return false;
+}
+
+void ConfigStore::LogDump() {
+	printf("Log block %u/%u, sequence %u, used %u/%u, appends %u, compactions %u, dirty 0x%.8x\n",
+			log::s_nBlock, log::BLOCKS, log::s_nSequence, log::s_nWriteOffset, log::s_nBlockSize,
+			log::s_nAppends, log::s_nCompactions, log::s_nDirty);
+}
+
+#endif
@@ -78,7 +78,6 @@ struct State {
 	uint16_t nSynchronizationAddressSourceB;
 	uint8_t nEnabledInputPorts;
 	uint8_t nEnableOutputPorts;
-	uint8_t nPriority;
 	uint8_t nReceivingDmx;
 	lightset::FailSafe failsafe;
 	e131bridge::Status status;
@@ -99,16 +98,7 @@ struct Bridge {
 	} Port[e131bridge::MAX_PORTS] ALIGNED;
 };
 
-struct Source {
-	uint32_t nMillis;
-	uint32_t nIp;
-	uint8_t cid[e131::CID_LENGTH];
-	uint8_t nSequenceNumberData;
-};
-
 struct OutputPort {
-	Source sourceA ALIGNED;
-	Source sourceB ALIGNED;
 	lightset::MergeMode mergeMode;
 	lightset::OutputStyle outputStyle;
 	bool IsMerging;
@@ -204,6 +194,9 @@ public:
 		return false;
 	}
 
+	/**
+	 * Only stored, sACN sources always time out after e131::PRIORITY_TIMEOUT_SECONDS.
+	 */
 	void SetDisableMergeTimeout(bool bDisable) {
 		m_State.bDisableMergeTimeout = bDisable;
 	}
@@ -375,14 +368,15 @@ private:
 	bool IsValidRoot();
 	bool IsValidDataPacket();
 
-	void SetNetworkDataLossCondition(bool bSourceA = true, bool bSourceB = true);
+	/**
+	 * @param pId nullptr is all sources
+	 */
+	void SetNetworkDataLossCondition(const lightset::source::Id *pId = nullptr);
 
-	void SetSynchronizationAddress(bool bSourceA, bool bSourceB, uint16_t nSynchronizationAddress);
+	void SetSynchronizationAddress(const uint32_t nSource, const uint16_t nSynchronizationAddress);
 
-	void CheckMergeTimeouts(uint32_t nPortIndex);
-	bool IsPriorityTimeOut(uint32_t nPortIndex) const;
-	bool isIpCidMatch(const e131bridge::Source *const) const;
 	void UpdateMergeStatus(const uint32_t nPortIndex);
+	void ClearMergeStatus(const uint32_t nPortIndex);
 
 	void HandleDmx();
 	void HandleSynchronization();
@@ -2,7 +2,7 @@
  * @file e131paramsconst.h
  *
  */
-/* Copyright (C) 2019-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -29,9 +29,14 @@
 #include "e131params.h"
 
 struct E131ParamsConst {
-	static const char FILE_NAME[];
+	static constexpr char FILE_NAME[] = "e131.txt";
 
-	static const char PRIORITY[e131params::MAX_PORTS][18];
+	static constexpr char PRIORITY[e131params::MAX_PORTS][18] = {
+			"priority_port_a",
+			"priority_port_b",
+			"priority_port_c",
+			"priority_port_d"
+	};
 };
 
 #endif /* E131PARAMSCONST_H_ */
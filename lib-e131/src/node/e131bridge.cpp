@@ -2,7 +2,7 @@
  * @file e131bridge.cpp
  *
  */
-/* Copyright (C) 2016-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2016-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -68,7 +68,6 @@ E131Bridge::E131Bridge() {
 	}
 
 	memset(&m_State, 0, sizeof(e131bridge::State));
-	m_State.nPriority = e131::priority::LOWEST;
 	m_State.failsafe = lightset::FailSafe::HOLD;
 
 	for (uint32_t i = 0; i < e131bridge::MAX_PORTS; i++) {
@@ -153,22 +152,17 @@ void E131Bridge::Stop() {
 	Hardware::Get()->SetMode(hardware::ledblink::Mode::OFF_OFF);
 }
 
-void E131Bridge::SetSynchronizationAddress(bool bSourceA, bool bSourceB, uint16_t nSynchronizationAddress) {
+/**
+ * Two synchronization addresses are tracked, the one of the source in slot 0
+ * and the one shared by all other sources.
+ */
+void E131Bridge::SetSynchronizationAddress(const uint32_t nSource, const uint16_t nSynchronizationAddress) {
 	DEBUG_ENTRY
-	DEBUG_PRINTF("bSourceA=%d, bSourceB=%d, nSynchronizationAddress=%d", bSourceA, bSourceB, nSynchronizationAddress);
+	DEBUG_PRINTF("nSource=%u, nSynchronizationAddress=%d", nSource, nSynchronizationAddress);
 
 	assert(nSynchronizationAddress != 0);
 
-	uint16_t *pSynchronizationAddressSource;
-
-	if (bSourceA) {
-		pSynchronizationAddressSource = &m_State.nSynchronizationAddressSourceA;
-	} else if (bSourceB) {
-		pSynchronizationAddressSource = &m_State.nSynchronizationAddressSourceB;
-	} else {
-		DEBUG_EXIT
-		return; // Just make the compiler happy
-	}
+	auto *pSynchronizationAddressSource = (nSource == 0) ? &m_State.nSynchronizationAddressSourceA : &m_State.nSynchronizationAddressSourceB;
 
 	if (*pSynchronizationAddressSource == 0) {
 		*pSynchronizationAddressSource = nSynchronizationAddress;
@@ -235,15 +229,7 @@ void E131Bridge::SetLocalMerging() {
 
 			if (m_Bridge.Port[nInputPortIndex].nUniverse == m_Bridge.Port[nOutputPortIndex].nUniverse) {
 
-				if (!m_Bridge.Port[nOutputPortIndex].bLocalMerge) {
-					m_OutputPort[nOutputPortIndex].sourceA.nIp = Network::Get()->GetIp();
-					DEBUG_PUTS("Local merge Source A");
-				} else {
-					m_OutputPort[nOutputPortIndex].sourceB.nIp = Network::Get()->GetIp();
-					DEBUG_PUTS("Local merge Source B");
-				}
-
-				DEBUG_PUTS("");
+				DEBUG_PRINTF("Local merge %u -> %u", nInputPortIndex, nOutputPortIndex);
 				m_Bridge.Port[nInputPortIndex].bLocalMerge = true;
 				m_Bridge.Port[nOutputPortIndex].bLocalMerge = true;
 			}
@@ -336,24 +322,13 @@ void E131Bridge::UpdateMergeStatus(const uint32_t nPortIndex) {
 	m_OutputPort[nPortIndex].IsMerging = true;
 }
 
-void E131Bridge::CheckMergeTimeouts(uint32_t nPortIndex) {
+/**
+ * The per-source timeouts are done by the merge engine, see lightset::Data::Merge
+ */
+void E131Bridge::ClearMergeStatus(const uint32_t nPortIndex) {
 	assert(nPortIndex < e131bridge::MAX_PORTS);
 
-	const auto timeOutA = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceA.nMillis;
-
-	if (timeOutA > (e131::MERGE_TIMEOUT_SECONDS * 1000U)) {
-		m_OutputPort[nPortIndex].sourceA.nIp = 0;
-		memset(m_OutputPort[nPortIndex].sourceA.cid, 0, e131::CID_LENGTH);
-		m_OutputPort[nPortIndex].IsMerging = false;
-	}
-
-	const auto timeOutB = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceB.nMillis;
-
-	if (timeOutB > (e131::MERGE_TIMEOUT_SECONDS * 1000U)) {
-		m_OutputPort[nPortIndex].sourceB.nIp = 0;
-		memset(m_OutputPort[nPortIndex].sourceB.cid, 0, e131::CID_LENGTH);
-		m_OutputPort[nPortIndex].IsMerging = false;
-	}
+	m_OutputPort[nPortIndex].IsMerging = false;
 
 	auto bIsMerging = false;
 
@@ -367,49 +342,16 @@ void E131Bridge::CheckMergeTimeouts(uint32_t nPortIndex) {
 	}
 }
 
-bool E131Bridge::IsPriorityTimeOut(uint32_t nPortIndex) const {
-	assert(nPortIndex < e131bridge::MAX_PORTS);
-
-	const auto timeOutA = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceA.nMillis;
-	const auto timeOutB = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceB.nMillis;
-
-	if ( (m_OutputPort[nPortIndex].sourceA.nIp != 0) && (m_OutputPort[nPortIndex].sourceB.nIp != 0) ) {
-		if ( (timeOutA < (e131::PRIORITY_TIMEOUT_SECONDS * 1000U)) || (timeOutB < (e131::PRIORITY_TIMEOUT_SECONDS * 1000U)) ) {
-			return false;
-		} else {
-			return true;
-		}
-	} else if ( (m_OutputPort[nPortIndex].sourceA.nIp != 0) && (m_OutputPort[nPortIndex].sourceB.nIp == 0) ) {
-		if (timeOutA > (e131::PRIORITY_TIMEOUT_SECONDS * 1000U)) {
-			return true;
-		}
-	} else if ( (m_OutputPort[nPortIndex].sourceA.nIp == 0) && (m_OutputPort[nPortIndex].sourceB.nIp != 0) ) {
-		if (timeOutB > (e131::PRIORITY_TIMEOUT_SECONDS * 1000U)) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool E131Bridge::isIpCidMatch(const e131bridge::Source *const source) const {
-	if (source->nIp != m_nIpAddressFrom) {
-		return false;
-	}
-
-	const auto *const pRaw = reinterpret_cast<TE131RawPacket *>(m_pReceiveBuffer);
-
-	if (memcmp(source->cid, pRaw->RootLayer.Cid, e131::CID_LENGTH) != 0) {
-		return false;
-	}
-
-	return true;
-}
-
 void E131Bridge::HandleDmx() {
 	const auto *const pData = reinterpret_cast<TE131DataPacket *>(m_pReceiveBuffer);
 	const auto *const pDmxData = &pData->DMPLayer.PropertyValues[1];
 	const auto nDmxSlots = __builtin_bswap16(pData->DMPLayer.PropertyValueCount) - 1U;
+	const auto id = lightset::source::make_id(m_nIpAddressFrom, pData->RootLayer.Cid);
+	// A source which stopped sending is always lost after the priority time-out, otherwise it
+	// would stay merged (or hold a priority) forever. Hence disable_merge_timeout has no effect for sACN.
+	static constexpr auto nTimeoutMillis = e131::PRIORITY_TIMEOUT_SECONDS * 1000U;
+
+	using lightset::source::Result;
 
 	for (uint32_t nPortIndex = 0; nPortIndex < e131bridge::MAX_PORTS; nPortIndex++) {
 		if (m_Bridge.Port[nPortIndex].direction == lightset::PortDir::OUTPUT) {
@@ -421,31 +363,12 @@ void E131Bridge::HandleDmx() {
 				continue;
 			}
 
-			auto *pSourceA = &m_OutputPort[nPortIndex].sourceA;
-			auto *pSourceB = &m_OutputPort[nPortIndex].sourceB;
-
-			const auto ipA = pSourceA->nIp;
-			const auto ipB = pSourceB->nIp;
-
-			const auto isSourceA = isIpCidMatch(pSourceA);
-			const auto isSourceB = isIpCidMatch(pSourceB);
-
 			// 6.9.2 Sequence Numbering
 			// Having first received a packet with sequence number A, a second packet with sequence number B
 			// arrives. If, using signed 8-bit binary arithmetic, B – A is less than or equal to 0, but greater than -20 then
 			// the packet containing sequence number B shall be deemed out of sequence and discarded
-			if (isSourceA) {
-				const auto diff = static_cast<int8_t>(pData->FrameLayer.SequenceNumber - pSourceA->nSequenceNumberData);
-				pSourceA->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				if ((diff <= 0) && (diff > -20)) {
-					continue;
-				}
-			} else if (isSourceB) {
-				const auto diff = static_cast<int8_t>(pData->FrameLayer.SequenceNumber - pSourceB->nSequenceNumberData);
-				pSourceB->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				if ((diff <= 0) && (diff > -20)) {
-					continue;
-				}
+			if (!lightset::Data::CheckSequence(nPortIndex, id, pData->FrameLayer.SequenceNumber, m_nCurrentPacketMillis, nTimeoutMillis)) {
+				continue;
 			}
 
 			// This bit, when set to 1, indicates that the data in this packet is intended for use in visualization or media
@@ -457,89 +380,39 @@ void E131Bridge::HandleDmx() {
 			// Upon receipt of a packet containing this bit set to a value of 1, receiver shall enter network data loss condition.
 			// Any property values in these packets shall be ignored.
 			if ((pData->FrameLayer.Options & e131::OptionsMask::STREAM_TERMINATED) != 0) {
-				if (isSourceA || isSourceB) {
-					SetNetworkDataLossCondition(isSourceA, isSourceB);
+				if (lightset::Data::GetSource(nPortIndex, id) != nullptr) {
+					SetNetworkDataLossCondition(&id);
 				}
 				continue;
 			}
 
-			if (m_State.IsMergeMode) {
-				if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
-					CheckMergeTimeouts(nPortIndex);
-				}
-			}
+			const auto result = lightset::Data::Merge(nPortIndex, id, pData->FrameLayer.Priority, m_nCurrentPacketMillis, pDmxData, nDmxSlots, m_OutputPort[nPortIndex].mergeMode, nTimeoutMillis);
 
-			if (pData->FrameLayer.Priority < m_State.nPriority ){
-				if (!IsPriorityTimeOut(nPortIndex)) {
-					continue;
+			switch (result) {
+			case Result::FIRST:
+			case Result::SET:
+				if (m_OutputPort[nPortIndex].IsMerging) {
+					ClearMergeStatus(nPortIndex);
 				}
-				m_State.nPriority = pData->FrameLayer.Priority;
-			} else if (pData->FrameLayer.Priority > m_State.nPriority) {
-				m_OutputPort[nPortIndex].sourceA.nIp = 0;
-				m_OutputPort[nPortIndex].sourceB.nIp = 0;
-				m_State.IsMergeMode = false;
-				m_State.nPriority = pData->FrameLayer.Priority;
-			}
-
-			if ((ipA == 0) && (ipB == 0)) {
-//				printf("1. First package from Source\n");
-				pSourceA->nIp = m_nIpAddressFrom;
-				pSourceA->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				memcpy(pSourceA->cid, pData->RootLayer.Cid, 16);
-				pSourceA->nMillis = m_nCurrentPacketMillis;
-				lightset::Data::SetSourceA(nPortIndex, pDmxData, nDmxSlots);
-			} else if (isSourceA && (ipB == 0)) {
-//				printf("2. Continue package from SourceA\n");
-				pSourceA->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				pSourceA->nMillis = m_nCurrentPacketMillis;
-				lightset::Data::SetSourceA(nPortIndex, pDmxData, nDmxSlots);
-			} else if ((ipA == 0) && isSourceB) {
-//				printf("3. Continue package from SourceB\n");
-				pSourceB->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				pSourceB->nMillis = m_nCurrentPacketMillis;
-				lightset::Data::SetSourceB(nPortIndex, pDmxData, nDmxSlots);
-			} else if (!isSourceA && (ipB == 0)) {
-//				printf("4. New ip, start merging\n");
-				pSourceB->nIp = m_nIpAddressFrom;
-				pSourceB->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				memcpy(pSourceB->cid, pData->RootLayer.Cid, 16);
-				pSourceB->nMillis = m_nCurrentPacketMillis;
-				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceB(nPortIndex, pDmxData, nDmxSlots, m_OutputPort[nPortIndex].mergeMode);
-			} else if ((ipA == 0) && !isSourceB) {
-//				printf("5. New ip, start merging\n");
-				pSourceA->nIp = m_nIpAddressFrom;
-				pSourceA->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				memcpy(pSourceA->cid, pData->RootLayer.Cid, 16);
-				pSourceA->nMillis = m_nCurrentPacketMillis;
-				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceA(nPortIndex, pDmxData, nDmxSlots, m_OutputPort[nPortIndex].mergeMode);
-			} else if (isSourceA && !isSourceB) {
-//				printf("6. Continue merging\n");
-				pSourceA->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				pSourceA->nMillis = m_nCurrentPacketMillis;
-				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceA(nPortIndex, pDmxData, nDmxSlots, m_OutputPort[nPortIndex].mergeMode);
-			} else if (!isSourceA && isSourceB) {
-//				printf("7. Continue merging\n");
-				pSourceB->nSequenceNumberData = pData->FrameLayer.SequenceNumber;
-				pSourceB->nMillis = m_nCurrentPacketMillis;
+				break;
+			case Result::NEW:
+			case Result::MERGE:
 				UpdateMergeStatus(nPortIndex);
-				lightset::Data::MergeSourceB(nPortIndex, pDmxData, nDmxSlots, m_OutputPort[nPortIndex].mergeMode);
-			}
-#ifndef NDEBUG
-			else if (isSourceA && isSourceB) {
-				puts("WARN: 8. Source matches both ip, discarding data");
-				return;
-			} else if (!isSourceA && !isSourceB) {
-				puts("WARN: 9. More than two sources, discarding data");
-				return;
-			}
-			else {
-				puts("ERROR: 0. No cases matched, this shouldn't happen!");
-				return;
+				break;
+			case Result::IGNORED:
+				continue;
+			case Result::DISCARD:
+				DEBUG_PUTS("More sources than lightset::source::MAX, discarding data");
+				continue;
+			default:
+				assert(0);
+				__builtin_unreachable();
+				break;
 			}
-#endif
+
+			const auto nSource = lightset::Data::FindSource(nPortIndex, id);
+			assert(nSource != lightset::source::NONE);
+
 			// This bit indicates whether to lock or revert to an unsynchronized state when synchronization is lost
 			// (See Section 11 on Universe Synchronization and 11.1 for discussion on synchronization states).
 			// When set to 0, components that had been operating in a synchronized state shall not update with any
@@ -553,11 +426,7 @@ void E131Bridge::HandleDmx() {
 				// Receivers shall ignore E1.31 Synchronization Packets containing a Synchronization Address of 0.
 				if (pData->FrameLayer.SynchronizationAddress != 0) {
 					if (!m_State.IsForcedSynchronized) {
-						if (!(isSourceA || isSourceB)) {
-							SetSynchronizationAddress((pSourceA->nIp != 0), (pSourceB->nIp != 0), __builtin_bswap16(pData->FrameLayer.SynchronizationAddress));
-						} else {
-							SetSynchronizationAddress(isSourceA, isSourceB, __builtin_bswap16(pData->FrameLayer.SynchronizationAddress));
-						}
+						SetSynchronizationAddress(nSource, __builtin_bswap16(pData->FrameLayer.SynchronizationAddress));
 						m_State.IsForcedSynchronized = true;
 						m_State.IsSynchronized = true;
 					}
@@ -586,27 +455,23 @@ void E131Bridge::HandleDmx() {
 	}
 }
 
-void E131Bridge::SetNetworkDataLossCondition(bool bSourceA, bool bSourceB) {
+void E131Bridge::SetNetworkDataLossCondition(const lightset::source::Id *pId) {
 	DEBUG_ENTRY
-	DEBUG_PRINTF("%d %d", bSourceA, bSourceB);
+	DEBUG_PRINTF("pId=%p", reinterpret_cast<const void *>(pId));
 
 	m_State.IsChanged = true;
 	auto doFailsafe = false;
 
-	if (bSourceA && bSourceB) {
+	if (pId == nullptr) {
 		m_State.IsNetworkDataLoss = true;
 		m_State.IsMergeMode = false;
 		m_State.IsSynchronized = false;
 		m_State.IsForcedSynchronized = false;
-		m_State.nPriority = e131::priority::LOWEST;
 
 		for (uint32_t i = 0; i < e131bridge::MAX_PORTS; i++) {
 			if (m_OutputPort[i].IsTransmitting) {
 				doFailsafe = true;
-				m_OutputPort[i].sourceA.nIp = 0;
-				memset(m_OutputPort[i].sourceA.cid, 0, e131::CID_LENGTH);
-				m_OutputPort[i].sourceB.nIp = 0;
-				memset(m_OutputPort[i].sourceB.cid, 0, e131::CID_LENGTH);
+				lightset::Data::ClearSources(i);
 				lightset::Data::ClearLength(i);
 				m_OutputPort[i].IsTransmitting = false;
 				m_OutputPort[i].IsMerging = false;
@@ -614,24 +479,16 @@ void E131Bridge::SetNetworkDataLossCondition(bool bSourceA, bool bSourceB) {
 		}
 	} else {
 		for (uint32_t i = 0; i < e131bridge::MAX_PORTS; i++) {
-			if (m_OutputPort[i].IsTransmitting) {
-				if ((bSourceA) && (m_OutputPort[i].sourceA.nIp != 0)) {
-					m_OutputPort[i].sourceA.nIp = 0;
-					memset(m_OutputPort[i].sourceA.cid, 0, e131::CID_LENGTH);
-					m_OutputPort[i].IsMerging = false;
-				}
-
-				if ((bSourceB) && (m_OutputPort[i].sourceB.nIp != 0)) {
-					m_OutputPort[i].sourceB.nIp = 0;
-					memset(m_OutputPort[i].sourceB.cid, 0, e131::CID_LENGTH);
-					m_OutputPort[i].IsMerging = false;
-				}
-
-				if (!m_State.IsMergeMode) {
+			if (m_OutputPort[i].IsTransmitting && lightset::Data::RemoveSource(i, *pId)) {
+				if (lightset::Data::GetSourceCount(i) == 0) {
 					doFailsafe = true;
 					lightset::Data::ClearLength(i);
 					m_OutputPort[i].IsTransmitting = false;
 				}
+
+				if (m_OutputPort[i].IsMerging && !lightset::Data::IsMerging(i)) {
+					ClearMergeStatus(i);
+				}
 			}
 		}
 	}
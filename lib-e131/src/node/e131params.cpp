@@ -40,6 +40,7 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertiesschema.h"
 
 #include "propertiesbuilder.h"
 
@@ -66,6 +67,183 @@ static constexpr uint16_t portdir_clear(const uint32_t i) {
 }
 }  // namespace e131params
 
+namespace {
+using namespace e131params;
+using namespace properties::schema;
+
+void set_mask(Params *pParams, const uint32_t nMask, const bool bSet) {
+	if (bSet) {
+		pParams->nSetList |= nMask;
+	} else {
+		pParams->nSetList &= ~nMask;
+	}
+}
+
+void failsafe(void *p, const char *pValue, [[maybe_unused]] const uint32_t nIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[9];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		const auto failsafe = lightset::get_failsafe(aValue);
+		set_mask(pParams, Mask::FAILSAFE, failsafe != lightset::FailSafe::HOLD);
+		pParams->nFailSafe = static_cast<uint8_t>(failsafe);
+	}
+}
+
+void universe(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint16_t nValue16;
+
+	if (Sscan::Uint16(pValue, nValue16) != Sscan::OK) {
+		return;
+	}
+
+	if ((nValue16 == 0) || (nValue16 > e131::universe::MAX)) {
+		pParams->nUniverse[nPortIndex] = static_cast<uint16_t>(nPortIndex + 1);
+		pParams->nSetList &= ~(Mask::UNIVERSE_A << nPortIndex);
+	} else {
+		pParams->nUniverse[nPortIndex] = nValue16;
+		pParams->nSetList |= (Mask::UNIVERSE_A << nPortIndex);
+	}
+}
+
+void merge_mode(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[4];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		pParams->nMergeMode &= mergemode_clear(nPortIndex);
+		pParams->nMergeMode |= mergemode_set(nPortIndex, lightset::get_merge_mode(aValue));
+	}
+}
+
+void label(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	auto *pLabel = reinterpret_cast<char *>(pParams->aLabel[nPortIndex]);
+	uint32_t nLength = lightset::node::LABEL_NAME_LENGTH - 1;
+
+	if (Sscan::Char(pValue, pLabel, nLength) == Sscan::OK) {
+		pLabel[nLength] = '\0';
+		char aDefault[lightset::node::LABEL_NAME_LENGTH];
+		lightset::node::get_short_name_default(nPortIndex, aDefault);
+		set_mask(pParams, Mask::LABEL_A << nPortIndex, strcmp(pLabel, aDefault) != 0);
+	}
+}
+
+void direction(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[8];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) != Sscan::OK) {
+		return;
+	}
+
+	aValue[nLength] = '\0';
+	const auto portDir = lightset::get_direction(aValue);
+
+	pParams->nDirection &= portdir_clear(nPortIndex);
+
+#if defined (E131_HAVE_DMXIN)
+	if (portDir == lightset::PortDir::INPUT) {
+		pParams->nDirection |= portdir_shift_left(lightset::PortDir::INPUT, nPortIndex);
+	} else
+#endif
+	if (portDir == lightset::PortDir::DISABLE) {
+		pParams->nDirection |= portdir_shift_left(lightset::PortDir::DISABLE, nPortIndex);
+	} else {
+		pParams->nDirection |= portdir_shift_left(lightset::PortDir::OUTPUT, nPortIndex);
+	}
+
+	DEBUG_PRINTF("%u portDir=%u, nDirection=%x", nPortIndex, static_cast<uint32_t>(portDir), pParams->nDirection);
+}
+
+#if defined (E131_HAVE_DMXIN)
+void priority(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	uint8_t nValue8;
+
+	if (Sscan::Uint8(pValue, nValue8) != Sscan::OK) {
+		return;
+	}
+
+	if ((nValue8 >= e131::priority::LOWEST) && (nValue8 <= e131::priority::HIGHEST) && (nValue8 != e131::priority::DEFAULT)) {
+		pParams->nPriority[nPortIndex] = nValue8;
+		pParams->nSetList |= (Mask::PRIORITY_A << nPortIndex);
+	} else {
+		pParams->nPriority[nPortIndex] = e131::priority::DEFAULT;
+		pParams->nSetList &= ~(Mask::PRIORITY_A << nPortIndex);
+	}
+}
+#endif
+
+#if defined (OUTPUT_HAVE_STYLESWITCH)
+void output_style(void *p, const char *pValue, const uint32_t nPortIndex) {
+	auto *pParams = static_cast<Params *>(p);
+	char aValue[7];
+	uint32_t nLength = sizeof(aValue) - 1;
+
+	if (Sscan::Char(pValue, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+		if (static_cast<uint32_t>(lightset::get_output_style(aValue)) != 0) {
+			pParams->nOutputStyle |= static_cast<uint8_t>(1U << nPortIndex);
+		} else {
+			pParams->nOutputStyle &= static_cast<uint8_t>(~(1U << nPortIndex));
+		}
+	}
+}
+#endif
+
+void disable_merge_timeout(void *p, const char *pValue, [[maybe_unused]] const uint32_t nIndex) {
+	uint8_t nValue8;
+
+	if (Sscan::Uint8(pValue, nValue8) == Sscan::OK) {
+		set_mask(static_cast<Params *>(p), Mask::DISABLE_MERGE_TIMEOUT, nValue8 != 0);
+	}
+}
+
+constexpr Key s_Keys[] = {
+	Custom(LightSetParamsConst::FAILSAFE, failsafe),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[0], universe, 0),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[1], universe, 1),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[2], universe, 2),
+	Custom(LightSetParamsConst::UNIVERSE_PORT[3], universe, 3),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[0], merge_mode, 0),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[1], merge_mode, 1),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[2], merge_mode, 2),
+	Custom(LightSetParamsConst::MERGE_MODE_PORT[3], merge_mode, 3),
+	Custom(LightSetParamsConst::NODE_LABEL[0], label, 0),
+	Custom(LightSetParamsConst::NODE_LABEL[1], label, 1),
+	Custom(LightSetParamsConst::NODE_LABEL[2], label, 2),
+	Custom(LightSetParamsConst::NODE_LABEL[3], label, 3),
+	Custom(LightSetParamsConst::DIRECTION[0], direction, 0),
+	Custom(LightSetParamsConst::DIRECTION[1], direction, 1),
+	Custom(LightSetParamsConst::DIRECTION[2], direction, 2),
+	Custom(LightSetParamsConst::DIRECTION[3], direction, 3),
+#if defined (E131_HAVE_DMXIN)
+	Custom(E131ParamsConst::PRIORITY[0], priority, 0),
+	Custom(E131ParamsConst::PRIORITY[1], priority, 1),
+	Custom(E131ParamsConst::PRIORITY[2], priority, 2),
+	Custom(E131ParamsConst::PRIORITY[3], priority, 3),
+#endif
+#if defined (OUTPUT_HAVE_STYLESWITCH)
+	Custom(LightSetParamsConst::OUTPUT_STYLE[0], output_style, 0),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[1], output_style, 1),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[2], output_style, 2),
+	Custom(LightSetParamsConst::OUTPUT_STYLE[3], output_style, 3),
+#endif
+	Custom(LightSetParamsConst::DISABLE_MERGE_TIMEOUT, disable_merge_timeout),
+};
+
+static_assert(e131params::MAX_PORTS == 4, "s_Keys has 4 entries per port key");
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 using namespace e131params;
 
 E131Params::E131Params() {
@@ -133,122 +311,7 @@ void E131Params::Load(const char* pBuffer, uint32_t nLength) {
 void E131Params::callbackFunction(const char *pLine) {
 	assert(pLine != nullptr);
 
-	uint8_t value8;
-	uint16_t value16;
-	char aValue[lightset::node::LABEL_NAME_LENGTH];
-
-	uint32_t nLength = 8;
-
-	if (Sscan::Char(pLine, LightSetParamsConst::FAILSAFE, aValue, nLength) == Sscan::OK) {
-		const auto failsafe = lightset::get_failsafe(aValue);
-
-		if (failsafe == lightset::FailSafe::HOLD) {
-			m_Params.nSetList &= ~Mask::FAILSAFE;
-		} else {
-			m_Params.nSetList |= Mask::FAILSAFE;
-		}
-
-		m_Params.nFailSafe = static_cast<uint8_t>(failsafe);
-		return;
-	}
-
-	for (uint32_t nPortIndex = 0; nPortIndex < e131params::MAX_PORTS; nPortIndex++) {
-		if (Sscan::Uint16(pLine, LightSetParamsConst::UNIVERSE_PORT[nPortIndex], value16) == Sscan::OK) {
-			if ((value16 == 0) || (value16 > e131::universe::MAX)) {
-				m_Params.nUniverse[nPortIndex] = static_cast<uint16_t>(nPortIndex + 1);
-				m_Params.nSetList &= ~(Mask::UNIVERSE_A << nPortIndex);
-			} else {
-				m_Params.nUniverse[nPortIndex] = value16;
-				m_Params.nSetList |= (Mask::UNIVERSE_A << nPortIndex);
-			}
-			return;
-		}
-
-		nLength = 3;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::MERGE_MODE_PORT[nPortIndex], aValue, nLength) == Sscan::OK) {
-			m_Params.nMergeMode &= e131params::mergemode_clear(nPortIndex);
-			m_Params.nMergeMode |= mergemode_set(nPortIndex, lightset::get_merge_mode(aValue));
-			return;
-		}
-
-		nLength = lightset::node::LABEL_NAME_LENGTH - 1;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::NODE_LABEL[nPortIndex], reinterpret_cast<char*>(m_Params.aLabel[nPortIndex]), nLength) == Sscan::OK) {
-			m_Params.aLabel[nPortIndex][nLength] = '\0';
-			static_assert(sizeof(aValue) >= lightset::node::LABEL_NAME_LENGTH, "");
-			lightset::node::get_short_name_default(nPortIndex, aValue);
-
-			if (strcmp(reinterpret_cast<char*>(m_Params.aLabel[nPortIndex]), aValue) == 0) {
-				m_Params.nSetList &= ~(Mask::LABEL_A << nPortIndex);
-			} else {
-				m_Params.nSetList |= (Mask::LABEL_A << nPortIndex);
-			}
-			return;
-		}
-
-		nLength = 7;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::DIRECTION[nPortIndex], aValue, nLength) == Sscan::OK) {
-			const auto portDir = lightset::get_direction(aValue);
-			m_Params.nDirection &= e131params::portdir_clear(nPortIndex);
-
-			DEBUG_PRINTF("%u portDir=%u, m_Params.nDirection=%x", nPortIndex, static_cast<uint32_t>(portDir), m_Params.nDirection);
-
-#if defined (E131_HAVE_DMXIN)
-			if (portDir == lightset::PortDir::INPUT) {
-				m_Params.nDirection |= e131params::portdir_shift_left(lightset::PortDir::INPUT, nPortIndex);
-			} else
-#endif
-			if (portDir == lightset::PortDir::DISABLE) {
-				m_Params.nDirection |= e131params::portdir_shift_left(lightset::PortDir::DISABLE, nPortIndex);
-			} else {
-				m_Params.nDirection |= e131params::portdir_shift_left(lightset::PortDir::OUTPUT, nPortIndex);
-			}
-
-			DEBUG_PRINTF("m_Params.nDirection=%x", m_Params.nDirection);
-
-			return;
-		}
-
-#if defined (E131_HAVE_DMXIN)
-		if (Sscan::Uint8(pLine, E131ParamsConst::PRIORITY[nPortIndex], value8) == Sscan::OK) {
-			if ((value8 >= e131::priority::LOWEST) && (value8 <= e131::priority::HIGHEST) && (value8 != e131::priority::DEFAULT)) {
-				m_Params.nPriority[nPortIndex] = value8;
-				m_Params.nSetList |= (Mask::PRIORITY_A << nPortIndex);
-			} else {
-				m_Params.nPriority[nPortIndex] = e131::priority::DEFAULT;
-				m_Params.nSetList &= ~(Mask::PRIORITY_A << nPortIndex);
-			}
-			return;
-		}
-#endif
-
-#if defined (OUTPUT_HAVE_STYLESWITCH)
-		nLength = 6;
-
-		if (Sscan::Char(pLine, LightSetParamsConst::OUTPUT_STYLE[nPortIndex], aValue, nLength) == Sscan::OK) {
-			const auto nOutputStyle = static_cast<uint32_t>(lightset::get_output_style(aValue));
-
-			if (nOutputStyle != 0) {
-				m_Params.nOutputStyle |= static_cast<uint8_t>(1U << nPortIndex);
-			} else {
-				m_Params.nOutputStyle &= static_cast<uint8_t>(~(1U << nPortIndex));
-			}
-
-			return;
-		}
-#endif
-	}
-
-	if (Sscan::Uint8(pLine, LightSetParamsConst::DISABLE_MERGE_TIMEOUT, value8) == Sscan::OK) {
-		if (value8 != 0) {
-			m_Params.nSetList |= Mask::DISABLE_MERGE_TIMEOUT;
-		} else {
-			m_Params.nSetList &= ~Mask::DISABLE_MERGE_TIMEOUT;
-		}
-		return;
-	}
+	s_Schema.Parse(pLine, &m_Params);
 }
 
 void E131Params::Builder(const struct Params *pParams, char *pBuffer, uint32_t nLength, uint32_t& nSize) {
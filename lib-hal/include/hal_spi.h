@@ -44,12 +44,14 @@
 
 #ifdef __cplusplus
 # include <cstdint>
+# include "hal_spibus.h"
 
 class HAL_SPI {
 	void Setup() {
 		FUNC_PREFIX(spi_chipSelect(m_nChipSelect));
 		FUNC_PREFIX(spi_setDataMode	(m_nMode));
 		FUNC_PREFIX(spi_set_speed_hz(m_nSpeedHz));
+		hal::spi::Bus::Get().Invalidate();
 	}
 public:
 	HAL_SPI(uint8_t nChipSelect, uint32_t nSpeedHz, uint8_t nMode = 0) :
@@ -0,0 +1,162 @@
+/**
+ * @file hal_spibus.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef HAL_SPIBUS_H_
+#define HAL_SPIBUS_H_
+
+#include <cstdint>
+
+namespace hal {
+namespace spi {
+#if !defined (CONFIG_HAL_SPI_BUS_DEVICES)
+# define CONFIG_HAL_SPI_BUS_DEVICES 4
+#endif
+static constexpr uint32_t DEVICES_MAX = CONFIG_HAL_SPI_BUS_DEVICES;
+
+struct Stats {
+	uint32_t nTransfers;
+	uint32_t nBytes;
+	uint32_t nSetups;		///< Clock/mode/chip select reconfigurations for this device
+	uint32_t nCoalesced;	///< Queued writes replaced by a newer one before reaching the bus
+	uint64_t nMicros;		///< Bus time
+};
+
+/**
+ * All devices on the SPI peripheral go through the Bus. Clock, mode and
+ * chip select are only programmed when the device changes.
+ *
+ * Queue() is for frame based devices (LED drivers): the latest frame wins.
+ * With CONFIG_HAL_SPI_BUS_QUEUE the write is deferred until Flush(), which the
+ * main loop calls, otherwise it is written immediately.
+ *
+ * Code driving the peripheral directly must call Invalidate() afterwards.
+ */
+class Bus {
+public:
+	static Bus& Get() {
+		static Bus instance;
+		return instance;
+	}
+
+	/**
+	 * @return device handle or -1
+	 */
+	int32_t Register(const char *pName, const uint8_t nChipSelect, const uint32_t nSpeedHz, const uint8_t nMode);
+
+	/**
+	 * A queued write is done first. The handle can be reused by the next Register().
+	 */
+	void Unregister(const int32_t nDevice);
+
+	/**
+	 * Transfer(), Write() and Queue() ignore an invalid handle (a failed Register()).
+	 * Full duplex, pData is overwritten with the received bytes.
+	 */
+	void Transfer(const int32_t nDevice, char *pData, const uint32_t nLength);
+	void Write(const int32_t nDevice, const char *pData, const uint32_t nLength);
+
+	/**
+	 * pData must stay valid until the write has been done.
+	 */
+	void Queue(const int32_t nDevice, const char *pData, const uint32_t nLength) {
+#if defined (CONFIG_HAL_SPI_BUS_QUEUE)
+		if (__builtin_expect((!IsRegistered(nDevice)), 0)) {
+			return;
+		}
+
+		auto& device = m_Devices[nDevice];
+
+		if (device.pQueued != nullptr) {
+			device.stats.nCoalesced++;
+		}
+
+		device.pQueued = pData;
+		device.nQueuedLength = nLength;
+		m_bQueued = true;
+#else
+		Write(nDevice, pData, nLength);
+#endif
+	}
+
+	void Flush() {
+#if defined (CONFIG_HAL_SPI_BUS_QUEUE)
+		if (m_bQueued) {
+			FlushQueue();
+		}
+#endif
+	}
+
+	void Invalidate() {
+		m_nSelected = -1;
+	}
+
+	/**
+	 * @return the number of handles, including the ones which are unregistered
+	 */
+	uint32_t GetDevices() const {
+		return m_nDevices;
+	}
+
+	bool IsRegistered(const int32_t nDevice) const {
+		return (static_cast<uint32_t>(nDevice) < m_nDevices) && (m_Devices[nDevice].pName != nullptr);
+	}
+
+	const char *GetName(const int32_t nDevice) const {
+		return m_Devices[nDevice].pName;
+	}
+
+	const Stats& GetStats(const int32_t nDevice) const {
+		return m_Devices[nDevice].stats;
+	}
+
+	void Print();
+
+private:
+	Bus() = default;
+
+	void Select(const int32_t nDevice);
+	void WriteQueued(const int32_t nDevice);
+	void FlushQueue();
+
+private:
+	struct Device {
+		const char *pName;
+		const char *pQueued;
+		uint32_t nQueuedLength;
+		uint32_t nSpeedHz;
+		uint8_t nChipSelect;
+		uint8_t nMode;
+		Stats stats;
+	};
+
+	Device m_Devices[DEVICES_MAX];
+	uint32_t m_nDevices { 0 };
+	int32_t m_nSelected { -1 };
+	bool m_bQueued { false };
+};
+}  // namespace spi
+}  // namespace hal
+
+#endif /* HAL_SPIBUS_H_ */
@@ -0,0 +1,71 @@
+/**
+ * @file json_get_spibus.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "hal_spibus.h"
+
+namespace remoteconfig {
+/**
+ * /json/spibus
+ * Per device usage of the SPI bus.
+ */
+uint32_t json_get_spibus(char *pOutBuffer, const uint32_t nOutBufferSize) {
+	auto& bus = hal::spi::Bus::Get();
+
+	pOutBuffer[0] = '[';
+	uint32_t nLength = 1;
+
+	for (int32_t nDevice = 0; (static_cast<uint32_t>(nDevice) < bus.GetDevices()) && (nLength < nOutBufferSize); nDevice++) {
+		if (!bus.IsRegistered(nDevice)) {
+			continue;
+		}
+
+		const auto& stats = bus.GetStats(nDevice);
+
+		nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength,
+				"{\"device\":\"%s\",\"transfers\":%u,\"bytes\":%u,\"setups\":%u,\"coalesced\":%u,\"bus_us\":%llu},",
+				bus.GetName(nDevice),
+				static_cast<unsigned int>(stats.nTransfers),
+				static_cast<unsigned int>(stats.nBytes),
+				static_cast<unsigned int>(stats.nSetups),
+				static_cast<unsigned int>(stats.nCoalesced),
+				static_cast<unsigned long long>(stats.nMicros)));
+	}
+
+	if (nLength >= nOutBufferSize) {
+		return nOutBufferSize;
+	}
+
+	if (nLength == 1) {
+		nLength++;
+	}
+
+	pOutBuffer[nLength - 1] = ']';
+
+	return nLength;
+}
+}  // namespace remoteconfig
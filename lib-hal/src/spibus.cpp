@@ -0,0 +1,195 @@
+/**
+ * @file spibus.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+#include "hal_spibus.h"
+#include "hal_spi.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+namespace hal {
+namespace spi {
+int32_t Bus::Register(const char *pName, const uint8_t nChipSelect, const uint32_t nSpeedHz, const uint8_t nMode) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("%s: nChipSelect=%u, nSpeedHz=%u, nMode=%u", pName, nChipSelect, nSpeedHz, nMode);
+
+	uint32_t nDevice = 0;
+
+	// Reuse the handle of an unregistered device
+	while ((nDevice < m_nDevices) && (m_Devices[nDevice].pName != nullptr)) {
+		nDevice++;
+	}
+
+	if (nDevice >= DEVICES_MAX) {
+		printf("SPI bus: %s not registered\n", pName);
+		DEBUG_EXIT
+		return -1;
+	}
+
+	auto& device = m_Devices[nDevice];
+	memset(&device, 0, sizeof(Device));
+
+	device.pName = pName;
+	device.nSpeedHz = nSpeedHz;
+	device.nChipSelect = nChipSelect;
+	device.nMode = nMode;
+
+	if (nDevice == m_nDevices) {
+		m_nDevices++;
+	}
+
+	DEBUG_EXIT
+	return static_cast<int32_t>(nDevice);
+}
+
+void Bus::Unregister(const int32_t nDevice) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nDevice=%d", nDevice);
+
+	if (!IsRegistered(nDevice)) {
+		DEBUG_EXIT
+		return;
+	}
+
+	WriteQueued(nDevice);
+
+	if (m_nSelected == nDevice) {
+		m_nSelected = -1;
+	}
+
+	m_Devices[nDevice].pName = nullptr;
+
+	DEBUG_EXIT
+}
+
+void Bus::Select(const int32_t nDevice) {
+	assert(static_cast<uint32_t>(nDevice) < m_nDevices);
+
+	if (nDevice == m_nSelected) {
+		return;
+	}
+
+	auto& device = m_Devices[nDevice];
+
+	FUNC_PREFIX(spi_chipSelect(device.nChipSelect));
+	FUNC_PREFIX(spi_set_speed_hz(device.nSpeedHz));
+	FUNC_PREFIX(spi_setDataMode(device.nMode));
+
+	device.stats.nSetups++;
+	m_nSelected = nDevice;
+}
+
+void Bus::Transfer(const int32_t nDevice, char *pData, const uint32_t nLength) {
+	if (__builtin_expect((!IsRegistered(nDevice)), 0)) {
+		return;
+	}
+
+	WriteQueued(nDevice);
+	Select(nDevice);
+
+	const auto nMicros = Hardware::Get()->Micros();
+
+	FUNC_PREFIX(spi_transfern(pData, nLength));
+
+	auto& stats = m_Devices[nDevice].stats;
+	stats.nMicros += (Hardware::Get()->Micros() - nMicros);
+	stats.nTransfers++;
+	stats.nBytes += nLength;
+}
+
+void Bus::Write(const int32_t nDevice, const char *pData, const uint32_t nLength) {
+	if (__builtin_expect((!IsRegistered(nDevice)), 0)) {
+		return;
+	}
+
+	WriteQueued(nDevice);
+	Select(nDevice);
+
+	const auto nMicros = Hardware::Get()->Micros();
+
+	FUNC_PREFIX(spi_writenb(pData, nLength));
+
+	auto& stats = m_Devices[nDevice].stats;
+	stats.nMicros += (Hardware::Get()->Micros() - nMicros);
+	stats.nTransfers++;
+	stats.nBytes += nLength;
+}
+
+void Bus::WriteQueued(const int32_t nDevice) {
+	auto& device = m_Devices[nDevice];
+
+	if (device.pQueued == nullptr) {
+		return;
+	}
+
+	const auto *pData = device.pQueued;
+	device.pQueued = nullptr;
+
+	Write(nDevice, pData, device.nQueuedLength);
+}
+
+void Bus::FlushQueue() {
+	m_bQueued = false;
+
+	// The selected device first, it does not need a setup
+	if (m_nSelected >= 0) {
+		WriteQueued(m_nSelected);
+	}
+
+	for (uint32_t i = 0; i < m_nDevices; i++) {
+		WriteQueued(static_cast<int32_t>(i));
+	}
+}
+
+void Bus::Print() {
+	puts("SPI bus");
+
+	for (uint32_t i = 0; i < m_nDevices; i++) {
+		const auto& device = m_Devices[i];
+
+		if (device.pName == nullptr) {
+			continue;
+		}
+
+		printf(" %-8s CS%u %u Hz mode %u: transfers=%u, bytes=%u, setups=%u, coalesced=%u, %u us\n",
+				device.pName,
+				static_cast<unsigned int>(device.nChipSelect),
+				static_cast<unsigned int>(device.nSpeedHz),
+				static_cast<unsigned int>(device.nMode),
+				static_cast<unsigned int>(device.stats.nTransfers),
+				static_cast<unsigned int>(device.stats.nBytes),
+				static_cast<unsigned int>(device.stats.nSetups),
+				static_cast<unsigned int>(device.stats.nCoalesced),
+				static_cast<unsigned int>(device.stats.nMicros));
+	}
+}
+}  // namespace spi
+}  // namespace hal
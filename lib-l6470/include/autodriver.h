@@ -33,6 +33,12 @@
 
 #include "l6470.h"
 
+namespace autodriver {
+static constexpr uint32_t CHIP_SELECTS = 2;
+static constexpr uint32_t MAX_BOARDS = 8;		///< Per chip select
+static constexpr uint32_t MAX_FRAMES = 16;		///< Bytes per board queued in a chain transaction
+}  // namespace autodriver
+
 class AutoDriver final: public L6470 {
 public:
 	AutoDriver(uint8_t, uint8_t, uint8_t, uint8_t);
@@ -46,6 +52,8 @@ public:
 
 private:
 	uint8_t SPIXfer(uint8_t) override;
+	void SPIReadBegin() override;
+	void SPIReadEnd() override;
 
 	/*
 	 * Additional methods
@@ -64,14 +72,43 @@ public:
 	static uint16_t getNumBoards();
 	static uint8_t getNumBoards(uint8_t cs);
 
+	/**
+	 * Chain transaction: the command bytes for the boards in a daisy chain
+	 * are packed into shared frames (one byte per board) and sent in a single
+	 * burst with ChainEnd. Reads are done synchronously after flushing the chain.
+	 */
+	static void ChainBegin();
+	static void ChainEnd();
+
+	/**
+	 * Refreshes the register shadow of ABS_POS, SPEED and STATUS for all boards.
+	 * The GET_PARAM commands for all boards in a daisy chain share the frames.
+	 * Must not be called within a chain transaction.
+	 */
+	static void ShadowPoll();
+
+private:
+	static void ChainFlush(const uint8_t nSpiChipSelect);
+
+	struct Chain {
+		char aFrames[autodriver::MAX_FRAMES][autodriver::MAX_BOARDS];
+		uint8_t nBytes[autodriver::MAX_BOARDS];
+		uint8_t nFrames;
+		bool bIsActive;
+	};
+
+	static Chain s_Chain[autodriver::CHIP_SELECTS];
+	static AutoDriver *s_pBoards[autodriver::CHIP_SELECTS][autodriver::MAX_BOARDS];
+
 private:
 	uint8_t m_nSpiChipSelect;
 	uint8_t m_nResetPin;
 	uint8_t m_nBusyPin;
 	uint8_t m_nPosition;
 	bool m_bIsBusy;
+	bool m_bIsReading { false };
 
-	static uint8_t m_nNumBoards[2];
+	static uint8_t m_nNumBoards[autodriver::CHIP_SELECTS];
 };
 
 #endif /* AUTODRIVER_H_ */
@@ -90,6 +90,22 @@ enum TL6470ParamRegisters {
 	L6470_PARAM_STATUS = 0x19		///< len=16
 };
 
+namespace l6470 {
+namespace shadow {
+static constexpr uint32_t REGISTERS = L6470_PARAM_STATUS + 1;
+/**
+ * Registers changed by the device itself
+ */
+static constexpr uint32_t VOLATILE_MASK = (1U << L6470_PARAM_ABS_POS) | (1U << L6470_PARAM_EL_POS) | (1U << L6470_PARAM_MARK)
+										| (1U << L6470_PARAM_SPEED) | (1U << L6470_PARAM_ADC_OUT) | (1U << L6470_PARAM_STATUS);
+/**
+ * Registers changed by any motion command.
+ * ABS_POS is included, a position read straight after a move or stop must come from the device.
+ */
+static constexpr uint32_t MOTION_MASK = (1U << L6470_PARAM_ABS_POS) | (1U << L6470_PARAM_SPEED) | (1U << L6470_PARAM_STATUS);
+}  // namespace shadow
+}  // namespace l6470
+
 class L6470 {
 
 public:
@@ -154,6 +170,7 @@ public:
 	long getPos();
 	long getMark();
 	void run(TL6470Direction, float);
+	void runRaw(TL6470Direction, uint32_t);
 	void stepClock(TL6470Direction);
 	void move(TL6470Direction, unsigned long);
 	void goTo(long pos);
@@ -183,6 +200,15 @@ public:
 		run(static_cast<TL6470Direction>(dir), stepsPerSec);
 	}
 
+	/**
+	 * The SPEED register value for runRaw, so it can be computed once
+	 * 250 ns tick : multiply steps/s by 67.106, 20-bit value
+	 */
+	static uint32_t runSpeedCalc(float stepsPerSec) {
+		const auto nSpeed = static_cast<uint32_t>(stepsPerSec * 67.106f);
+		return nSpeed > 0xFFFFF ? 0xFFFFF : nSpeed;
+	}
+
 	void goUntilPress(int action, int dir, float stepsPerSec) {
 		goUntil(static_cast<TL6470Action>(action), static_cast<TL6470Direction>(dir), stepsPerSec);
 	}
@@ -196,8 +222,37 @@ public:
 
 	void Dump();
 
+	/*
+	 * Register shadow
+	 * Written and read configuration registers are always served from memory.
+	 * The volatile registers are served from memory when not older than nMaxAgeMillis,
+	 * 0 (default) reads these registers always from the device.
+	 */
+	void SetShadowMaxAge(const uint32_t nMaxAgeMillis) {
+		m_nShadowMaxAgeMillis = nMaxAgeMillis;
+	}
+
+	uint32_t GetShadowMaxAge() const {
+		return m_nShadowMaxAgeMillis;
+	}
+
+	void ShadowSet(const TL6470ParamRegisters param, const unsigned long nValue);
+
+	void ShadowInvalidate(const uint32_t nMask = l6470::shadow::VOLATILE_MASK) {
+		m_nShadowValid &= ~nMask;
+	}
+
+private:
+	bool ShadowGet(const TL6470ParamRegisters param, long& nValue);
+
 private:
 	virtual uint8_t SPIXfer(uint8_t)=0;
+	/*
+	 * A read needs the response of the device, so an implementation
+	 * which defers transfers must do these synchronously.
+	 */
+	virtual void SPIReadBegin() {}
+	virtual void SPIReadEnd() {}
 
 private:
 	long paramHandler(uint8_t, unsigned long);
@@ -221,6 +276,12 @@ private:
 
 protected:
 	unsigned m_nMotorNumber;	///< Just for administration purposes
+
+private:
+	uint32_t m_nShadow[l6470::shadow::REGISTERS];
+	uint32_t m_nShadowMillis[l6470::shadow::REGISTERS];
+	uint32_t m_nShadowValid { 0 };
+	uint32_t m_nShadowMaxAgeMillis { 0 };
 };
 
 #endif /* L6470_H_ */
@@ -5,7 +5,7 @@
 /*
  * Based on https://github.com/sparkfun/L6470-AutoDriver/tree/master/Libraries/Arduino
  */
-/* Copyright (C) 2017-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,9 +27,11 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #include "hal_spi.h"
+#include "hal_spibus.h"
 #include "hal_gpio.h"
 
 #include "autodriver.h"
@@ -40,7 +42,22 @@
 
 static constexpr uint8_t BUSY_PIN_NOT_USED = 0xFF;
 
-uint8_t AutoDriver::m_nNumBoards[2];
+uint8_t AutoDriver::m_nNumBoards[autodriver::CHIP_SELECTS];
+AutoDriver::Chain AutoDriver::s_Chain[autodriver::CHIP_SELECTS];
+AutoDriver *AutoDriver::s_pBoards[autodriver::CHIP_SELECTS][autodriver::MAX_BOARDS];
+
+static int32_t s_nSpiDevice[autodriver::CHIP_SELECTS] = { -1, -1 };
+
+static void spi_register(const uint8_t nSpiChipSelect) {
+	if (s_nSpiDevice[nSpiChipSelect] < 0) {
+		s_nSpiDevice[nSpiChipSelect] = hal::spi::Bus::Get().Register("L6470", nSpiChipSelect, 2000000, SPI_MODE3);
+		assert(s_nSpiDevice[nSpiChipSelect] >= 0);
+	}
+}
+
+static void spi_transfer(const uint8_t nSpiChipSelect, char *pData, const uint32_t nLength) {
+	hal::spi::Bus::Get().Transfer(s_nSpiDevice[nSpiChipSelect], pData, nLength);
+}
 
 AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin, uint8_t nBusyPin) :
 	m_nSpiChipSelect(nSpiChipSelect),
@@ -51,8 +68,13 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 {
 	DEBUG_ENTRY
 	DEBUG_PRINTF("nPosition=%d, nSpiChipSelect=%d\n", static_cast<int>(nPosition), static_cast<int>(nSpiChipSelect));
+	assert(nPosition < autodriver::MAX_BOARDS);
+	assert(nSpiChipSelect < autodriver::CHIP_SELECTS);
 
 	m_nNumBoards[nSpiChipSelect]++;
+	s_pBoards[nSpiChipSelect][nPosition] = this;
+
+	spi_register(nSpiChipSelect);
 
 	DEBUG_PRINTF("m_nNumBoards[%d]=%d", static_cast<int>(nSpiChipSelect), static_cast<int>(m_nNumBoards[nSpiChipSelect]));
 	DEBUG_EXIT
@@ -67,8 +89,13 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 {
 	DEBUG_ENTRY
 	DEBUG_PRINTF("nPosition=%d, nSpiChipSelect=%d\n", static_cast<int>(nPosition), static_cast<int>(nSpiChipSelect));
+	assert(nPosition < autodriver::MAX_BOARDS);
+	assert(nSpiChipSelect < autodriver::CHIP_SELECTS);
 
 	m_nNumBoards[nSpiChipSelect]++;
+	s_pBoards[nSpiChipSelect][nPosition] = this;
+
+	spi_register(nSpiChipSelect);
 
 	DEBUG_PRINTF("m_nNumBoards[%d]=%d", static_cast<int>(nSpiChipSelect), static_cast<int>(m_nNumBoards[nSpiChipSelect]));
 	DEBUG_EXIT
@@ -78,6 +105,7 @@ AutoDriver::~AutoDriver() {
 	hardHiZ();
 	m_bIsBusy = false;
 	m_nNumBoards[m_nSpiChipSelect]--;
+	s_pBoards[m_nSpiChipSelect][m_nPosition] = nullptr;
 }
 
 int AutoDriver::busyCheck() {
@@ -113,6 +141,33 @@ int AutoDriver::busyCheck() {
 uint8_t AutoDriver::SPIXfer(uint8_t data) {
 	DEBUG_ENTRY
 
+	auto& chain = s_Chain[m_nSpiChipSelect];
+
+	if (!m_bIsReading) {
+		ShadowInvalidate(l6470::shadow::MOTION_MASK);
+	}
+
+	if (chain.bIsActive && !m_bIsReading) {
+		/*
+		 * The commands for a board are always complete before the next board is addressed.
+		 * So when this board runs out of frames, all other boards are at a command boundary
+		 * and the NOP padding of the flush is safe.
+		 */
+		if (chain.nBytes[m_nPosition] == autodriver::MAX_FRAMES) {
+			ChainFlush(m_nSpiChipSelect);
+		}
+
+		chain.aFrames[chain.nBytes[m_nPosition]][m_nPosition] = static_cast<char>(data);
+		chain.nBytes[m_nPosition]++;
+
+		if (chain.nBytes[m_nPosition] > chain.nFrames) {
+			chain.nFrames = chain.nBytes[m_nPosition];
+		}
+
+		DEBUG_EXIT
+		return 0;
+	}
+
 	char dataPacket[m_nNumBoards[m_nSpiChipSelect]];
 
 	for (uint32_t i = 0; i < m_nNumBoards[m_nSpiChipSelect]; i++) {
@@ -121,10 +176,7 @@ uint8_t AutoDriver::SPIXfer(uint8_t data) {
 
 	dataPacket[m_nPosition] = static_cast<char>(data);
 
-	FUNC_PREFIX(spi_chipSelect(m_nSpiChipSelect));
-	FUNC_PREFIX(spi_set_speed_hz(2000000));
-	FUNC_PREFIX(spi_setDataMode(SPI_MODE3));
-	FUNC_PREFIX(spi_transfern(dataPacket, m_nNumBoards[m_nSpiChipSelect]));
+	spi_transfer(m_nSpiChipSelect, dataPacket, m_nNumBoards[m_nSpiChipSelect]);
 
 	DEBUG_PRINTF("data=%x, dataPacket[%d]=%x", data, m_nPosition, dataPacket[m_nPosition]);
 	DEBUG_EXIT
@@ -133,6 +185,109 @@ uint8_t AutoDriver::SPIXfer(uint8_t data) {
 
 #pragma GCC diagnostic pop
 
+void AutoDriver::SPIReadBegin() {
+	if (s_Chain[m_nSpiChipSelect].bIsActive) {
+		ChainFlush(m_nSpiChipSelect);
+	}
+
+	m_bIsReading = true;
+}
+
+void AutoDriver::SPIReadEnd() {
+	m_bIsReading = false;
+}
+
+void AutoDriver::ChainBegin() {
+	for (uint32_t nSpiChipSelect = 0; nSpiChipSelect < autodriver::CHIP_SELECTS; nSpiChipSelect++) {
+		auto& chain = s_Chain[nSpiChipSelect];
+		memset(chain.aFrames, 0, sizeof(chain.aFrames));
+		memset(chain.nBytes, 0, sizeof(chain.nBytes));
+		chain.nFrames = 0;
+		chain.bIsActive = (m_nNumBoards[nSpiChipSelect] != 0);
+	}
+}
+
+void AutoDriver::ChainEnd() {
+	for (uint32_t nSpiChipSelect = 0; nSpiChipSelect < autodriver::CHIP_SELECTS; nSpiChipSelect++) {
+		if (s_Chain[nSpiChipSelect].bIsActive) {
+			ChainFlush(static_cast<uint8_t>(nSpiChipSelect));
+			s_Chain[nSpiChipSelect].bIsActive = false;
+		}
+	}
+}
+
+void AutoDriver::ChainFlush(const uint8_t nSpiChipSelect) {
+	auto& chain = s_Chain[nSpiChipSelect];
+
+	if (chain.nFrames == 0) {
+		return;
+	}
+
+	// Each frame is a separate chip select cycle. Boards with fewer bytes get NOP (0x00).
+	for (uint32_t nFrame = 0; nFrame < chain.nFrames; nFrame++) {
+		spi_transfer(nSpiChipSelect, chain.aFrames[nFrame], m_nNumBoards[nSpiChipSelect]);
+	}
+
+	DEBUG_PRINTF("nSpiChipSelect=%u, nFrames=%u", nSpiChipSelect, chain.nFrames);
+
+	memset(chain.aFrames, 0, sizeof(chain.aFrames));
+	memset(chain.nBytes, 0, sizeof(chain.nBytes));
+	chain.nFrames = 0;
+}
+
+void AutoDriver::ShadowPoll() {
+	struct Register {
+		TL6470ParamRegisters param;
+		uint32_t nBytes;
+	};
+
+	static constexpr Register s_Registers[] = {
+			{ L6470_PARAM_ABS_POS, 3 },
+			{ L6470_PARAM_SPEED, 3 },
+			{ L6470_PARAM_STATUS, 2 }
+	};
+
+	for (uint32_t nSpiChipSelect = 0; nSpiChipSelect < autodriver::CHIP_SELECTS; nSpiChipSelect++) {
+		const auto nNumBoards = m_nNumBoards[nSpiChipSelect];
+
+		if (nNumBoards == 0) {
+			continue;
+		}
+
+		assert(!s_Chain[nSpiChipSelect].bIsActive);
+
+		for (const auto& reg : s_Registers) {
+			char aFrame[autodriver::MAX_BOARDS];
+			uint32_t nValue[autodriver::MAX_BOARDS];
+
+			for (uint32_t nPosition = 0; nPosition < nNumBoards; nPosition++) {
+				aFrame[nPosition] = static_cast<char>(reg.param | L6470_CMD_GET_PARAM);
+				nValue[nPosition] = 0;
+			}
+
+			spi_transfer(static_cast<uint8_t>(nSpiChipSelect), aFrame, nNumBoards);
+
+			for (uint32_t nByte = 0; nByte < reg.nBytes; nByte++) {
+				memset(aFrame, 0, nNumBoards);
+
+				spi_transfer(static_cast<uint8_t>(nSpiChipSelect), aFrame, nNumBoards);
+
+				for (uint32_t nPosition = 0; nPosition < nNumBoards; nPosition++) {
+					nValue[nPosition] = (nValue[nPosition] << 8) | static_cast<uint8_t>(aFrame[nPosition]);
+				}
+			}
+
+			for (uint32_t nPosition = 0; nPosition < nNumBoards; nPosition++) {
+				auto *pBoard = s_pBoards[nSpiChipSelect][nPosition];
+
+				if (pBoard != nullptr) {
+					pBoard->ShadowSet(reg.param, nValue[nPosition]);
+				}
+			}
+		}
+	}
+}
+
 uint16_t AutoDriver::getNumBoards() {
 	uint16_t n = 0;
 
@@ -31,12 +31,25 @@
 void L6470::setParam(TL6470ParamRegisters param, unsigned long value) {
 	SPIXfer(param | L6470_CMD_SET_PARAM);
 	paramHandler(param, value);
+	ShadowSet(param, value);
 }
 
 long L6470::getParam(TL6470ParamRegisters param) {
+	long nValue;
+
+	if (ShadowGet(param, nValue)) {
+		return nValue;
+	}
+
+	SPIReadBegin();
 	SPIXfer(param | L6470_CMD_GET_PARAM);
 
-	return paramHandler(param, 0);
+	nValue = paramHandler(param, 0);
+	SPIReadEnd();
+
+	ShadowSet(param, static_cast<unsigned long>(nValue));
+
+	return nValue;
 }
 
 long L6470::getPos() {
@@ -64,24 +77,22 @@ long L6470::getMark() {
 }
 
 void L6470::run(TL6470Direction dir, float stepsPerSec) {
-	SPIXfer(L6470_CMD_RUN | dir);
-	unsigned long integerSpeed = spdCalc(stepsPerSec);
-	if (integerSpeed > 0xFFFFF)
-		integerSpeed = 0xFFFFF;
-
-	// Now we need to push this value out to the dSPIN. The 32-bit value is
-	//  stored in memory in little-endian format, but the dSPIN expects a
-	//  big-endian output, so we need to reverse the uint8_t-order of the
-	//  data as we're sending it out. Note that only 3 of the 4 bytes are
-	//  valid here.
+	runRaw(dir, spdCalc(stepsPerSec));
+}
 
-	// We begin by pointing bytePointer at the first uint8_t in integerSpeed.
-	auto *bytePointer = reinterpret_cast<uint8_t*>(&integerSpeed);
-	// Next, we'll iterate through a for loop, indexing across the bytes in
-	//  integerSpeed starting with uint8_t 2 and ending with uint8_t 0.
-	for (int8_t i = 2; i >= 0; i--) {
-		SPIXfer(bytePointer[i]);
+/*
+ * nSpeed is the ready-to-send 20-bit SPEED register value, see runSpeedCalc
+ */
+void L6470::runRaw(TL6470Direction dir, uint32_t nSpeed) {
+	if (nSpeed > 0xFFFFF) {
+		nSpeed = 0xFFFFF;
 	}
+
+	SPIXfer(L6470_CMD_RUN | dir);
+	// The dSPIN expects a big-endian output, only 3 of the 4 bytes are valid here.
+	SPIXfer(static_cast<uint8_t>(nSpeed >> 16));
+	SPIXfer(static_cast<uint8_t>(nSpeed >> 8));
+	SPIXfer(static_cast<uint8_t>(nSpeed));
 }
 
 void L6470::stepClock(TL6470Direction dir) {
@@ -123,6 +134,7 @@ void L6470::goToDir(TL6470Direction dir, long pos) {
 
 void L6470::goUntil(TL6470Action action, TL6470Direction dir, float stepsPerSec) {
 	SPIXfer(L6470_CMD_GO_UNTIL | action | dir);
+	ShadowInvalidate((1U << L6470_PARAM_ABS_POS) | (1U << L6470_PARAM_MARK));
 	unsigned long integerSpeed = spdCalc(stepsPerSec);
 	if (integerSpeed > 0x3FFFFF)
 		integerSpeed = 0x3FFFFF;
@@ -135,6 +147,7 @@ void L6470::goUntil(TL6470Action action, TL6470Direction dir, float stepsPerSec)
 
 void L6470::releaseSw(TL6470Action action, TL6470Direction dir) {
 	SPIXfer(L6470_CMD_RELEASE_SW | action | dir);
+	ShadowInvalidate((1U << L6470_PARAM_ABS_POS) | (1U << L6470_PARAM_MARK));
 }
 
 void L6470::goHome() {
@@ -155,10 +168,12 @@ void L6470::setPos(long newPos) {
 
 void L6470::resetPos() {
 	SPIXfer(L6470_CMD_RESET_POS);
+	ShadowSet(L6470_PARAM_ABS_POS, 0);
 }
 
 void L6470::resetDev() {
 	SPIXfer(L6470_CMD_RESET_DEVICE);
+	m_nShadowValid = 0;
 }
 
 void L6470::softStop() {
@@ -181,9 +196,13 @@ int L6470::getStatus() {
 	int temp = 0;
 
 	auto *bytePointer = reinterpret_cast<uint8_t*>(&temp);
+	SPIReadBegin();
 	SPIXfer(L6470_CMD_GET_STATUS);
 	bytePointer[1] = SPIXfer(0);
 	bytePointer[0] = SPIXfer(0);
+	SPIReadEnd();
+
+	ShadowSet(L6470_PARAM_STATUS, static_cast<unsigned long>(temp));
 
 	return temp;
 }
@@ -0,0 +1,100 @@
+/**
+ * @file l6470shadow.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+
+#include "l6470.h"
+
+#include "hardware.h"
+
+namespace l6470 {
+namespace shadow {
+/**
+ * Valid bits per register, index is TL6470ParamRegisters
+ */
+static constexpr uint32_t s_nMask[REGISTERS] = {
+		0,								// NOP
+		0x3FFFFF,						// ABS_POS
+		0x1FF,							// EL_POS
+		0x3FFFFF,						// MARK
+		0xFFFFF,						// SPEED
+		0xFFF,							// ACC
+		0xFFF,							// DECEL
+		0x3FF,							// MAX_SPEED
+		0x1FFF,							// MIN_SPEED
+		0xFF,							// KVAL_HOLD
+		0xFF,							// KVAL_RUN
+		0xFF,							// KVAL_ACC
+		0xFF,							// KVAL_DEC
+		0x3FFF,							// INT_SPD
+		0xFF,							// ST_SLP
+		0xFF,							// FN_SLP_ACC
+		0xFF,							// FN_SLP_DEC
+		0x0F,							// K_THERM
+		0x1F,							// ADC_OUT
+		0x0F,							// OCD_TH
+		0x7F,							// STALL_TH
+		0x3FF,							// FS_SPD
+		0xFF,							// STEP_MODE
+		0xFF,							// ALARM_EN
+		0xFFFF,							// CONFIG
+		0xFFFF							// STATUS
+};
+}  // namespace shadow
+}  // namespace l6470
+
+void L6470::ShadowSet(const TL6470ParamRegisters param, const unsigned long nValue) {
+	const auto nRegister = static_cast<uint32_t>(param);
+
+	if (__builtin_expect((nRegister == 0) || (nRegister >= l6470::shadow::REGISTERS), 0)) {
+		return;
+	}
+
+	m_nShadow[nRegister] = static_cast<uint32_t>(nValue) & l6470::shadow::s_nMask[nRegister];
+	m_nShadowMillis[nRegister] = Hardware::Get()->Millis();
+	m_nShadowValid |= (1U << nRegister);
+}
+
+bool L6470::ShadowGet(const TL6470ParamRegisters param, long& nValue) {
+	const auto nRegister = static_cast<uint32_t>(param);
+	const auto nBit = (1U << nRegister);
+
+	if ((nRegister >= l6470::shadow::REGISTERS) || ((m_nShadowValid & nBit) == 0)) {
+		return false;
+	}
+
+	if ((l6470::shadow::VOLATILE_MASK & nBit) != 0) {
+		if (m_nShadowMaxAgeMillis == 0) {
+			return false;
+		}
+
+		if ((Hardware::Get()->Millis() - m_nShadowMillis[nRegister]) > m_nShadowMaxAgeMillis) {
+			return false;
+		}
+	}
+
+	nValue = static_cast<long>(m_nShadow[nRegister]);
+	return true;
+}
@@ -156,12 +156,7 @@ float L6470::intSpdParse(unsigned long stepsPerSec) {
 // Multiply desired steps/s by 67.106 to get an appropriate value for this register
 // This is a 20-bit value, so we need to make sure the value is at or below 0xFFFFF.
 unsigned long L6470::spdCalc(float stepsPerSec) {
-	auto temp = static_cast<unsigned long>(stepsPerSec * 67.106f);
-
-	if (temp > 0x000FFFFF)
-		return 0x000FFFFF;
-	else
-		return temp;
+	return runSpeedCalc(stepsPerSec);
 }
 
 float L6470::spdParse(unsigned long stepsPerSec) {
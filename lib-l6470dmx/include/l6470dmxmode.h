@@ -36,6 +36,7 @@ enum TL6470DmxModes {
 	L6470DMXMODE4,
 	L6470DMXMODE5,
 	L6470DMXMODE6,
+	L6470DMXMODE7,
 	L6470DMXMODE_UNDEFINED
 };
 
@@ -53,6 +54,10 @@ public:
 	virtual bool BusyCheck();
 
 	virtual void Data(const uint8_t *)= 0;
+	/**
+	 * Called periodically from the main loop, for modes which need to stream commands
+	 */
+	virtual void Update(const uint32_t nMillis);
 };
 
 #endif /* L6470DMXMODE_H_ */
@@ -2,7 +2,7 @@
  * @file l6470dmxmode2.h
  *
  */
-/* Copyright (C) 2017-2019 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -28,6 +28,7 @@
 
 #include "l6470dmxmode.h"
 #include "l6470.h"
+#include "l6470dmxspeed.h"
 
 #include "motorparams.h"
 
@@ -53,6 +54,7 @@ private:
 	L6470 *m_pL6470;
 	float m_fMinSpeed;
 	float m_fMaxSpeed;
+	l6470dmxspeed::Table m_SpeedTable;
 };
 
 #endif /* L6470DMXMODE2_H_ */
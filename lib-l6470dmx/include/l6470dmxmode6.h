@@ -2,7 +2,7 @@
  * @file l6470dmxmode6.h
  *
  */
-/* Copyright (C) 2017-2019 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,32 +26,74 @@
 #ifndef L6470DMXMODE6_H_
 #define L6470DMXMODE6_H_
 
+#include <cstdint>
+
 #include "l6470dmxmode.h"
 #include "l6470.h"
 
 #include "motorparams.h"
 #include "modeparams.h"
 
-class L6470DmxMode6 final: public L6470DmxMode {
+namespace l6470dmxmode6 {
+static constexpr uint32_t UPDATE_MILLIS = 10;
+static constexpr uint32_t TARGET_TIMEOUT_MILLIS = 100;	///< No new target within this time, then the target is standing still
+static constexpr float SETTLE_STEPS = 1.0f;				///< Closer than this, the final approach is done by the L6470 itself
+static constexpr float GAIN = 10.0f;					///< Speed (steps/s) per step position error near the target
+static constexpr float SPEED_HYSTERESIS = 2.0f;			///< Steps/s, smaller speed changes are not sent
+}  // namespace l6470dmxmode6
+
+/**
+ * 16-bit position tracking
+ * Slot 0 : position coarse
+ * Slot 1 : position fine
+ * The position 0x0000-0xFFFF is scaled to 0-mode_max_steps.
+ *
+ * Instead of a stop and goTo for each new target, a trajectory planner
+ * streams run() speed updates so the motor follows a fading target without stopping.
+ * When the target stands still, the final approach is done with a goTo.
+ */
+class L6470DmxMode6: public L6470DmxMode {
 public:
-	L6470DmxMode6(L6470*, MotorParams*, ModeParams*);
+	L6470DmxMode6(L6470*, MotorParams*, ModeParams*, bool bHasSpeedSlot = false);
 	~L6470DmxMode6() override;
 
+	void InitSwitch() override;
+	void InitPos() override;
+
 	void Start() override;
 	void Stop() override;
 
 	void Data(const uint8_t*) override;
+	void Update(const uint32_t nMillis) override;
 
 	static TL6470DmxModes GetMode() {
 		return L6470DMXMODE6;
 	}
 
 	static uint16_t GetDmxFootPrint() {
-		return 0;
+		return 2;
 	}
 
 private:
+	enum class State : uint8_t {
+		IDLE, TRACKING, STOPPING, POSITIONING
+	};
+
+	ModeParams *m_pModeParams;
 	L6470 *m_pL6470;
+	float m_fSteps;				///< Position steps per DMX value
+	float m_fMicroSteps;
+	float m_fMinSpeed;
+	float m_fMaxSpeed;
+	float m_fDec;
+	float m_fSpeedLimit;
+	float m_fTargetSpeed { 0 };	///< Estimated from the target changes, steps/s
+	float m_fSpeed { 0 };		///< Latest run() speed, negative is reverse
+	long m_nTarget { 0 };
+	uint32_t m_nTargetMillis { 0 };
+	uint32_t m_nUpdateMillis { 0 };
+	State m_State { State::IDLE };
+	bool m_bHasSpeedSlot;
 };
 
-#endif /* L6470DMXMODE3_H_ */
+#endif /* L6470DMXMODE6_H_ */
@@ -1,8 +1,8 @@
 /**
- * @file e131paramsconst.cpp
+ * @file l6470dmxmode7.h
  *
  */
-/* Copyright (C) 2019-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -23,27 +23,32 @@
  * THE SOFTWARE.
  */
 
-#include "e131paramsconst.h"
-#include "e131params.h"
-
-#if LIGHTSET_PORTS > 4
-# define MAX_ARRAY 4
-#else
-# define MAX_ARRAY LIGHTSET_PORTS
-#endif
-
-const char E131ParamsConst::FILE_NAME[] = "e131.txt";
-
-const char E131ParamsConst::PRIORITY[e131params::MAX_PORTS][18] {
-	"priority_port_a",
-#if MAX_ARRAY >= 2
-	"priority_port_b",
-#endif
-#if MAX_ARRAY >= 3
-	"priority_port_c",
-#endif
-#if MAX_ARRAY == 4
-	"priority_port_d"
-#endif
+#ifndef L6470DMXMODE7_H_
+#define L6470DMXMODE7_H_
+
+#include <cstdint>
+
+#include "l6470dmxmode6.h"
+#include "l6470.h"
+
+#include "motorparams.h"
+#include "modeparams.h"
+
+/**
+ * As mode 6, with
+ * Slot 2 : speed limit, 0 is the maximum speed
+ */
+class L6470DmxMode7 final: public L6470DmxMode6 {
+public:
+	L6470DmxMode7(L6470 *pL6470, MotorParams *pMotorParams, ModeParams *pModeParams) : L6470DmxMode6(pL6470, pMotorParams, pModeParams, true) {}
+
+	static TL6470DmxModes GetMode() {
+		return L6470DMXMODE7;
+	}
+
+	static uint16_t GetDmxFootPrint() {
+		return 3;
+	}
 };
 
+#endif /* L6470DMXMODE7_H_ */
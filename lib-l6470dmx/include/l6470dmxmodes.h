@@ -49,6 +49,32 @@ public:
 	bool IsDmxDataChanged(const uint8_t *pDmxData, uint32_t nLength);
 	void DmxData(const uint8_t *pDmxData, uint32_t nLength);
 
+	/*
+	 * Non-blocking command scheduling.
+	 * QueueDmxData takes the DMX data captured by IsDmxDataChanged as the new target.
+	 * A target not yet issued is superseded by the next one.
+	 * Run issues the pending target as soon as the driver is not busy.
+	 */
+	void QueueDmxData();
+	bool Run();
+
+	/*
+	 * Synchronous output (doUpdate = false).
+	 * StageDmxData keeps the target in a separate buffer, so a pending target is not affected.
+	 * ReleaseStagedDmxData makes it the current target, IssueDmxData sends it without a busy check.
+	 */
+	bool StageDmxData(const uint8_t *pDmxData, uint32_t nLength);
+	void ReleaseStagedDmxData();
+	void IssueDmxData();
+
+	bool IsPending() const {
+		return m_bIsPending;
+	}
+
+	void Update(const uint32_t nMillis) {
+		m_pDmxMode->Update(nMillis);
+	}
+
 	void Start();
 	void Stop();
 
@@ -79,6 +105,7 @@ private:
 
 private:
 	bool m_bIsStarted{false};
+	bool m_bIsPending{false};
 
 private:
 	uint8_t m_nMotorNumber{0};
@@ -87,6 +114,7 @@ private:
 	L6470DmxMode *m_pDmxMode{nullptr};
 	uint16_t m_DmxFootPrint{0};
 	uint8_t *m_pDmxData;
+	uint8_t *m_pDmxDataStaged { nullptr };
 };
 
 #endif /* L6470DMXMODES_H_ */
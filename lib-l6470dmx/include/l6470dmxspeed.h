@@ -0,0 +1,76 @@
+/**
+ * @file l6470dmxspeed.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef L6470DMXSPEED_H_
+#define L6470DMXSPEED_H_
+
+#include <cstdint>
+
+#include "l6470.h"
+
+/**
+ * Maps each DMX value to the ready-to-send RUN command:
+ * bit 24 is the direction, bits 19..0 the SPEED register value.
+ * Built once in the mode constructor, so Data() is a lookup and an SPI transfer.
+ */
+namespace l6470dmxspeed {
+static constexpr uint32_t DIR_SHIFT = 24;
+static constexpr uint32_t SPEED_MASK = 0xFFFFF;
+static constexpr uint32_t STOP = 0xFFFFFFFF;
+
+class Table {
+public:
+	void Set(const uint8_t nValue, const TL6470Direction dir, const float fStepsPerSec) {
+		m_Entry[nValue] = (static_cast<uint32_t>(dir) << DIR_SHIFT) | L6470::runSpeedCalc(fStepsPerSec);
+	}
+
+	void SetStop(const uint8_t nValue) {
+		m_Entry[nValue] = STOP;
+	}
+
+	void Run(L6470 *pL6470, const uint8_t nValue) const {
+		const auto nEntry = m_Entry[nValue];
+
+		if (nEntry == STOP) {
+			pL6470->softStop();
+			return;
+		}
+
+		pL6470->runRaw(static_cast<TL6470Direction>(nEntry >> DIR_SHIFT), nEntry & SPEED_MASK);
+	}
+
+	/**
+	 * The direction is taken from another slot
+	 */
+	void Run(L6470 *pL6470, const uint8_t nValue, const TL6470Direction dir) const {
+		pL6470->runRaw(dir, m_Entry[nValue] & SPEED_MASK);
+	}
+
+private:
+	uint32_t m_Entry[256];
+};
+}  // namespace l6470dmxspeed
+
+#endif /* L6470DMXSPEED_H_ */
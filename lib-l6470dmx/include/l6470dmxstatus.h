@@ -0,0 +1,154 @@
+/**
+ * @file l6470dmxstatus.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef L6470DMXSTATUS_H_
+#define L6470DMXSTATUS_H_
+
+#include <cstdint>
+#include <atomic>
+#include <cassert>
+
+#include "l6470constants.h"
+
+namespace l6470dmxstatus {
+#if !defined (CONFIG_L6470DMX_STATUS_POLL_MILLIS)
+# define CONFIG_L6470DMX_STATUS_POLL_MILLIS 10
+#endif
+static constexpr uint32_t POLL_MILLIS = CONFIG_L6470DMX_STATUS_POLL_MILLIS;
+static constexpr uint32_t MAX_MOTORS = 8;
+
+/**
+ * The STATUS alarm flags are active low
+ */
+static constexpr uint16_t ALARM_MASK = L6470_STATUS_UVLO | L6470_STATUS_TH_WRN | L6470_STATUS_TH_SD | L6470_STATUS_OCD | L6470_STATUS_STEP_LOSS_A | L6470_STATUS_STEP_LOSS_B;
+
+struct Snapshot {
+	uint32_t nMillis;		///< Time of the poll
+	int32_t nPosition;		///< ABS_POS, sign extended
+	uint32_t nSpeed;		///< SPEED register value
+	uint16_t nStatus;		///< STATUS register value
+	uint16_t nAlarms;		///< ALARM_MASK bits which are active, active high
+};
+
+inline uint16_t get_alarms(const uint16_t nStatus) {
+	return static_cast<uint16_t>(~nStatus & ALARM_MASK);
+}
+
+inline int32_t get_position(const uint32_t nAbsPos) {
+	// ABS_POS is a 22-bit two's complement value
+	return static_cast<int32_t>(nAbsPos << 10) >> 10;
+}
+}  // namespace l6470dmxstatus
+
+/**
+ * Motor status telemetry, filled in by SparkFunDmx::Run from the batched register poll.
+ * Readers (RDM sensors, HTTP JSON, display) never touch the SPI bus.
+ * Each motor has a sequence lock: Publish is the only writer, Read retries
+ * when it overlapped with a Publish, so a reader gets a consistent snapshot
+ * without taking a lock, also from another thread.
+ */
+class L6470DmxStatus {
+public:
+	L6470DmxStatus() {
+		assert(s_pThis == nullptr);
+		s_pThis = this;
+
+		for (auto& slot : m_Slot) {
+			slot.nSequence.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void Publish(const uint32_t nMotor, const l6470dmxstatus::Snapshot& snapshot) {
+		assert(nMotor < l6470dmxstatus::MAX_MOTORS);
+		auto& slot = m_Slot[nMotor];
+
+		const auto nSequence = slot.nSequence.load(std::memory_order_relaxed);
+		slot.nSequence.store(nSequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.snapshot = snapshot;
+
+		slot.nSequence.store(nSequence + 2, std::memory_order_release);
+		m_nMotorsMask.fetch_or(1U << nMotor, std::memory_order_relaxed);
+
+		if (snapshot.nAlarms != 0) {
+			m_nAlarmsMask.fetch_or(1U << nMotor, std::memory_order_relaxed);
+		} else {
+			m_nAlarmsMask.fetch_and(~(1U << nMotor), std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @return false when the motor has no snapshot (yet)
+	 */
+	bool Read(const uint32_t nMotor, l6470dmxstatus::Snapshot& snapshot) const {
+		if ((nMotor >= l6470dmxstatus::MAX_MOTORS) || ((GetMotorsMask() & (1U << nMotor)) == 0)) {
+			return false;
+		}
+
+		const auto& slot = m_Slot[nMotor];
+		uint32_t nSequence;
+
+		do {
+			nSequence = slot.nSequence.load(std::memory_order_acquire);
+			snapshot = slot.snapshot;
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while (((nSequence & 1U) != 0) || (nSequence != slot.nSequence.load(std::memory_order_relaxed)));
+
+		return true;
+	}
+
+	/**
+	 * Bit n is set when motor n has a snapshot
+	 */
+	uint32_t GetMotorsMask() const {
+		return m_nMotorsMask.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Bit n is set when motor n has an active alarm
+	 */
+	uint32_t GetAlarmsMask() const {
+		return m_nAlarmsMask.load(std::memory_order_relaxed);
+	}
+
+	static L6470DmxStatus *Get() {
+		return s_pThis;
+	}
+
+private:
+	struct Slot {
+		std::atomic<uint32_t> nSequence;
+		l6470dmxstatus::Snapshot snapshot;
+	};
+
+	Slot m_Slot[l6470dmxstatus::MAX_MOTORS];
+	std::atomic<uint32_t> m_nMotorsMask { 0 };
+	std::atomic<uint32_t> m_nAlarmsMask { 0 };
+
+	static L6470DmxStatus *s_pThis;
+};
+
+#endif /* L6470DMXSTATUS_H_ */
@@ -0,0 +1,77 @@
+/**
+ * @file rdmsensorl6470.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RDMSENSORL6470_H_
+#define RDMSENSORL6470_H_
+
+#include <cstdint>
+#include <cstdio>
+
+#include "rdmsensor.h"
+#include "rdm_e120.h"
+
+#include "l6470dmxstatus.h"
+
+/**
+ * The active STATUS alarm flags of a motor, bit 0 is UVLO ... bit 5 is STEP_LOSS_B.
+ * Served from the L6470DmxStatus snapshot, so no SPI access.
+ */
+class RDMSensorL6470 final: public RDMSensor {
+	static constexpr uint32_t ALARM_SHIFT = 9;
+
+public:
+	RDMSensorL6470(const uint8_t nSensor, const uint32_t nMotor) : RDMSensor(nSensor), m_nMotor(nMotor) {
+		SetType(E120_SENS_OTHER);
+		SetUnit(E120_UNITS_NONE);
+		SetPrefix(E120_PREFIX_NONE);
+		SetRangeMin(0);
+		SetRangeMax(l6470dmxstatus::ALARM_MASK >> ALARM_SHIFT);
+		SetNormalMin(0);
+		SetNormalMax(0);
+
+		char aDescription[32];
+		snprintf(aDescription, sizeof(aDescription), "Motor %u alarms", static_cast<unsigned int>(nMotor));
+		SetDescription(aDescription);
+	}
+
+	bool Initialize() override {
+		return L6470DmxStatus::Get() != nullptr;
+	}
+
+	int16_t GetValue() override {
+		l6470dmxstatus::Snapshot snapshot;
+
+		if (!L6470DmxStatus::Get()->Read(m_nMotor, snapshot)) {
+			return 0;
+		}
+
+		return static_cast<int16_t>(snapshot.nAlarms >> ALARM_SHIFT);
+	}
+
+private:
+	uint32_t m_nMotor;
+};
+
+#endif /* RDMSENSORL6470_H_ */
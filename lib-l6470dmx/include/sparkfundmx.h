@@ -30,6 +30,7 @@
 
 #include "lightset.h"
 #include "l6470dmxmodes.h"
+#include "l6470dmxstatus.h"
 
 #include "modeparams.h"
 #include "motorparams.h"
@@ -41,6 +42,13 @@
 
 #define SPARKFUN_DMX_MAX_MOTORS		8
 
+namespace sparkfundmx {
+/**
+ * Volatile registers are served from the shadow up to this number of poll intervals
+ */
+static constexpr uint32_t SHADOW_MAX_AGE_POLLS = 2;
+}  // namespace sparkfundmx
+
 struct TSparkFunStores {
 	ModeParamsStore *pModeParamsStore;
 	MotorParamsStore *pMotorParamsStore;
@@ -56,11 +64,28 @@ public:
 	void Stop(const uint32_t nPortIndex) override;
 
 	void SetData(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const bool doUpdate = true) override;
+	void SetDataRange(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const uint32_t nSlotFirst, const uint32_t nSlotLast, const bool doUpdate = true) override;
 	void Sync(const uint32_t nPortIndex) override;
 	void Sync() override;
 
 	void Print() override;
 
+	/**
+	 * Polls ABS_POS, SPEED and STATUS of all boards at the status poll rate,
+	 * publishes the L6470DmxStatus snapshots and issues the queued motor commands.
+	 * Must be called from the main loop.
+	 */
+	void Run();
+
+	/**
+	 * @param nStatusPollMillis interval of the batched register poll
+	 */
+	void SetStatusPollMillis(const uint32_t nStatusPollMillis);
+
+	uint32_t GetStatusPollMillis() const {
+		return m_nStatusPollMillis;
+	}
+
 	uint32_t GetMotorsConnected() {
 		return AutoDriver::getNumBoards();
 	}
@@ -115,6 +140,11 @@ public:
 
 	void ReadConfigFiles();
 
+private:
+	void Service(const uint32_t nMillis);
+	void Release();
+	void StatusPoll(const uint32_t nMillis);
+
 private:
 	AutoDriver *m_pAutoDriver[SPARKFUN_DMX_MAX_MOTORS];
 	MotorParams *m_pMotorParams[SPARKFUN_DMX_MAX_MOTORS];
@@ -145,6 +175,12 @@ private:
 
 	uint16_t m_nDmxStartAddress;
 	uint16_t m_nDmxFootprint { 0 };
+
+	L6470DmxStatus m_Status;
+	uint32_t m_nStatusPollMillis { l6470dmxstatus::POLL_MILLIS };
+	uint32_t m_nStatusPollLast { 0 };
+	uint32_t m_nAlarmsMask { 0 };
+	uint32_t m_nStagedMask { 0 };	///< Motors with a target received with doUpdate = false, released on Sync
 };
 
 #endif /* SPARKFUNDMX_H_ */
@@ -2,7 +2,7 @@
  * @file sparkfundmxconst.h
  *
  */
-/* Copyright (C) 2019-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -28,6 +28,7 @@
 
 struct SparkFunDmxConst {
 	static const char MSG_INIT[];
+	static const char MSG_ALARMS_CLEARED[];
 };
 
 #endif /* SPARKFUNDMXCONST_H_ */
@@ -32,6 +32,7 @@
 
 #include "sparkfundmx.h"
 #include "configstore.h"
+#include "propertiesbundle.h"
 
 #include "debug.h"
 
@@ -60,6 +61,8 @@ static constexpr uint32_t STRUCT_SIZE = (MAX_MOTORS * sizeof(struct sparkfundmxp
 static constexpr uint32_t OFFSET(const uint32_t x) {
 	return STRUCT_OFFSET + (x * sizeof(struct sparkfundmxparams::Params));
 }
+static constexpr uint32_t STAMP_OFFSET = STRUCT_OFFSET + STRUCT_SIZE;
+static_assert((STAMP_OFFSET + sizeof(struct properties::bundle::Stamp)) <= MAX_SIZE, "");
 }  // namespace sparkfunparamsstore
 
 class SparkFunDmxParamsStore {
@@ -85,6 +88,14 @@ public:
 		Get().ICopy(nMotorIndex, pParams);
 	}
 
+	static void UpdateStamp(const struct properties::bundle::Stamp& stamp) {
+		ConfigStore::Get()->Update(configstore::Store::SPARKFUN, sparkfunparamsstore::STAMP_OFFSET, &stamp, sizeof(struct properties::bundle::Stamp));
+	}
+
+	static void CopyStamp(struct properties::bundle::Stamp& stamp) {
+		ConfigStore::Get()->Copy(configstore::Store::SPARKFUN, &stamp, sizeof(struct properties::bundle::Stamp), sparkfunparamsstore::STAMP_OFFSET);
+	}
+
 private:
 	SparkFunDmxParamsStore() {
 		DEBUG_ENTRY
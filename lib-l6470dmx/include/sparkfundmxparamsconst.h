@@ -2,7 +2,7 @@
  * @file sparkfundmxparamsconst.h
  *
  */
-/* Copyright (C) 2019-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,13 +27,13 @@
 #define SPARKFUNDMXPARAMSCONST_H_
 
 struct SparkFunDmxParamsConst {
-	static const char FILE_NAME[];
-	static const char POSITION[];
+	static constexpr char FILE_NAME[] = "sparkfun.txt";
+	static constexpr char POSITION[] = "sparkfun_position";
 #if !defined (H3)
-	static const char SPI_CS[];
+	static constexpr char SPI_CS[] = "sparkfun_spi_cs";
 #endif
-	static const char RESET_PIN[];
-	static const char BUSY_PIN[];
+	static constexpr char RESET_PIN[] = "sparkfun_reset_pin";
+	static constexpr char BUSY_PIN[] = "sparkfun_busy_pin";
 };
 
 #endif /* SPARKFUNDMXPARAMSCONST_H_ */
@@ -54,3 +54,6 @@ bool L6470DmxMode::BusyCheck() {
 	DEBUG_EXIT
 	return false;
 }
+
+void L6470DmxMode::Update([[maybe_unused]] const uint32_t nMillis) {
+}
@@ -2,7 +2,7 @@
  * @file l6470dmxmode0.cpp
  *
  */
-/* Copyright (C) 2017-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -43,6 +43,20 @@ L6470DmxMode0::L6470DmxMode0(L6470 *pL6470) {
 	m_fMinSpeed = m_pL6470->getMinSpeed();
 	m_fMaxSpeed = m_pL6470->getMaxSpeed();
 
+	const auto fStep = (m_fMaxSpeed - m_fMinSpeed) / 127;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		const auto nValue = static_cast<uint8_t>(i);
+
+		if (i <= 126) {			// Left-hand rotation
+			m_SpeedTable.Set(nValue, L6470_DIR_FWD, m_fMinSpeed + static_cast<float>(127 - i) * fStep);
+		} else if (i >= 130) {	// Right-hand rotation
+			m_SpeedTable.Set(nValue, L6470_DIR_REV, m_fMinSpeed + static_cast<float>(i - 129) * fStep);
+		} else {
+			m_SpeedTable.SetStop(nValue);
+		}
+	}
+
 	DEBUG_EXIT;
 }
 
@@ -71,17 +85,7 @@ void L6470DmxMode0::Stop() {
 void L6470DmxMode0::Data(const uint8_t *pDmxData) {
 	DEBUG_ENTRY;
 
-	if (pDmxData[0] <= 126) {	// Left-hand rotation
-		m_pL6470->run(L6470_DIR_FWD, m_fMinSpeed + static_cast<float>((127 - pDmxData[0])) * ((m_fMaxSpeed - m_fMinSpeed) / 127));
-		return;
-	}
-
-	if (pDmxData[0] >= 130) {	// Right-hand rotation
-		m_pL6470->run(L6470_DIR_REV, m_fMinSpeed + static_cast<float>((pDmxData[0] - 129)) * ((m_fMaxSpeed - m_fMinSpeed) / 127));
-		return;
-	}
-
-	m_pL6470->softStop();
+	m_SpeedTable.Run(m_pL6470, pDmxData[0]);
 
 	DEBUG_EXIT;
 }
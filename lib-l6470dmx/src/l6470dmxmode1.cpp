@@ -2,7 +2,7 @@
  * @file l6470dmxmode1.cpp
  *
  */
-/* Copyright (C) 2017-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -43,6 +43,12 @@ L6470DmxMode1::L6470DmxMode1(L6470 *pL6470) {
 	m_fMinSpeed = m_pL6470->getMinSpeed();
 	m_fMaxSpeed = m_pL6470->getMaxSpeed();
 
+	const auto fStep = (m_fMaxSpeed - m_fMinSpeed) / 255;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		m_SpeedTable.Set(static_cast<uint8_t>(i), L6470_DIR_FWD, m_fMinSpeed + static_cast<float>(i) * fStep);
+	}
+
 	DEBUG_EXIT;
 }
 
@@ -69,12 +75,10 @@ void L6470DmxMode1::Stop() {
 void L6470DmxMode1::Data(const uint8_t *pDmxData) {
 	DEBUG_ENTRY;
 
-	float speed = m_fMinSpeed + static_cast<float>(pDmxData[0]) * ((m_fMaxSpeed - m_fMinSpeed) / 255);
-
 	if (pDmxData[1] <= 127) {	// Right-hand rotation
-		m_pL6470->run(L6470_DIR_REV, speed);
+		m_SpeedTable.Run(m_pL6470, pDmxData[0], L6470_DIR_REV);
 	} else {					// Left-hand rotation
-		m_pL6470->run(L6470_DIR_FWD, speed);
+		m_SpeedTable.Run(m_pL6470, pDmxData[0], L6470_DIR_FWD);
 	}
 
 	DEBUG_EXIT;
@@ -2,7 +2,7 @@
  * @file l6470dmxmode2.cpp
  *
  */
-/* Copyright (C) 2017-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -43,6 +43,12 @@ L6470DmxMode2::L6470DmxMode2(L6470 *pL6470) {
 	m_fMinSpeed = m_pL6470->getMinSpeed();
 	m_fMaxSpeed = m_pL6470->getMaxSpeed();
 
+	const auto fStep = (m_fMaxSpeed - m_fMinSpeed) / 255;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		m_SpeedTable.Set(static_cast<uint8_t>(i), L6470_DIR_FWD, m_fMinSpeed + static_cast<float>(i) * fStep);
+	}
+
 	DEBUG_EXIT;
 }
 
@@ -71,7 +77,7 @@ void L6470DmxMode2::Stop() {
 void L6470DmxMode2::Data(const uint8_t *pDmxData) {
 	DEBUG_ENTRY;
 
-	m_pL6470->run(L6470_DIR_FWD, m_fMinSpeed + static_cast<float>(pDmxData[0]) * ((m_fMaxSpeed - m_fMinSpeed) / 255));
+	m_SpeedTable.Run(m_pL6470, pDmxData[0]);
 
 	DEBUG_EXIT;
 }
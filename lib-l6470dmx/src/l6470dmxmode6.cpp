@@ -2,7 +2,7 @@
  * @file l6470dmxmode6.cpp
  *
  */
-/* Copyright (C) 2017 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -23,7 +23,12 @@
  * THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cstdint>
+#include <cmath>
+#ifndef NDEBUG
+ #include <cstdio>
+#endif
 #include <cassert>
 
 #include "l6470.h"
@@ -32,16 +37,29 @@
 #include "motorparams.h"
 #include "modeparams.h"
 
+#include "hardware.h"
+
 #include "debug.h"
 
-L6470DmxMode6::L6470DmxMode6(L6470 *pL6470, [[maybe_unused]] MotorParams *pMotorParams, [[maybe_unused]] ModeParams *pModeParams) {
+using namespace l6470dmxmode6;
+
+L6470DmxMode6::L6470DmxMode6(L6470 *pL6470, [[maybe_unused]] MotorParams *pMotorParams, ModeParams *pModeParams, bool bHasSpeedSlot) {
 	DEBUG_ENTRY;
 
 	assert(pL6470 != nullptr);
 	assert(pMotorParams != nullptr);
 	assert(pModeParams != nullptr);
 
+	m_pModeParams = pModeParams;
 	m_pL6470 = pL6470;
+	m_bHasSpeedSlot = bHasSpeedSlot;
+
+	m_fSteps = static_cast<float>(pModeParams->GetMaxSteps()) / 0xFFFF;
+	m_fMicroSteps = static_cast<float>(1U << m_pL6470->getStepMode());
+	m_fMinSpeed = m_pL6470->getMinSpeed();
+	m_fMaxSpeed = m_pL6470->getMaxSpeed();
+	m_fDec = m_pL6470->getDec();
+	m_fSpeedLimit = m_fMaxSpeed;
 
 	DEBUG_EXIT;
 }
@@ -52,6 +70,28 @@ L6470DmxMode6::~L6470DmxMode6() {
 	DEBUG_EXIT;
 }
 
+void L6470DmxMode6::InitSwitch() {
+	DEBUG_ENTRY;
+
+	if (m_pModeParams->HasSwitch()) {
+		const TL6470Action action = m_pModeParams->GetSwitchAction();
+		const TL6470Direction dir = m_pModeParams->GetSwitchDir();
+		const float stepsPerSec = m_pModeParams->GetSwitchStepsPerSec();
+
+		m_pL6470->goUntil(action, dir, stepsPerSec);
+	}
+
+	DEBUG_EXIT;
+}
+
+void L6470DmxMode6::InitPos() {
+	DEBUG_ENTRY;
+
+	m_pL6470->resetPos();
+
+	DEBUG_EXIT;
+}
+
 void L6470DmxMode6::Start() {
 	DEBUG_ENTRY;
 
@@ -61,11 +101,112 @@ void L6470DmxMode6::Start() {
 void L6470DmxMode6::Stop() {
 	DEBUG_ENTRY;
 
+	if (m_State != State::IDLE) {
+		m_pL6470->softStop();
+		m_State = State::IDLE;
+		m_fSpeed = 0;
+	}
+
 	DEBUG_EXIT;
 }
 
-void L6470DmxMode6::Data([[maybe_unused]] const uint8_t *pDmxData) {
+/**
+ * A new target, the motor is not stopped. The speed of the target
+ * is estimated from consecutive targets and used as feed forward.
+ */
+void L6470DmxMode6::Data(const uint8_t *pDmxData) {
 	DEBUG_ENTRY;
 
+	const auto nValue = (static_cast<uint32_t>(pDmxData[0]) << 8) | pDmxData[1];
+	const auto nTarget = static_cast<long>(static_cast<float>(nValue) * m_fSteps);
+	const auto nMillis = Hardware::Get()->Millis();
+	const auto nDeltaMillis = nMillis - m_nTargetMillis;
+
+	if ((m_State == State::TRACKING) && (nDeltaMillis != 0) && (nDeltaMillis <= TARGET_TIMEOUT_MILLIS)) {
+		const auto fSpeed = (static_cast<float>(nTarget - m_nTarget) / m_fMicroSteps) * 1000.0f / static_cast<float>(nDeltaMillis);
+		m_fTargetSpeed = 0.5f * (m_fTargetSpeed + fSpeed);
+	} else {
+		m_fTargetSpeed = 0;
+	}
+
+	if (m_bHasSpeedSlot) {
+		m_fSpeedLimit = (pDmxData[2] == 0) ? m_fMaxSpeed : m_fMinSpeed + static_cast<float>(pDmxData[2]) * ((m_fMaxSpeed - m_fMinSpeed) / 255);
+	}
+
+	m_nTarget = nTarget;
+	m_nTargetMillis = nMillis;
+	m_State = State::TRACKING;
+
+#ifndef NDEBUG
+	printf("\t\t\tnValue=%u, nTarget=%ld, m_fTargetSpeed=%f, m_fSpeedLimit=%f\n", nValue, nTarget, m_fTargetSpeed, m_fSpeedLimit);
+#endif
+
+	m_nUpdateMillis = nMillis - UPDATE_MILLIS;
+	Update(nMillis);
+
 	DEBUG_EXIT;
 }
+
+/**
+ * Speed = target speed + min(braking curve, GAIN * position error)
+ * The braking curve sqrt(2 * dec * error) lets the motor arrive at the target
+ * with the deceleration of the L6470.
+ */
+void L6470DmxMode6::Update(const uint32_t nMillis) {
+	if (__builtin_expect((m_State == State::IDLE), 1)) {
+		return;
+	}
+
+	if ((nMillis - m_nUpdateMillis) < UPDATE_MILLIS) {
+		return;
+	}
+
+	m_nUpdateMillis = nMillis;
+
+	if (m_State == State::STOPPING) {
+		if (!m_pL6470->busyCheck()) {
+			m_pL6470->goTo(m_nTarget);
+			m_State = State::POSITIONING;
+		}
+		return;
+	}
+
+	if (m_State == State::POSITIONING) {
+		if (!m_pL6470->busyCheck()) {
+			m_State = State::IDLE;
+		}
+		return;
+	}
+
+	if ((nMillis - m_nTargetMillis) > TARGET_TIMEOUT_MILLIS) {
+		m_fTargetSpeed = 0;
+	}
+
+	const auto fError = static_cast<float>(m_nTarget - m_pL6470->getPos()) / m_fMicroSteps;
+	const auto fErrorAbs = fabsf(fError);
+
+	if ((fErrorAbs <= SETTLE_STEPS) && (m_fTargetSpeed == 0)) {
+		m_pL6470->softStop();
+		m_fSpeed = 0;
+		m_State = State::STOPPING;
+		return;
+	}
+
+	const auto fCorrection = std::min(sqrtf(2.0f * m_fDec * fErrorAbs), GAIN * fErrorAbs);
+	auto fSpeed = m_fTargetSpeed + ((fError < 0) ? -fCorrection : fCorrection);
+
+	if (fSpeed > m_fSpeedLimit) {
+		fSpeed = m_fSpeedLimit;
+	} else if (fSpeed < -m_fSpeedLimit) {
+		fSpeed = -m_fSpeedLimit;
+	}
+
+	const auto isSameDirection = ((fSpeed < 0) == (m_fSpeed < 0));
+
+	if (isSameDirection && (fabsf(fSpeed - m_fSpeed) < SPEED_HYSTERESIS)) {
+		return;
+	}
+
+	m_pL6470->run((fSpeed < 0) ? L6470_DIR_REV : L6470_DIR_FWD, fabsf(fSpeed));
+	m_fSpeed = fSpeed;
+}
@@ -24,6 +24,7 @@
  */
 
 #include <cstdint>
+#include <cstring>
 #ifndef NDEBUG
  #include <cstdio>
 #endif
@@ -39,6 +40,7 @@
 #include "l6470dmxmode4.h"
 #include "l6470dmxmode5.h"
 #include "l6470dmxmode6.h"
+#include "l6470dmxmode7.h"
 
 #include "motorparams.h"
 #include "modeparams.h"
@@ -86,6 +88,10 @@ L6470DmxModes::L6470DmxModes(TL6470DmxModes tMode, uint16_t nDmxStartAddress, L6
 			m_pDmxMode = new L6470DmxMode6(pL6470, pMotorParams, pModeParams);
 			m_DmxFootPrint = L6470DmxMode6::GetDmxFootPrint();
 			break;
+		case L6470DMXMODE7:
+			m_pDmxMode = new L6470DmxMode7(pL6470, pMotorParams, pModeParams);
+			m_DmxFootPrint = L6470DmxMode7::GetDmxFootPrint();
+			break;
 		default:
 			break;
 	}
@@ -99,8 +105,12 @@ L6470DmxModes::L6470DmxModes(TL6470DmxModes tMode, uint16_t nDmxStartAddress, L6
 		m_pDmxData = new uint8_t[m_DmxFootPrint];
 		assert(m_pDmxData != nullptr);
 
+		m_pDmxDataStaged = new uint8_t[m_DmxFootPrint];
+		assert(m_pDmxDataStaged != nullptr);
+
 		for (int i = 0; i < m_DmxFootPrint; i++) {
 			m_pDmxData[i] = 0;
+			m_pDmxDataStaged[i] = 0;
 		}
 	}
 
@@ -113,6 +123,9 @@ L6470DmxModes::~L6470DmxModes() {
 	delete [] m_pDmxData;
 	m_pDmxData = nullptr;
 
+	delete [] m_pDmxDataStaged;
+	m_pDmxDataStaged = nullptr;
+
 	delete m_pDmxMode;
 	m_pDmxMode = nullptr;
 
@@ -158,6 +171,9 @@ uint16_t L6470DmxModes::GetDmxFootPrintMode(uint32_t tMode) {
 		case L6470DMXMODE6:
 			return L6470DmxMode6::GetDmxFootPrint();
 			break;
+		case L6470DMXMODE7:
+			return L6470DmxMode7::GetDmxFootPrint();
+			break;
 		default:
 			return 0;
 			break;
@@ -280,3 +296,63 @@ void L6470DmxModes::DmxData(const uint8_t *pDmxData, uint32_t nLength) {
 	DEBUG_EXIT;
 }
 
+void L6470DmxModes::QueueDmxData() {
+	DEBUG_ENTRY;
+
+	assert(m_pDmxMode != nullptr);
+
+	if (!m_bIsPending) {
+		m_pDmxMode->HandleBusy();
+		m_bIsPending = true;
+	}
+
+	DEBUG_EXIT;
+}
+
+/**
+ * @return true when a target is still waiting for the driver
+ */
+bool L6470DmxModes::Run() {
+	if (__builtin_expect((!m_bIsPending), 1)) {
+		return false;
+	}
+
+	if (m_pDmxMode->BusyCheck()) {
+		return true;
+	}
+
+#ifndef NDEBUG
+	printf("\tMotor : %d -> issue\n", m_nMotorNumber);
+#endif
+
+	IssueDmxData();
+
+	return false;
+}
+
+/**
+ * @return true when the staged target differs from the current target
+ */
+bool L6470DmxModes::StageDmxData(const uint8_t *pDmxData, uint32_t nLength) {
+	assert(m_pDmxMode != nullptr);
+	assert(pDmxData != nullptr);
+
+	if ((m_pDmxMode == nullptr) || (nLength < (m_nDmxStartAddress + m_DmxFootPrint))) {
+		return false;
+	}
+
+	memcpy(m_pDmxDataStaged, &pDmxData[m_nDmxStartAddress - 1], m_DmxFootPrint);
+
+	return memcmp(m_pDmxDataStaged, m_pDmxData, m_DmxFootPrint) != 0;
+}
+
+void L6470DmxModes::ReleaseStagedDmxData() {
+	memcpy(m_pDmxData, m_pDmxDataStaged, m_DmxFootPrint);
+}
+
+void L6470DmxModes::IssueDmxData() {
+	m_pDmxMode->Data(m_pDmxData);
+
+	m_bIsPending = false;
+	m_bIsStarted = true;
+}
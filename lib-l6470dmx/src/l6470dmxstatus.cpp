@@ -0,0 +1,90 @@
+/**
+ * @file l6470dmxstatus.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "l6470dmxstatus.h"
+#include "l6470constants.h"
+
+#include "hardware.h"
+
+L6470DmxStatus *L6470DmxStatus::s_pThis;
+
+namespace remoteconfig {
+namespace stepper {
+/**
+ * /json/stepper/status
+ * Served from the snapshots, no SPI access.
+ */
+uint32_t json_get_status(char *pOutBuffer, const uint32_t nOutBufferSize) {
+	auto *pStatus = L6470DmxStatus::Get();
+
+	if (pStatus == nullptr) {
+		return static_cast<uint32_t>(snprintf(pOutBuffer, nOutBufferSize, "{\"motors\":[]}"));
+	}
+
+	auto nLength = static_cast<uint32_t>(snprintf(pOutBuffer, nOutBufferSize, "{\"motors\":["));
+
+	for (uint32_t nMotor = 0; nMotor < l6470dmxstatus::MAX_MOTORS; nMotor++) {
+		l6470dmxstatus::Snapshot snapshot;
+
+		if (!pStatus->Read(nMotor, snapshot)) {
+			continue;
+		}
+
+		if (nLength >= nOutBufferSize) {
+			break;
+		}
+
+		nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength,
+				"{\"motor\":%u,\"position\":%d,\"speed\":%u,\"busy\":%d,\"status\":\"%04x\",\"alarm\":{\"uvlo\":%d,\"thermal_warning\":%d,\"thermal_shutdown\":%d,\"overcurrent\":%d,\"stall\":%d},\"age\":%u},",
+				static_cast<unsigned int>(nMotor),
+				static_cast<int>(snapshot.nPosition),
+				static_cast<unsigned int>(snapshot.nSpeed),
+				(snapshot.nStatus & L6470_STATUS_BUSY) == 0,	// Active low
+				static_cast<unsigned int>(snapshot.nStatus),
+				(snapshot.nAlarms & L6470_STATUS_UVLO) != 0,
+				(snapshot.nAlarms & L6470_STATUS_TH_WRN) != 0,
+				(snapshot.nAlarms & L6470_STATUS_TH_SD) != 0,
+				(snapshot.nAlarms & L6470_STATUS_OCD) != 0,
+				(snapshot.nAlarms & (L6470_STATUS_STEP_LOSS_A | L6470_STATUS_STEP_LOSS_B)) != 0,
+				static_cast<unsigned int>(Hardware::Get()->Millis() - snapshot.nMillis)));
+	}
+
+	if (nLength >= nOutBufferSize) {
+		return nOutBufferSize;
+	}
+
+	if (pOutBuffer[nLength - 1] == ',') {
+		nLength--;
+	}
+
+	nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength, "]}"));
+
+	return nLength < nOutBufferSize ? nLength : nOutBufferSize;
+}
+}  // namespace stepper
+}  // namespace remoteconfig
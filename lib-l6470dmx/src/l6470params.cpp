@@ -24,6 +24,7 @@
  */
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <cstdio>
 #include <cassert>
@@ -35,11 +36,29 @@
 #include "l6470dmxconst.h"
 
 #include "readconfigfile.h"
-#include "sscan.h"
+#include "propertiesschema.h"
 #include "propertiesbuilder.h"
 
 #include "debug.h"
 
+namespace {
+using namespace properties::schema;
+
+constexpr Key s_Keys[] = {
+	Float(L6470ParamsConst::MIN_SPEED, offsetof(l6470params::Params, fMinSpeed), l6470params::Mask::MIN_SPEED),
+	Float(L6470ParamsConst::MAX_SPEED, offsetof(l6470params::Params, fMaxSpeed), l6470params::Mask::MAX_SPEED),
+	Float(L6470ParamsConst::ACC, offsetof(l6470params::Params, fAcc), l6470params::Mask::ACC),
+	Float(L6470ParamsConst::DEC, offsetof(l6470params::Params, fDec), l6470params::Mask::DEC),
+	Uint8(L6470ParamsConst::KVAL_HOLD, offsetof(l6470params::Params, nKvalHold), l6470params::Mask::KVAL_HOLD),
+	Uint8(L6470ParamsConst::KVAL_RUN, offsetof(l6470params::Params, nKvalRun), l6470params::Mask::KVAL_RUN),
+	Uint8(L6470ParamsConst::KVAL_ACC, offsetof(l6470params::Params, nKvalAcc), l6470params::Mask::KVAL_ACC),
+	Uint8(L6470ParamsConst::KVAL_DEC, offsetof(l6470params::Params, nKvalDec), l6470params::Mask::KVAL_DEC),
+	Uint8(L6470ParamsConst::MICRO_STEPS, offsetof(l6470params::Params, nMicroSteps), l6470params::Mask::MICRO_STEPS),
+};
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 L6470Params::L6470Params() {
 	memset( &m_Params, 0, sizeof(struct l6470params::Params));
 
@@ -125,62 +144,7 @@ void L6470Params::Save(uint32_t nMotorIndex, char *pBuffer, uint32_t nLength, ui
 void L6470Params::callbackFunction(const char *pLine) {
 	assert(pLine != nullptr);
 
-	uint8_t nValue8;
-	float fValue;
-
-	if (Sscan::Float(pLine, L6470ParamsConst::MIN_SPEED, fValue) == Sscan::OK) {
-		m_Params.fMinSpeed = fValue;
-		m_Params.nSetList |= l6470params::Mask::MIN_SPEED;
-		return;
-	}
-
-	if (Sscan::Float(pLine, L6470ParamsConst::MAX_SPEED, fValue) == Sscan::OK) {
-		m_Params.fMaxSpeed = fValue;
-		m_Params.nSetList |= l6470params::Mask::MAX_SPEED;
-		return;
-	}
-
-	if (Sscan::Float(pLine, L6470ParamsConst::ACC, fValue) == Sscan::OK) {
-		m_Params.fAcc = fValue;
-		m_Params.nSetList |= l6470params::Mask::ACC;
-		return;
-	}
-
-	if (Sscan::Float(pLine, L6470ParamsConst::DEC, fValue) == Sscan::OK) {
-		m_Params.fDec = fValue;
-		m_Params.nSetList |= l6470params::Mask::DEC;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, L6470ParamsConst::KVAL_HOLD, nValue8) == Sscan::OK) {
-		m_Params.nKvalHold = nValue8;
-		m_Params.nSetList |= l6470params::Mask::KVAL_HOLD;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, L6470ParamsConst::KVAL_RUN, nValue8) == Sscan::OK) {
-		m_Params.nKvalRun = nValue8;
-		m_Params.nSetList |= l6470params::Mask::KVAL_RUN;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, L6470ParamsConst::KVAL_ACC, nValue8) == Sscan::OK) {
-		m_Params.nKvalAcc = nValue8;
-		m_Params.nSetList |= l6470params::Mask::KVAL_ACC;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, L6470ParamsConst::KVAL_DEC, nValue8) == Sscan::OK) {
-		m_Params.nKvalDec = nValue8;
-		m_Params.nSetList |= l6470params::Mask::KVAL_DEC;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, L6470ParamsConst::MICRO_STEPS, nValue8) == Sscan::OK) {
-		m_Params.nMicroSteps = nValue8;
-		m_Params.nSetList |= l6470params::Mask::MICRO_STEPS;
-		return;
-	}
+	m_Params.nSetList |= s_Schema.Parse(pLine, &m_Params);
 }
 
 void L6470Params::Set(L6470 *pL6470) {
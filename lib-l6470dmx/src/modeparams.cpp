@@ -29,6 +29,7 @@
 #endif
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <cstdio>
 #include <cassert>
@@ -45,11 +46,24 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertiesschema.h"
 #include "parse.h"
 #include "propertiesbuilder.h"
 
 #include "debug.h"
 
+namespace {
+using namespace properties::schema;
+
+constexpr Key s_Keys[] = {
+	Uint8(ModeParamsConst::DMX_MODE, offsetof(modeparams::Params, nDmxMode), modeparams::Mask::DMX_MODE, 0, L6470DMXMODE_UNDEFINED - 1),
+	Uint32(ModeParamsConst::MAX_STEPS, offsetof(modeparams::Params, nMaxSteps), modeparams::Mask::MAX_STEPS),
+	Float(ModeParamsConst::SWITCH_SPS, offsetof(modeparams::Params, fSwitchStepsPerSec), modeparams::Mask::SWITCH_SPS),
+};
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 using namespace lightset;
 
 ModeParams::ModeParams() {
@@ -124,20 +138,17 @@ void ModeParams::Load(uint32_t nMotorIndex, const char *pBuffer, uint32_t nLengt
 void ModeParams::callbackFunction(const char *pLine) {
 	assert(pLine != nullptr);
 
-	float fValue;
+	const auto nMask = s_Schema.Parse(pLine, &m_Params);
+
+	if (nMask != 0) {
+		m_Params.nSetList |= nMask;
+		return;
+	}
+
 	char value[128];
 	uint32_t nLength;
 	uint8_t nValue8;
 	uint16_t nValue16;
-	uint32_t nValue32;
-
-	if (Sscan::Uint8(pLine, ModeParamsConst::DMX_MODE, nValue8) == Sscan::OK) {
-		if (nValue8 < L6470DMXMODE_UNDEFINED) {
-			m_Params.nDmxMode = nValue8;
-			m_Params.nSetList |= modeparams::Mask::DMX_MODE;
-		}
-		return;
-	}
 
 	if (Sscan::Uint16(pLine, LightSetParamsConst::DMX_START_ADDRESS, nValue16) == Sscan::OK) {
 		if ((nValue16 != 0) && (nValue16 <= dmx::UNIVERSE_SIZE)) {
@@ -155,12 +166,6 @@ void ModeParams::callbackFunction(const char *pLine) {
 		m_Params.nSetList |= (nMask << modeparams::Mask::SLOT_INFO_SHIFT);
 	}
 
-	if (Sscan::Uint32(pLine, ModeParamsConst::MAX_STEPS, nValue32) == Sscan::OK) {
-		m_Params.nMaxSteps = nValue32;
-		m_Params.nSetList |= modeparams::Mask::MAX_STEPS;
-		return;
-	}
-
 	nLength = 5; //  copy, reset
 	if (Sscan::Char(pLine, ModeParamsConst::SWITCH_ACT, value, nLength) == Sscan::OK) {
 		if (nLength == 4) {
@@ -196,12 +201,6 @@ void ModeParams::callbackFunction(const char *pLine) {
 		}
 	}
 
-	if (Sscan::Float(pLine, ModeParamsConst::SWITCH_SPS, fValue) == Sscan::OK) {
-		m_Params.fSwitchStepsPerSec = fValue;
-		m_Params.nSetList |= modeparams::Mask::SWITCH_SPS;
-		return;
-	}
-
 	if (Sscan::Uint8(pLine, ModeParamsConst::SWITCH, nValue8) == Sscan::OK) {
 		if (nValue8 == 0) {
 			m_Params.bSwitch = false;
@@ -2,7 +2,7 @@
  * @file motorparams.cpp
  *
  */
-/* Copyright (C) 2017-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -33,6 +33,7 @@
 #endif
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <cstdio>
 #include <cassert>
@@ -44,11 +45,25 @@
 #include "l6470dmxstore.h"
 
 #include "readconfigfile.h"
-#include "sscan.h"
+#include "propertiesschema.h"
 #include "propertiesbuilder.h"
 
 #include "debug.h"
 
+namespace {
+using namespace properties::schema;
+
+constexpr Key s_Keys[] = {
+	Float(MotorParamsConst::STEP_ANGEL, offsetof(motorparams::Params, fStepAngel), motorparams::Mask::STEP_ANGEL, true),
+	Float(MotorParamsConst::VOLTAGE, offsetof(motorparams::Params, fVoltage), motorparams::Mask::VOLTAGE),
+	Float(MotorParamsConst::CURRENT, offsetof(motorparams::Params, fCurrent), motorparams::Mask::CURRENT),
+	Float(MotorParamsConst::RESISTANCE, offsetof(motorparams::Params, fResistance), motorparams::Mask::RESISTANCE),
+	Float(MotorParamsConst::INDUCTANCE, offsetof(motorparams::Params, fInductance), motorparams::Mask::INDUCTANCE),
+};
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 #ifndef M_PI
 #define M_PI	3.14159265358979323846
 #endif
@@ -138,39 +153,9 @@ void MotorParams::Save(uint32_t nMotorIndex, char *pBuffer, uint32_t nLength, ui
 }
 
 void MotorParams::callbackFunction(const char *pLine) {
-	float f;
+	assert(pLine != nullptr);
 
-	if (Sscan::Float(pLine, MotorParamsConst::STEP_ANGEL, f) == Sscan::OK) {
-		if (f != 0) {
-			m_Params.fStepAngel = f;
-			m_Params.nSetList |= motorparams::Mask::STEP_ANGEL;
-		}
-		return;
-	}
-
-	if (Sscan::Float(pLine, MotorParamsConst::VOLTAGE, f) == Sscan::OK) {
-		m_Params.fVoltage = f;
-		m_Params.nSetList |= motorparams::Mask::VOLTAGE;
-		return;
-	}
-
-	if (Sscan::Float(pLine, MotorParamsConst::CURRENT, f) == Sscan::OK) {
-		m_Params.fCurrent = f;
-		m_Params.nSetList |= motorparams::Mask::CURRENT;
-		return;
-	}
-
-	if (Sscan::Float(pLine, MotorParamsConst::RESISTANCE, f) == Sscan::OK) {
-		m_Params.fResistance = f;
-		m_Params.nSetList |= motorparams::Mask::RESISTANCE;
-		return;
-	}
-
-	if (Sscan::Float(pLine, MotorParamsConst::INDUCTANCE, f) == Sscan::OK) {
-		m_Params.fInductance = f;
-		m_Params.nSetList |= motorparams::Mask::INDUCTANCE;
-		return;
-	}
+	m_Params.nSetList |= s_Schema.Parse(pLine, &m_Params);
 }
 
 void MotorParams::Set(L6470 *pL6470) {
@@ -29,13 +29,16 @@
 #include <cassert>
 
 #include "sparkfundmx.h"
+#include "sparkfundmxconst.h"
 #include "sparkfundmx_internal.h"
 #include "sparkfundmxparams.h"
 #include "sparkfundmxparamsconst.h"
+#include "l6470dmxconst.h"
 
 #include "lightset.h"
 
 #include "readconfigfile.h"
+#include "propertiesbundle.h"
 #include "sscan.h"
 
 #include "l6470params.h"
@@ -49,11 +52,43 @@
 #include "hal_gpio.h"
 
 #include "hardware.h"
+#include "display.h"
 
 #include "debug.h"
 
 using namespace lightset;
 
+#if !defined(DISABLE_FS)
+/*
+ * All sections are parsed into the config store in one go, whether or not the motor
+ * is connected now. Otherwise a motor that comes back after an unchanged boot
+ * would use stale values from the store.
+ */
+static void load_bundle(properties::Bundle& bundle) {
+	DEBUG_ENTRY
+
+	SparkFunDmxParams sparkFunDmxParams;
+	sparkFunDmxParams.Load();
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		sparkFunDmxParams.Load(i);
+
+		ModeParams modeParams;
+		modeParams.Load(i);
+
+		MotorParams motorParams;
+		motorParams.Load(i);
+
+		L6470Params l6470Params;
+		l6470Params.Load(i);
+	}
+
+	bundle.SetUnchanged();
+
+	DEBUG_EXIT
+}
+#endif
+
 SparkFunDmx::SparkFunDmx(): m_nDmxStartAddress(dmx::ADDRESS_INVALID) {
 	DEBUG_ENTRY;
 
@@ -148,6 +183,26 @@ void SparkFunDmx::Stop([[maybe_unused]] uint32_t nPortIndex) {
 
 void SparkFunDmx::ReadConfigFiles() {
 	DEBUG_ENTRY;
+#if !defined(DISABLE_FS)
+	/*
+	 * When the bundle is open, all Params below are served from it, or copied
+	 * from the config store when the bundle did not change since the last boot.
+	 */
+	properties::Bundle bundle;
+	properties::bundle::Stamp stamp;
+
+	SparkFunDmxParamsStore::CopyStamp(stamp);
+
+	if (bundle.Open(L6470DmxConst::FILE_NAME_BUNDLE, stamp)) {
+		printf("%s: %s\n", L6470DmxConst::FILE_NAME_BUNDLE, bundle.IsUnchanged() ? "unchanged" : "changed");
+
+		if (!bundle.IsUnchanged()) {
+			load_bundle(bundle);
+		}
+
+		SparkFunDmxParamsStore::UpdateStamp(bundle.GetStamp());
+	}
+#endif
 #if !defined (H3)
 	m_bIsGlobalSpiCsSet = false;
 #else
@@ -248,6 +303,7 @@ void SparkFunDmx::ReadConfigFiles() {
 						l6470Params.Set(m_pAutoDriver[i]);
 
 						m_pAutoDriver[i]->Dump();
+						m_pAutoDriver[i]->SetShadowMaxAge(sparkfundmx::SHADOW_MAX_AGE_POLLS * m_nStatusPollMillis);
 
 						m_pL6470DmxModes[i] = new L6470DmxModes(static_cast<TL6470DmxModes>(m_nDmxMode), m_nDmxStartAddressMode, m_pAutoDriver[i], m_pMotorParams[i], m_pModeParams[i]);
 						assert(m_pL6470DmxModes[i] != nullptr);
@@ -327,53 +383,215 @@ void SparkFunDmx::ReadConfigFiles() {
 		}
 	}
 
+	/*
+	 * So the status snapshots are available before the main loop runs
+	 */
+	m_nStatusPollLast = Hardware::Get()->Millis();
+	StatusPoll(m_nStatusPollLast);
+
 	DEBUG_EXIT;
 }
 
-void SparkFunDmx::SetData([[maybe_unused]] uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, [[maybe_unused]] const bool doUpdate) {
+void SparkFunDmx::SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const bool doUpdate) {
+	SetDataRange(nPortIndex, pData, nLength, 0, lightset::dmx::UNIVERSE_SIZE - 1, doUpdate);
+}
+
+void SparkFunDmx::SetDataRange([[maybe_unused]] uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const uint32_t nSlotFirst, const uint32_t nSlotLast, const bool doUpdate) {
 	DEBUG_ENTRY;
 	assert(pData != nullptr);
 	assert(nLength <= lightset::dmx::UNIVERSE_SIZE);
 
-	bool bIsDmxDataChanged[SPARKFUN_DMX_MAX_MOTORS];
+	/*
+	 * A doUpdate = true frame while targets are staged: the synchronization has stopped
+	 * (e.g. the ArtSync time-out) without a Sync, so the staged targets are released first.
+	 */
+	if (doUpdate && (m_nStagedMask != 0)) {
+		Release();
+	}
 
-	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
-		if (m_pL6470DmxModes[i] != nullptr) {
-			bIsDmxDataChanged[i] = m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength);
+	if (!lightset::dmx::is_touched(nSlotFirst, nSlotLast, m_nDmxStartAddress, m_nDmxFootprint)) {
+		DEBUG_EXIT;
+		return;
+	}
 
-			if(bIsDmxDataChanged[i]) {
-				m_pL6470DmxModes[i]->HandleBusy();
+	/*
+	 * With doUpdate = false (ArtSync / E1.31 synchronization) the new targets
+	 * are only captured here, the motors are released together on Sync.
+	 */
+	if (!doUpdate) {
+		for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+			if ((m_pL6470DmxModes[i] != nullptr) && lightset::dmx::is_touched(nSlotFirst, nSlotLast, m_pL6470DmxModes[i]->GetDmxStartAddress(), m_pL6470DmxModes[i]->GetDmxFootPrint())) {
+				if (m_pL6470DmxModes[i]->StageDmxData(pData, nLength)) {
+					m_nStagedMask |= (1U << i);
+				} else {
+					m_nStagedMask &= ~(1U << i);
+				}
 			}
-		} else {
-			bIsDmxDataChanged[i] = false;
 		}
+
+		DEBUG_PRINTF("m_nStagedMask=%x", m_nStagedMask);
+		DEBUG_EXIT;
+		return;
+	}
+
+	AutoDriver::ChainBegin();
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if ((m_pL6470DmxModes[i] != nullptr) && lightset::dmx::is_touched(nSlotFirst, nSlotLast, m_pL6470DmxModes[i]->GetDmxStartAddress(), m_pL6470DmxModes[i]->GetDmxFootPrint())) {
+			const auto bIsDmxDataChanged = m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength);
+
+			if (bIsDmxDataChanged) {
+				m_pL6470DmxModes[i]->QueueDmxData();
+			}
 #ifndef NDEBUG
-		printf("bIsDmxDataChanged[%d]=%d\n", i, bIsDmxDataChanged[i]);
+			printf("bIsDmxDataChanged[%d]=%d\n", i, bIsDmxDataChanged);
 #endif
+		}
+	}
+
+	AutoDriver::ChainEnd();
+
+	/*
+	 * Motors which are not busy get their command right away,
+	 * the others are serviced from SparkFunDmx::Run
+	 * The status poll is not done here, so it does not add SPI traffic to the DMX path.
+	 */
+	Service(Hardware::Get()->Millis());
+
+	DEBUG_EXIT;
+}
+
+void SparkFunDmx::Run() {
+	const auto nMillis = Hardware::Get()->Millis();
+
+	if ((nMillis - m_nStatusPollLast) >= m_nStatusPollMillis) {
+		m_nStatusPollLast = nMillis;
+		StatusPoll(nMillis);
+	}
+
+	Service(nMillis);
+}
+
+void SparkFunDmx::SetStatusPollMillis(const uint32_t nStatusPollMillis) {
+	m_nStatusPollMillis = std::max(static_cast<uint32_t>(1), nStatusPollMillis);
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if (m_pL6470DmxModes[i] != nullptr) {
+			m_pAutoDriver[i]->SetShadowMaxAge(sparkfundmx::SHADOW_MAX_AGE_POLLS * m_nStatusPollMillis);
+		}
 	}
+}
+
+/**
+ * One daisy-chain frame per register for all boards, see AutoDriver::ShadowPoll.
+ * The snapshots are then taken from the freshly filled register shadow.
+ */
+void SparkFunDmx::StatusPoll(const uint32_t nMillis) {
+	AutoDriver::ShadowPoll();
+
+	uint32_t nAlarmsMask = 0;
 
 	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			while (m_pL6470DmxModes[i]->BusyCheck())
-				;
+		if (m_pL6470DmxModes[i] == nullptr) {
+			continue;
+		}
+
+		auto *pAutoDriver = m_pAutoDriver[i];
+
+		l6470dmxstatus::Snapshot snapshot;
+		snapshot.nMillis = nMillis;
+		snapshot.nPosition = l6470dmxstatus::get_position(static_cast<uint32_t>(pAutoDriver->getParam(L6470_PARAM_ABS_POS)));
+		snapshot.nSpeed = static_cast<uint32_t>(pAutoDriver->getParam(L6470_PARAM_SPEED));
+		snapshot.nStatus = static_cast<uint16_t>(pAutoDriver->getParam(L6470_PARAM_STATUS));
+		snapshot.nAlarms = l6470dmxstatus::get_alarms(snapshot.nStatus);
+
+		m_Status.Publish(i, snapshot);
+
+		if (snapshot.nAlarms != 0) {
+			nAlarmsMask |= (1U << i);
 		}
 	}
 
-	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			m_pL6470DmxModes[i]->DmxData(pData, nLength);
+	if (nAlarmsMask == m_nAlarmsMask) {
+		return;
+	}
+
+	const auto nRaised = nAlarmsMask & ~m_nAlarmsMask;
+	m_nAlarmsMask = nAlarmsMask;
+
+	if (nRaised != 0) {
+		char aText[20];
+		snprintf(aText, sizeof(aText), "Motor %u alarm", static_cast<unsigned>(__builtin_ctz(nRaised)));
+		Display::Get()->TextStatus(aText);
+		printf("%s\n", aText);
+	} else if (nAlarmsMask == 0) {
+		Display::Get()->TextStatus(SparkFunDmxConst::MSG_ALARMS_CLEARED);
+	}
+}
+
+void SparkFunDmx::Service(const uint32_t nMillis) {
+	AutoDriver::ChainBegin();
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if (m_pL6470DmxModes[i] != nullptr) {
+			m_pL6470DmxModes[i]->Run();
+			m_pL6470DmxModes[i]->Update(nMillis);
 		}
 	}
 
-	DEBUG_EXIT;
+	AutoDriver::ChainEnd();
+}
+
+/**
+ * The busy state is sampled before the chain is started, as BusyCheck is an SPI read
+ * which would flush the chain. The motors which are not busy then get their move command
+ * in one daisy-chain burst, except for the modes which read the position first (3, 4 and 5).
+ * HandleBusy is called for these motors before the chain as well, as it reads the busy state.
+ * The busy motors get their HandleBusy command and are issued from SparkFunDmx::Run.
+ */
+void SparkFunDmx::Release() {
+	if (m_nStagedMask == 0) {
+		return;
+	}
+
+	uint32_t nBusyMask = 0;
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if ((m_nStagedMask & (1U << i)) != 0) {
+			m_pL6470DmxModes[i]->ReleaseStagedDmxData();
+
+			if (m_pL6470DmxModes[i]->BusyCheck()) {
+				nBusyMask |= (1U << i);
+			} else {
+				// As QueueDmxData does for the busy motors, so the busy state of the mode is not stale
+				m_pL6470DmxModes[i]->HandleBusy();
+			}
+		}
+	}
+
+	AutoDriver::ChainBegin();
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if ((m_nStagedMask & (1U << i)) != 0) {
+			if ((nBusyMask & (1U << i)) != 0) {
+				m_pL6470DmxModes[i]->QueueDmxData();
+			} else {
+				m_pL6470DmxModes[i]->IssueDmxData();
+			}
+		}
+	}
+
+	AutoDriver::ChainEnd();
+
+	m_nStagedMask = 0;
 }
 
 void SparkFunDmx::Sync([[maybe_unused]] uint32_t const nPortIndex) {
-	//TODO Implement Sync
+	Release();
 }
 
 void SparkFunDmx::Sync() {
-	//TODO Implement Sync
+	Release();
 }
 
 bool SparkFunDmx::SetDmxStartAddress(uint16_t nDmxStartAddress) {
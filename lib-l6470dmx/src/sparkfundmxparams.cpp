@@ -2,7 +2,7 @@
  * @file sparkfundmxparams.cpp
  *
  */
-/* Copyright (C) 2019-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -29,6 +29,7 @@
 #endif
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #ifndef NDEBUG
  #include <cstdio>
@@ -44,11 +45,26 @@
 #include "sparkfundmx_internal.h"
 
 #include "readconfigfile.h"
-#include "sscan.h"
+#include "propertiesschema.h"
 #include "propertiesbuilder.h"
 
 #include "debug.h"
 
+namespace {
+using namespace properties::schema;
+
+constexpr Key s_Keys[] = {
+	Uint8(SparkFunDmxParamsConst::POSITION, offsetof(sparkfundmxparams::Params, nPosition), sparkfundmxparams::Mask::POSITION, 0, SPARKFUN_DMX_MAX_MOTORS - 1),
+#if !defined (H3)
+	Uint8(SparkFunDmxParamsConst::SPI_CS, offsetof(sparkfundmxparams::Params, nSpiCs), sparkfundmxparams::Mask::SPI_CS),
+#endif
+	Uint8(SparkFunDmxParamsConst::RESET_PIN, offsetof(sparkfundmxparams::Params, nResetPin), sparkfundmxparams::Mask::RESET_PIN),
+	Uint8(SparkFunDmxParamsConst::BUSY_PIN, offsetof(sparkfundmxparams::Params, nBusyPin), sparkfundmxparams::Mask::BUSY_PIN),
+};
+
+constexpr Table s_Schema(s_Keys);
+}  // namespace
+
 SparkFunDmxParams::SparkFunDmxParams() {
 	DEBUG_ENTRY
 
@@ -149,35 +165,7 @@ void SparkFunDmxParams::Load(uint32_t nMotorIndex, const char *pBuffer, uint32_t
 void SparkFunDmxParams::callbackFunction(const char *pLine) {
 	assert(pLine != nullptr);
 
-	uint8_t nValue8;
-
-	if (Sscan::Uint8(pLine, SparkFunDmxParamsConst::POSITION, nValue8) == Sscan::OK) {
-		if (nValue8 < SPARKFUN_DMX_MAX_MOTORS) {
-			m_Params.nPosition = nValue8;
-			m_Params.nSetList |= sparkfundmxparams::Mask::POSITION;
-		}
-		return;
-	}
-
-#if !defined (H3)
-	if (Sscan::Uint8(pLine, SparkFunDmxParamsConst::SPI_CS, nValue8) == Sscan::OK) {
-		m_Params.nSpiCs = nValue8;
-		m_Params.nSetList |= sparkfundmxparams::Mask::SPI_CS;
-		return;
-	}
-#endif
-
-	if (Sscan::Uint8(pLine, SparkFunDmxParamsConst::RESET_PIN, nValue8) == Sscan::OK) {
-		m_Params.nResetPin = nValue8;
-		m_Params.nSetList |= sparkfundmxparams::Mask::RESET_PIN;
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, SparkFunDmxParamsConst::BUSY_PIN, nValue8) == Sscan::OK) {
-		m_Params.nBusyPin = nValue8;
-		m_Params.nSetList |= sparkfundmxparams::Mask::BUSY_PIN;
-		return;
-	}
+	m_Params.nSetList |= s_Schema.Parse(pLine, &m_Params);
 }
 
 void SparkFunDmxParams::Builder(const struct sparkfundmxparams::Params *pParams, char *pBuffer, uint32_t nLength, uint32_t& nSize, uint32_t nMotorIndex) {
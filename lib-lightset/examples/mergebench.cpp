@@ -0,0 +1,158 @@
+/**
+ * @file mergebench.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <time.h>
+
+#include "lightsetmerge.h"
+
+/**
+ * Compares the fused merge kernels of lightsetmerge.h with the code they replaced:
+ * a memcpy into the source buffer followed by a scalar std::max loop.
+ * The kernels also track the dirty range, the reference code does not.
+ *
+ * Usage: mergebench [slots] [iterations]
+ */
+
+static constexpr uint32_t UNIVERSE_SIZE = 512;
+
+static uint8_t s_In[UNIVERSE_SIZE];
+static uint8_t s_Other[UNIVERSE_SIZE];
+static uint8_t s_Source[UNIVERSE_SIZE];
+static uint8_t s_Output[UNIVERSE_SIZE];
+static uint8_t s_Reference[UNIVERSE_SIZE];
+
+/*
+ * The previous IMergeSourceA, kept out of line so that the compiler cannot
+ * assume the buffers do not alias, as in lightset::Data.
+ */
+static void __attribute__((noinline)) htp_reference(uint8_t *pSource, uint8_t *pOutput, const uint8_t *pIn, const uint8_t *pOther, const uint32_t nLength) {
+	memcpy(pSource, pIn, nLength);
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		pOutput[i] = std::max(pSource[i], pOther[i]);
+	}
+}
+
+static void __attribute__((noinline)) htp_kernel(uint8_t *pSource, uint8_t *pOutput, const uint8_t *pIn, const uint8_t *pOther, const uint32_t nLength) {
+	uint32_t nDirtyFirst = UNIVERSE_SIZE;
+	uint32_t nDirtyLast = 0;
+	lightset::merge::htp(pSource, pOutput, pIn, pOther, nLength, nDirtyFirst, nDirtyLast);
+	__asm__ __volatile__("" : : "r" (nDirtyFirst), "r" (nDirtyLast));
+}
+
+static void __attribute__((noinline)) ltp_reference(uint8_t *pSource, uint8_t *pOutput, const uint8_t *pIn, const uint8_t *, const uint32_t nLength) {
+	memcpy(pSource, pIn, nLength);
+	memcpy(pOutput, pSource, nLength);
+}
+
+static void __attribute__((noinline)) ltp_kernel(uint8_t *pSource, uint8_t *pOutput, const uint8_t *pIn, const uint8_t *, const uint32_t nLength) {
+	uint32_t nDirtyFirst = UNIVERSE_SIZE;
+	uint32_t nDirtyLast = 0;
+	lightset::merge::ltp(pSource, pOutput, pIn, nLength, nDirtyFirst, nDirtyLast);
+	__asm__ __volatile__("" : : "r" (nDirtyFirst), "r" (nDirtyLast));
+}
+
+typedef void (*merge_t)(uint8_t *, uint8_t *, const uint8_t *, const uint8_t *, const uint32_t);
+
+static double nanos_per_call(merge_t pMerge, const uint32_t nLength, const uint32_t nIterations) {
+	struct timespec start, end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (uint32_t n = 0; n < nIterations; n++) {
+		// Change one slot per frame, as a console does, so that nothing can be hoisted out of the loop
+		s_In[n % nLength] = static_cast<uint8_t>(n);
+		pMerge(s_Source, s_Output, s_In, s_Other, nLength);
+		__asm__ __volatile__("" : : "r" (s_Output) : "memory");
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	const auto nNanos = static_cast<double>(end.tv_sec - start.tv_sec) * 1e9 + static_cast<double>(end.tv_nsec - start.tv_nsec);
+	return nNanos / nIterations;
+}
+
+static bool verify(merge_t pReference, merge_t pKernel, const uint32_t nLength) {
+	memset(s_Source, 0, sizeof(s_Source));
+	memset(s_Reference, 0, sizeof(s_Reference));
+	pReference(s_Source, s_Reference, s_In, s_Other, nLength);
+
+	memset(s_Source, 0, sizeof(s_Source));
+	memset(s_Output, 0, sizeof(s_Output));
+	pKernel(s_Source, s_Output, s_In, s_Other, nLength);
+
+	return (memcmp(s_Output, s_Reference, sizeof(s_Output)) == 0) && (memcmp(s_Source, s_In, nLength) == 0);
+}
+
+int main(int argc, char **argv) {
+	const uint32_t nLength = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : UNIVERSE_SIZE;
+	const uint32_t nIterations = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : 1000000;
+
+	if ((nLength == 0) || (nLength > UNIVERSE_SIZE) || (nIterations == 0)) {
+		fprintf(stderr, "Usage: %s [slots 1-%u] [iterations]\n", argv[0], UNIVERSE_SIZE);
+		return EXIT_FAILURE;
+	}
+
+	srand(1);
+
+	for (uint32_t i = 0; i < UNIVERSE_SIZE; i++) {
+		s_In[i] = static_cast<uint8_t>(rand());
+		s_Other[i] = static_cast<uint8_t>(rand());
+	}
+
+#if defined (__ARM_NEON)
+	puts("Kernel: NEON");
+#elif defined (__AVX2__)
+	puts("Kernel: AVX2");
+#elif defined (__SSE2__)
+	puts("Kernel: SSE2");
+#else
+	puts("Kernel: portable");
+#endif
+
+	if (!verify(htp_reference, htp_kernel, nLength) || !verify(ltp_reference, ltp_kernel, nLength)) {
+		puts("Kernel output differs from the reference");
+		return EXIT_FAILURE;
+	}
+
+	printf("Slots: %u, iterations: %u\n", nLength, nIterations);
+
+	const auto nHtpReference = nanos_per_call(htp_reference, nLength, nIterations);
+	const auto nHtpKernel = nanos_per_call(htp_kernel, nLength, nIterations);
+	const auto nLtpReference = nanos_per_call(ltp_reference, nLength, nIterations);
+	const auto nLtpKernel = nanos_per_call(ltp_kernel, nLength, nIterations);
+
+	printf("HTP memcpy + std::max : %8.1f ns\n", nHtpReference);
+	printf("HTP merge::htp        : %8.1f ns (%.1fx)\n", nHtpKernel, nHtpReference / nHtpKernel);
+	printf("LTP memcpy + memcpy   : %8.1f ns\n", nLtpReference);
+	printf("LTP merge::ltp        : %8.1f ns (%.1fx)\n", nLtpKernel, nLtpReference / nLtpKernel);
+
+	return EXIT_SUCCESS;
+}
@@ -38,6 +38,25 @@ static constexpr uint16_t ADDRESS_INVALID = 0xFFFF;
 static constexpr uint32_t START_ADDRESS_DEFAULT = 1;
 static constexpr uint32_t UNIVERSE_SIZE = 512;
 static constexpr uint32_t MAX_VALUE = 255;
+
+/**
+ * Does the dirty range [nSlotFirst, nSlotLast] (0-based) touch the footprint
+ * starting at nDmxStartAddress (1-based)? An unknown footprint is always touched.
+ */
+inline bool is_touched(const uint32_t nSlotFirst, const uint32_t nSlotLast, const uint32_t nDmxStartAddress, const uint32_t nDmxFootprint) {
+	if (nSlotFirst > nSlotLast) {
+		return false;
+	}
+
+	if ((nDmxFootprint == 0) || (nDmxStartAddress == 0)) {
+		return true;
+	}
+
+	const auto nFootprintFirst = nDmxStartAddress - 1;
+	const auto nFootprintLast = nFootprintFirst + nDmxFootprint - 1;
+
+	return (nSlotFirst <= nFootprintLast) && (nSlotLast >= nFootprintFirst);
+}
 }
 namespace node {
 static constexpr uint32_t LABEL_NAME_LENGTH = 18;
@@ -186,6 +205,14 @@ public:
 	virtual void Start(const uint32_t nPortIndex)= 0;
 	virtual void Stop(const uint32_t nPortIndex)= 0;
 	virtual void SetData(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const bool doUpdate = true)= 0;
+	/**
+	 * As SetData, but only the slots [nSlotFirst, nSlotLast] (0-based) differ
+	 * from the data handed over previously. nSlotFirst > nSlotLast is an unchanged frame.
+	 * The default ignores the range.
+	 */
+	virtual void SetDataRange(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, [[maybe_unused]] const uint32_t nSlotFirst, [[maybe_unused]] const uint32_t nSlotLast, const bool doUpdate = true) {
+		SetData(nPortIndex, pData, nLength, doUpdate);
+	}
 	/**
 	 * This is used for preparing the lightset output for a SYNC
 	 * Typically used with DMX512 output
@@ -32,6 +32,8 @@
 #include <cassert>
 
 #include "lightset.h"
+#include "lightsetmerge.h"
+#include "lightsetsource.h"
 
 #if defined (GD32)
 /**
@@ -46,10 +48,20 @@
 #else
 # define SECTION_LIGHTSET
 #endif
+#if !defined (LIGHTSET_PORTS)
+# define LIGHTSET_PORTS 0
+#endif
+
 namespace lightset {
 
 class Data {
 public:
+#if (LIGHTSET_PORTS == 0)
+	static constexpr uint32_t PORTS = 1;	// ISO C++ forbids zero-size array
+#else
+	static constexpr uint32_t PORTS = LIGHTSET_PORTS;
+#endif
+
 //	Data(const Data&) = delete;
 
 	static Data& Get() {
@@ -57,20 +69,71 @@ public:
 		return instance;
 	}
 
-	static void SetSourceA(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength) {
-		Get().IMergeSourceA(nPortIndex, pData, nLength, MergeMode::LTP);
+	/**
+	 * The merge engine for all sources (Art-Net, sACN, local input) of a port.
+	 * The sources with the highest priority are merged into the output, HTP or LTP.
+	 * The data of a lower priority source is kept, so it can take over when the
+	 * higher priority source(s) time out.
+	 * @param nTimeoutMillis sources which did not send data for this time are removed first, 0 is no timeout
+	 */
+	static source::Result Merge(const uint32_t nPortIndex, const source::Id& id, const uint8_t nPriority, const uint32_t nMillis, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode, const uint32_t nTimeoutMillis) {
+		return Get().IMerge(nPortIndex, id, nPriority, nMillis, pData, nLength, mergeMode, nTimeoutMillis);
+	}
+
+	/**
+	 * Call before Merge() for the same packet, with the same nMillis and nTimeoutMillis.
+	 * The timed out sources are removed first, so a source which restarts is not checked against its old sequence.
+	 * Unknown sources are accepted, Merge() takes this sequence number as the reference when it adds the source.
+	 * @return false when the packet is a duplicate or is out of order
+	 */
+	static bool CheckSequence(const uint32_t nPortIndex, const source::Id& id, const uint8_t nSequence, const uint32_t nMillis, const uint32_t nTimeoutMillis, const source::sequence::Wrap wrap = source::sequence::Wrap::FULL) {
+		return Get().ICheckSequence(nPortIndex, id, nSequence, nMillis, nTimeoutMillis, wrap);
 	}
 
-	static void MergeSourceA(const uint32_t nPortIndex, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode) {
-		 Get().IMergeSourceA(nPortIndex, pData, nLength, mergeMode);
+	static const source::sequence::Stats& GetSequenceStats(const uint32_t nPortIndex) {
+		assert(nPortIndex < PORTS);
+		return Get().m_OutputPort[nPortIndex].sources.GetSequenceStats();
+	}
+
+	/**
+	 * @return the slot of the source, source::NONE when the source is not known
+	 */
+	static uint32_t FindSource(const uint32_t nPortIndex, const source::Id& id) {
+		assert(nPortIndex < PORTS);
+		return Get().m_OutputPort[nPortIndex].sources.Find(id);
 	}
 
-	static void SetSourceB(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength) {
-		Get().IMergeSourceB(nPortIndex, pData, nLength, MergeMode::LTP);
+	/**
+	 * @return nullptr when the source is not known
+	 */
+	static source::Entry *GetSource(const uint32_t nPortIndex, const source::Id& id) {
+		return Get().IGetSource(nPortIndex, id);
 	}
 
-	static void MergeSourceB(const uint32_t nPortIndex, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode) {
-		 Get().IMergeSourceB(nPortIndex, pData, nLength, mergeMode);
+	static bool RemoveSource(const uint32_t nPortIndex, const source::Id& id) {
+		return Get().IRemoveSource(nPortIndex, id);
+	}
+
+	static void ClearSources(const uint32_t nPortIndex) {
+		Get().IClearSources(nPortIndex);
+	}
+
+	/**
+	 * @return mask of the removed sources
+	 */
+	static uint32_t Timeout(const uint32_t nPortIndex, const uint32_t nMillis, const uint32_t nTimeoutMillis) {
+		return Get().ITimeout(nPortIndex, nMillis, nTimeoutMillis);
+	}
+
+	static uint32_t GetSourceCount(const uint32_t nPortIndex) {
+		return Get().IGetSourceCount(nPortIndex);
+	}
+
+	/**
+	 * @return true when more than one source is merged into the output
+	 */
+	static bool IsMerging(const uint32_t nPortIndex) {
+		return Get().IIsMerging(nPortIndex);
 	}
 
 	static void Set(LightSet *const pLightSet, uint32_t nPortIndex) {
@@ -101,69 +164,208 @@ public:
 		Get().IRestore(nPortIndex, pData);
 	}
 
+	/**
+	 * For restoring a frame in place, the merge buffer becomes the output.
+	 */
+	static uint8_t *GetRestoreBuffer(const uint32_t nPortIndex) {
+		return Get().IGetRestoreBuffer(nPortIndex);
+	}
+
 private:
 //	Data() {}
 
-	void IMergeSourceA(const uint32_t nPortIndex, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode) {
+	source::Result IMerge(const uint32_t nPortIndex, const source::Id& id, const uint8_t nPriority, const uint32_t nMillis, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode, const uint32_t nTimeoutMillis) {
 		assert(nPortIndex < PORTS);
 		assert(pData != nullptr);
 
-		memcpy(m_OutputPort[nPortIndex].sourceA.data, pData, nLength);
+		assert(nLength <= dmx::UNIVERSE_SIZE);
+
+		auto& outputPort = m_OutputPort[nPortIndex];
+		auto& sources = outputPort.sources;
+
+		if (nTimeoutMillis != 0) {
+			ReleaseOutput(outputPort, sources.Timeout(nMillis, nTimeoutMillis));
+		}
+
+		const auto nSourcesBefore = sources.GetCount();
+		auto nSource = sources.Find(id);
+		const auto isNew = (nSource == source::NONE);
 
-		m_OutputPort[nPortIndex].nLength = nLength;
+		if (isNew) {
+			nSource = sources.Add(id, nMillis, nPriority);
 
-		if (mergeMode == MergeMode::HTP) {
-			for (uint32_t i = 0; i < nLength; i++) {
-				const auto data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-				m_OutputPort[nPortIndex].data[i] = data;
+			if (nSource == source::NONE) {
+				outputPort.bPendingSequence = false;
+				return source::Result::DISCARD;
 			}
 
-			return;
+			if (outputPort.bPendingSequence && (outputPort.pendingId == id)) {
+				sources.SetSequence(nSource, outputPort.nPendingSequence);
+			}
+		}
+
+		outputPort.bPendingSequence = false;
+
+		sources[nSource].nMillis = nMillis;
+		sources[nSource].nPriority = nPriority;
+
+		const auto nOutputMask = sources.GetOutputMask();
+		auto *pSource = outputPort.sourceData[nSource].data;
+
+		if ((nOutputMask & (1U << nSource)) == 0) {
+			// Demoted, the output keeps its last frame instead of following this source
+			ReleaseOutput(outputPort, 1U << nSource);
+			memcpy(pSource, pData, nLength);
+			return source::Result::IGNORED;
 		}
 
-		memcpy(m_OutputPort[nPortIndex].data, pData, nLength);
+		SetLength(outputPort, nLength);
+
+		const auto nOutputs = static_cast<uint32_t>(__builtin_popcount(nOutputMask));
+
+		if (nOutputs == 1) {
+			SetOutput(outputPort, nSource);
+			merge::copy(pSource, pData, nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast);
+		} else {
+			SetOutput(outputPort, source::NONE);
+
+			if (mergeMode == MergeMode::LTP) {
+				merge::ltp(pSource, outputPort.data, pData, nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast);
+			} else if (nOutputs == 2) {
+				const auto nOther = static_cast<uint32_t>(__builtin_ctz(nOutputMask & ~(1U << nSource)));
+				merge::htp(pSource, outputPort.data, pData, outputPort.sourceData[nOther].data, nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast);
+			} else {
+				memcpy(pSource, pData, nLength);
+
+				const uint8_t *pSources[source::MAX];
+				uint32_t nCount = 0;
+
+				for (auto nMask = nOutputMask; nMask != 0; nMask &= (nMask - 1)) {
+					pSources[nCount++] = outputPort.sourceData[__builtin_ctz(nMask)].data;
+				}
+
+				merge::htp(outputPort.data, pSources, nCount, nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast);
+			}
+		}
+
+		if (nSourcesBefore == 0) {
+			return source::Result::FIRST;
+		}
+
+		if (nOutputs == 1) {
+			return source::Result::SET;
+		}
+
+		return isNew ? source::Result::NEW : source::Result::MERGE;
 	}
 
-	void IMergeSourceB(const uint32_t nPortIndex, const uint8_t *pData, const uint32_t nLength, const MergeMode mergeMode) {
+	bool ICheckSequence(const uint32_t nPortIndex, const source::Id& id, const uint8_t nSequence, const uint32_t nMillis, const uint32_t nTimeoutMillis, const source::sequence::Wrap wrap) {
 		assert(nPortIndex < PORTS);
-		assert(pData != nullptr);
 
-		memcpy(m_OutputPort[nPortIndex].sourceB.data, pData, nLength);
+		auto& outputPort = m_OutputPort[nPortIndex];
 
-		m_OutputPort[nPortIndex].nLength = nLength;
+		if (nTimeoutMillis != 0) {
+			ReleaseOutput(outputPort, outputPort.sources.Timeout(nMillis, nTimeoutMillis));
+		}
 
-		if (mergeMode == MergeMode::HTP) {
-			for (uint32_t i = 0; i < nLength; i++) {
-				const auto data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-				m_OutputPort[nPortIndex].data[i] = data;
-			}
+		const auto nSource = outputPort.sources.Find(id);
 
-			return;
+		if (nSource == source::NONE) {
+			outputPort.pendingId = id;
+			outputPort.nPendingSequence = nSequence;
+			outputPort.bPendingSequence = true;
+			return true;
 		}
 
-		memcpy(m_OutputPort[nPortIndex].data, pData, nLength);
+		outputPort.bPendingSequence = false;
+		return outputPort.sources.CheckSequence(nSource, nSequence, wrap);
 	}
 
-	void ISet(LightSet *const pLightSet, const uint32_t nPortIndex) const {
+	source::Entry *IGetSource(const uint32_t nPortIndex, const source::Id& id) {
+		assert(nPortIndex < PORTS);
+
+		auto& sources = m_OutputPort[nPortIndex].sources;
+		const auto nSource = sources.Find(id);
+
+		if (nSource == source::NONE) {
+			return nullptr;
+		}
+
+		return &sources[nSource];
+	}
+
+	bool IRemoveSource(const uint32_t nPortIndex, const source::Id& id) {
+		assert(nPortIndex < PORTS);
+
+		auto& outputPort = m_OutputPort[nPortIndex];
+		const auto nSource = outputPort.sources.Find(id);
+
+		if (nSource == source::NONE) {
+			return false;
+		}
+
+		outputPort.sources.Remove(nSource);
+		ReleaseOutput(outputPort, 1U << nSource);
+		return true;
+	}
+
+	void IClearSources(const uint32_t nPortIndex) {
+		assert(nPortIndex < PORTS);
+
+		auto& outputPort = m_OutputPort[nPortIndex];
+		ReleaseOutput(outputPort, outputPort.sources.GetActiveMask());
+		outputPort.sources.Clear();
+	}
+
+	uint32_t ITimeout(const uint32_t nPortIndex, const uint32_t nMillis, const uint32_t nTimeoutMillis) {
+		assert(nPortIndex < PORTS);
+
+		auto& outputPort = m_OutputPort[nPortIndex];
+		const auto nRemoved = outputPort.sources.Timeout(nMillis, nTimeoutMillis);
+		ReleaseOutput(outputPort, nRemoved);
+		return nRemoved;
+	}
+
+	uint32_t IGetSourceCount(const uint32_t nPortIndex) const {
+		assert(nPortIndex < PORTS);
+		return m_OutputPort[nPortIndex].sources.GetCount();
+	}
+
+	bool IIsMerging(const uint32_t nPortIndex) const {
+		assert(nPortIndex < PORTS);
+		return __builtin_popcount(m_OutputPort[nPortIndex].sources.GetOutputMask()) > 1;
+	}
+
+	/**
+	 * The dirty range is the union of all merges since the previous ISet/IOutput.
+	 */
+	void ISet(LightSet *const pLightSet, const uint32_t nPortIndex) {
 		assert(pLightSet != nullptr);
 		assert(nPortIndex < PORTS);
 
-		pLightSet->SetData(nPortIndex, m_OutputPort[nPortIndex].data, m_OutputPort[nPortIndex].nLength, false);
+		auto& outputPort = m_OutputPort[nPortIndex];
+		pLightSet->SetDataRange(nPortIndex, outputPort.pOutput, outputPort.nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast, false);
+		ClearDirty(outputPort);
 	}
 
-	void IOutput(LightSet *const pLightSet, const uint32_t nPortIndex) const {
+	void IOutput(LightSet *const pLightSet, const uint32_t nPortIndex) {
 		assert(pLightSet != nullptr);
 		assert(nPortIndex < PORTS);
 
-		pLightSet->SetData(nPortIndex, m_OutputPort[nPortIndex].data, m_OutputPort[nPortIndex].nLength, true);
+		auto& outputPort = m_OutputPort[nPortIndex];
+		pLightSet->SetDataRange(nPortIndex, outputPort.pOutput, outputPort.nLength, outputPort.nDirtyFirst, outputPort.nDirtyLast, true);
+		ClearDirty(outputPort);
 	}
 
 	void IOutputClear(LightSet *const pLightSet, const uint32_t nPortIndex) {
 		assert(pLightSet != nullptr);
 		assert(nPortIndex < PORTS);
 
-		memset(m_OutputPort[nPortIndex].data, 0, dmx::UNIVERSE_SIZE);
-		m_OutputPort[nPortIndex].nLength = dmx::UNIVERSE_SIZE;
+		auto& outputPort = m_OutputPort[nPortIndex];
+		SetOutput(outputPort, source::NONE);
+		memset(outputPort.data, 0, dmx::UNIVERSE_SIZE);
+		outputPort.nLength = dmx::UNIVERSE_SIZE;
+		SetDirty(outputPort);
 		IOutput(pLightSet, nPortIndex);
 	}
 
@@ -179,38 +381,100 @@ private:
 
 	const uint8_t *IBackup(const uint32_t nPortIndex) {
 		assert(nPortIndex < PORTS);
-		return const_cast<const uint8_t *>(m_OutputPort[nPortIndex].data);
+		return m_OutputPort[nPortIndex].pOutput;
 	}
 
 	void IRestore(const uint32_t nPortIndex, const uint8_t *pData) {
 		assert(nPortIndex < PORTS);
 		assert(pData != nullptr);
 
-		memcpy(m_OutputPort[nPortIndex].data, pData, dmx::UNIVERSE_SIZE);
+		auto& outputPort = m_OutputPort[nPortIndex];
+		SetOutput(outputPort, source::NONE);
+		memcpy(outputPort.data, pData, dmx::UNIVERSE_SIZE);
+		SetDirty(outputPort);
 	}
 
-private:
-#if !defined (LIGHTSET_PORTS)
-# define LIGHTSET_PORTS 0
-#endif
+	uint8_t *IGetRestoreBuffer(const uint32_t nPortIndex) {
+		assert(nPortIndex < PORTS);
 
-#if (LIGHTSET_PORTS == 0)
-	static constexpr auto PORTS = 1;	// ISO C++ forbids zero-size array
-#else
-	static constexpr auto PORTS = LIGHTSET_PORTS;
-#endif
+		auto& outputPort = m_OutputPort[nPortIndex];
+		SetOutput(outputPort, source::NONE);
+		SetDirty(outputPort);
+		return outputPort.data;
+	}
 
+private:
 	struct Source {
 		uint8_t data[dmx::UNIVERSE_SIZE] __attribute__ ((aligned (4)));
 	};
 
+	/**
+	 * With a single output source, the output reads straight from the buffer of
+	 * that source and data[] is not used. Only a merge of sources is built in data[].
+	 */
 	struct OutputPort {
-		Source sourceA;
-		Source sourceB;
+		Source sourceData[source::MAX];
+		source::Table sources;
 		uint8_t data[dmx::UNIVERSE_SIZE] __attribute__ ((aligned (4)));
+		const uint8_t *pOutput { data };
+		uint32_t nOutputSource { source::NONE };	///< source::NONE is data[]
 		uint32_t nLength;
+		uint32_t nDirtyFirst { 0 };
+		uint32_t nDirtyLast { dmx::UNIVERSE_SIZE - 1 };
+		source::Id pendingId;				///< Unknown source seen by CheckSequence, added by Merge
+		uint8_t nPendingSequence;
+		bool bPendingSequence { false };
 	};
 
+	static void SetDirty(OutputPort& outputPort) {
+		outputPort.nDirtyFirst = 0;
+		outputPort.nDirtyLast = dmx::UNIVERSE_SIZE - 1;
+	}
+
+	static void ClearDirty(OutputPort& outputPort) {
+		outputPort.nDirtyFirst = dmx::UNIVERSE_SIZE;
+		outputPort.nDirtyLast = 0;
+	}
+
+	/**
+	 * The dirty range is relative to the previous output buffer,
+	 * so switching buffers marks the whole frame dirty.
+	 */
+	static void SetOutput(OutputPort& outputPort, const uint32_t nSource) {
+		if (__builtin_expect((outputPort.nOutputSource == nSource), 1)) {
+			return;
+		}
+
+		outputPort.nOutputSource = nSource;
+		outputPort.pOutput = (nSource == source::NONE) ? outputPort.data : outputPort.sourceData[nSource].data;
+		SetDirty(outputPort);
+	}
+
+	/**
+	 * The slot of a removed source is reused by the next new source, so the output
+	 * must not point into it. The last frame of the removed source stays the output.
+	 * The same for a source which is no longer merged into the output (demoted).
+	 */
+	static void ReleaseOutput(OutputPort& outputPort, const uint32_t nRemovedMask) {
+		if ((outputPort.nOutputSource == source::NONE) || ((nRemovedMask & (1U << outputPort.nOutputSource)) == 0)) {
+			return;
+		}
+
+		memcpy(outputPort.data, outputPort.pOutput, sizeof(outputPort.data));
+		SetOutput(outputPort, source::NONE);
+	}
+
+	/**
+	 * The output has not seen the slots beyond its previous length,
+	 * so a length change marks the whole frame dirty.
+	 */
+	static void SetLength(OutputPort& outputPort, const uint32_t nLength) {
+		if (outputPort.nLength != nLength) {
+			outputPort.nLength = nLength;
+			SetDirty(outputPort);
+		}
+	}
+
 	OutputPort m_OutputPort[PORTS];
 };
 
@@ -0,0 +1,242 @@
+/**
+ * @file lightsetmerge.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETMERGE_H_
+#define LIGHTSETMERGE_H_
+
+#include <cstdint>
+#include <cstring>
+
+#if defined (__ARM_NEON)
+# include <arm_neon.h>
+#elif defined (__AVX2__)
+# include <immintrin.h>
+#elif defined (__SSE2__)
+# include <emmintrin.h>
+#endif
+
+/**
+ * Merge kernels for lightset::Data
+ * For HTP the copy of the incoming frame into the source buffer and the merge into the
+ * output buffer are fused into one pass. Only the first nLength slots are touched.
+ *
+ * While merging, the slots of pOutput which change are added to the dirty range
+ * [nDirtyFirst, nDirtyLast]. The empty range is {dmx::UNIVERSE_SIZE, 0}.
+ * For the vector part the range is widened to whole vectors, which is harmless:
+ * it only has to cover the changed slots.
+ */
+
+namespace lightset {
+namespace merge {
+inline void dirty(uint32_t& nDirtyFirst, uint32_t& nDirtyLast, const uint32_t nFirst, const uint32_t nLast) {
+	if (nFirst < nDirtyFirst) {
+		nDirtyFirst = nFirst;
+	}
+	if (nLast > nDirtyLast) {
+		nDirtyLast = nLast;
+	}
+}
+
+#if defined (__ARM_NEON)
+inline bool is_changed(const uint8x16_t a, const uint8x16_t b) {
+	const auto d = vreinterpretq_u64_u8(veorq_u8(a, b));
+	return (vgetq_lane_u64(d, 0) | vgetq_lane_u64(d, 1)) != 0;
+}
+#elif defined (__AVX2__)
+inline bool is_changed(const __m256i a, const __m256i b) {
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != 0xFFFFFFFFU;
+}
+#elif defined (__SSE2__)
+inline bool is_changed(const __m128i a, const __m128i b) {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF;
+}
+#endif
+
+/**
+ * pSource[i] = pIn[i]
+ * pOutput[i] = max(pIn[i], pOther[i])
+ */
+inline void htp(uint8_t *__restrict__ pSource, uint8_t *__restrict__ pOutput, const uint8_t *__restrict__ pIn, const uint8_t *__restrict__ pOther, const uint32_t nLength, uint32_t& nDirtyFirst, uint32_t& nDirtyLast) {
+	uint32_t i = 0;
+
+#if defined (__ARM_NEON)
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto in = vld1q_u8(&pIn[i]);
+		const auto out = vmaxq_u8(in, vld1q_u8(&pOther[i]));
+		vst1q_u8(&pSource[i], in);
+		if (is_changed(out, vld1q_u8(&pOutput[i]))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+		}
+		vst1q_u8(&pOutput[i], out);
+	}
+#elif defined (__AVX2__)
+	for (; (i + 32) <= nLength; i += 32) {
+		const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pIn[i]));
+		const auto out = _mm256_max_epu8(in, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOther[i])));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pSource[i]), in);
+		if (is_changed(out, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 31);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pOutput[i]), out);
+	}
+#elif defined (__SSE2__)
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pIn[i]));
+		const auto out = _mm_max_epu8(in, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOther[i])));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pSource[i]), in);
+		if (is_changed(out, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pOutput[i]), out);
+	}
+#endif
+
+	for (; i < nLength; i++) {
+		const auto in = pIn[i];
+		const auto other = pOther[i];
+		const auto out = in > other ? in : other;
+		pSource[i] = in;
+		if (pOutput[i] != out) {
+			dirty(nDirtyFirst, nDirtyLast, i, i);
+		}
+		pOutput[i] = out;
+	}
+}
+
+/**
+ * pOutput[i] = max(ppSources[0][i], ..., ppSources[nSources - 1][i])
+ * Used when more than two sources are merged, the sources are already up-to-date.
+ */
+inline void htp(uint8_t *__restrict__ pOutput, const uint8_t *const *ppSources, const uint32_t nSources, const uint32_t nLength, uint32_t& nDirtyFirst, uint32_t& nDirtyLast) {
+	uint32_t i = 0;
+
+#if defined (__ARM_NEON)
+	for (; (i + 16) <= nLength; i += 16) {
+		auto out = vld1q_u8(&ppSources[0][i]);
+		for (uint32_t n = 1; n < nSources; n++) {
+			out = vmaxq_u8(out, vld1q_u8(&ppSources[n][i]));
+		}
+		if (is_changed(out, vld1q_u8(&pOutput[i]))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+		}
+		vst1q_u8(&pOutput[i], out);
+	}
+#elif defined (__AVX2__)
+	for (; (i + 32) <= nLength; i += 32) {
+		auto out = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&ppSources[0][i]));
+		for (uint32_t n = 1; n < nSources; n++) {
+			out = _mm256_max_epu8(out, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&ppSources[n][i])));
+		}
+		if (is_changed(out, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 31);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pOutput[i]), out);
+	}
+#elif defined (__SSE2__)
+	for (; (i + 16) <= nLength; i += 16) {
+		auto out = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&ppSources[0][i]));
+		for (uint32_t n = 1; n < nSources; n++) {
+			out = _mm_max_epu8(out, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&ppSources[n][i])));
+		}
+		if (is_changed(out, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pOutput[i]), out);
+	}
+#endif
+
+	for (; i < nLength; i++) {
+		auto out = ppSources[0][i];
+		for (uint32_t n = 1; n < nSources; n++) {
+			out = ppSources[n][i] > out ? ppSources[n][i] : out;
+		}
+		if (pOutput[i] != out) {
+			dirty(nDirtyFirst, nDirtyLast, i, i);
+		}
+		pOutput[i] = out;
+	}
+}
+
+/**
+ * pSource[i] = pIn[i]
+ * pOutput[i] = pIn[i]
+ * A plain copy is not worth fusing, memcpy is faster than a vector loop.
+ * The memcmp pass skips the output write of an unchanged frame, otherwise
+ * the dirty range is the whole frame.
+ */
+inline void ltp(uint8_t *__restrict__ pSource, uint8_t *__restrict__ pOutput, const uint8_t *__restrict__ pIn, const uint32_t nLength, uint32_t& nDirtyFirst, uint32_t& nDirtyLast) {
+	memcpy(pSource, pIn, nLength);
+
+	if ((nLength != 0) && (memcmp(pOutput, pIn, nLength) != 0)) {
+		memcpy(pOutput, pIn, nLength);
+		dirty(nDirtyFirst, nDirtyLast, 0, nLength - 1);
+	}
+}
+
+/**
+ * pOutput[i] = pIn[i]
+ * The single source fast path, pOutput is both the source buffer and the output.
+ */
+inline void copy(uint8_t *__restrict__ pOutput, const uint8_t *__restrict__ pIn, const uint32_t nLength, uint32_t& nDirtyFirst, uint32_t& nDirtyLast) {
+	uint32_t i = 0;
+
+#if defined (__ARM_NEON)
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto in = vld1q_u8(&pIn[i]);
+		if (is_changed(in, vld1q_u8(&pOutput[i]))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+			vst1q_u8(&pOutput[i], in);
+		}
+	}
+#elif defined (__AVX2__)
+	for (; (i + 32) <= nLength; i += 32) {
+		const auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pIn[i]));
+		if (is_changed(in, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 31);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pOutput[i]), in);
+		}
+	}
+#elif defined (__SSE2__)
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pIn[i]));
+		if (is_changed(in, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOutput[i])))) {
+			dirty(nDirtyFirst, nDirtyLast, i, i + 15);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&pOutput[i]), in);
+		}
+	}
+#endif
+
+	for (; i < nLength; i++) {
+		const auto in = pIn[i];
+		if (pOutput[i] != in) {
+			dirty(nDirtyFirst, nDirtyLast, i, i);
+			pOutput[i] = in;
+		}
+	}
+}
+}  // namespace merge
+}  // namespace lightset
+
+#endif /* LIGHTSETMERGE_H_ */
@@ -2,7 +2,7 @@
  * @file lightsetparamsconst.h
  *
  */
-/* Copyright (C) 2019-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -33,26 +33,77 @@ static constexpr uint32_t MAX_PORTS = 4;
 }  // namespace lightsetparams
 
 struct LightSetParamsConst {
-	static const char PARAMS_OUTPUT[];
+	static constexpr char PARAMS_OUTPUT[] = "output";
 
-	static const char NODE_LABEL[lightsetparams::MAX_PORTS][14];
-	static const char NODE_LONG_NAME[];
+	static constexpr char NODE_LABEL[lightsetparams::MAX_PORTS][14] = {
+			"label_port_a",
+			"label_port_b",
+			"label_port_c",
+			"label_port_d"
+	};
+	static constexpr char NODE_LONG_NAME[] = "long_name";
 
-	static const char UNIVERSE_PORT[lightsetparams::MAX_PORTS][16];
-	static const char MERGE_MODE_PORT[lightsetparams::MAX_PORTS][18];
-	static const char DIRECTION[lightsetparams::MAX_PORTS][18];
-	static const char OUTPUT_STYLE[lightsetparams::MAX_PORTS][16];
-	static const char PRIORITY[lightsetparams::MAX_PORTS][16];
+	static constexpr char UNIVERSE_PORT[lightsetparams::MAX_PORTS][16] = {
+			"universe_port_a",
+			"universe_port_b",
+			"universe_port_c",
+			"universe_port_d"
+	};
+	static constexpr char MERGE_MODE_PORT[lightsetparams::MAX_PORTS][18] = {
+			"merge_mode_port_a",
+			"merge_mode_port_b",
+			"merge_mode_port_c",
+			"merge_mode_port_d"
+	};
+	static constexpr char DIRECTION[lightsetparams::MAX_PORTS][18] = {
+			"direction_port_a",
+			"direction_port_b",
+			"direction_port_c",
+			"direction_port_d"
+	};
+	static constexpr char OUTPUT_STYLE[lightsetparams::MAX_PORTS][16] = {
+			"output_style_a",
+			"output_style_b",
+			"output_style_c",
+			"output_style_d"
+	};
+	static constexpr char PRIORITY[lightsetparams::MAX_PORTS][16] = {
+			"priority_port_a",
+			"priority_port_b",
+			"priority_port_c",
+			"priority_port_d"
+	};
 
-	static const char DMX_START_ADDRESS[];
-	static const char DMX_SLOT_INFO[];
+	static constexpr char DMX_START_ADDRESS[] = "dmx_start_address";
+	static constexpr char DMX_SLOT_INFO[] = "dmx_slot_info";
 
-	static const char DISABLE_MERGE_TIMEOUT[];
+	static constexpr char DISABLE_MERGE_TIMEOUT[] = "disable_merge_timeout";
 
-	static const char FAILSAFE[];
+	static constexpr char FAILSAFE[] = "failsafe";
 
 #if defined (CONFIG_PIXELDMX_MAX_PORTS)
-	static const char START_UNI_PORT[CONFIG_PIXELDMX_MAX_PORTS][20];
+	static constexpr char START_UNI_PORT[CONFIG_PIXELDMX_MAX_PORTS][20] = {
+			"start_uni_port_1",
+# if CONFIG_PIXELDMX_MAX_PORTS > 2
+			"start_uni_port_2",
+			"start_uni_port_3",
+			"start_uni_port_4",
+			"start_uni_port_5",
+			"start_uni_port_6",
+			"start_uni_port_7",
+			"start_uni_port_8",
+# endif
+# if CONFIG_PIXELDMX_MAX_PORTS == 16
+			"start_uni_port_9",
+			"start_uni_port_10",
+			"start_uni_port_11",
+			"start_uni_port_12",
+			"start_uni_port_13",
+			"start_uni_port_14",
+			"start_uni_port_15",
+			"start_uni_port_16"
+# endif
+	};
 #endif
 };
 
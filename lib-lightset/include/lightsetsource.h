@@ -0,0 +1,296 @@
+/**
+ * @file lightsetsource.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETSOURCE_H_
+#define LIGHTSETSOURCE_H_
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Source table for the merge engine in lightset::Data, shared by Art-Net and sACN.
+ * A source is identified by its IP address and a 16-byte id:
+ * the sACN CID, or for Art-Net the Physical field in the first byte.
+ * The hash of the identity is compared first, the full identity only on a hash hit.
+ * The table is bounded by MAX, so a lookup is a fixed number of 32-bit compares.
+ */
+
+namespace lightset {
+namespace source {
+#if !defined (CONFIG_LIGHTSET_SOURCES)
+# if defined (__linux__) || defined (__APPLE__)
+#  define CONFIG_LIGHTSET_SOURCES 4
+# else
+#  define CONFIG_LIGHTSET_SOURCES 2
+# endif
+#endif
+
+static constexpr uint32_t MAX = CONFIG_LIGHTSET_SOURCES;
+static constexpr uint32_t ID_LENGTH = 16;
+static constexpr uint32_t NONE = MAX;
+static constexpr uint8_t PRIORITY_DEFAULT = 100;
+
+static_assert((MAX >= 2) && (MAX <= 8), "CONFIG_LIGHTSET_SOURCES");
+
+enum class Result : uint8_t {
+	FIRST,		///< First source on this port
+	SET,		///< Single source, not merging
+	NEW,		///< New source, start the merge
+	MERGE,		///< Continue the merge
+	IGNORED,	///< Lower priority than the active source(s), data is kept for a take over
+	DISCARD		///< Source table is full
+};
+
+struct Id {
+	uint32_t nHash;
+	uint32_t nIp;
+	uint8_t aId[ID_LENGTH];
+};
+
+inline bool operator==(const Id& a, const Id& b) {
+	return (a.nHash == b.nHash) && (a.nIp == b.nIp) && (memcmp(a.aId, b.aId, ID_LENGTH) == 0);
+}
+
+inline uint32_t hash(const uint32_t nIp, const uint8_t *pId) {
+	uint32_t aWords[ID_LENGTH / 4];
+	memcpy(aWords, pId, ID_LENGTH);
+	return nIp ^ aWords[0] ^ (aWords[1] * 31U) ^ (aWords[2] * 961U) ^ (aWords[3] * 29791U);
+}
+
+/**
+ * sACN : the CID identifies the source
+ */
+inline Id make_id(const uint32_t nIp, const uint8_t *pCid) {
+	Id id;
+	id.nIp = nIp;
+	memcpy(id.aId, pCid, ID_LENGTH);
+	id.nHash = hash(nIp, id.aId);
+	return id;
+}
+
+/**
+ * Art-Net : the IP address and the Physical port of the sender identify the source
+ */
+inline Id make_id(const uint32_t nIp, const uint8_t nPhysical) {
+	Id id;
+	id.nIp = nIp;
+	memset(id.aId, 0, ID_LENGTH);
+	id.aId[0] = nPhysical;
+	id.nHash = hash(nIp, id.aId);
+	return id;
+}
+
+struct Entry {
+	Id id;
+	uint32_t nMillis;		///< The latest time data was received from this source
+	uint8_t nPriority;
+	uint8_t nSequence;		///< Protocol sequence number of the latest packet
+	bool bSequence;			///< nSequence is valid
+};
+
+namespace sequence {
+/**
+ * E1.31 6.9.2 : B - A in signed 8-bit arithmetic, less than or equal to 0 but greater than -20
+ * is out of sequence. Art-Net has no window defined, the same one is used.
+ */
+static constexpr int32_t WINDOW = 20;
+
+/**
+ * sACN counts 0-255. Art-Net counts 1-255, 0 disables the sequence, so 255 is followed by 1.
+ */
+enum class Wrap : uint8_t {
+	FULL, SKIP_ZERO
+};
+
+struct Stats {
+	uint32_t nDuplicate;	///< Same sequence number as the previous packet
+	uint32_t nOutOfOrder;	///< Older than the previous packet, within the window
+	uint32_t nLost;			///< Sequence numbers skipped
+};
+}  // namespace sequence
+
+class Table {
+public:
+	uint32_t Find(const Id& id) const {
+		for (uint32_t i = 0; i < MAX; i++) {
+			if (((m_nActiveMask & (1U << i)) != 0) && (m_Entry[i].id == id)) {
+				return i;
+			}
+		}
+
+		return NONE;
+	}
+
+	/**
+	 * @return the index of the new entry, NONE when the table is full
+	 */
+	uint32_t Add(const Id& id, const uint32_t nMillis, const uint8_t nPriority) {
+		const auto nFree = static_cast<uint32_t>(__builtin_ctz(~m_nActiveMask));
+
+		if (nFree >= MAX) {
+			return NONE;
+		}
+
+		m_Entry[nFree].id = id;
+		m_Entry[nFree].nMillis = nMillis;
+		m_Entry[nFree].nPriority = nPriority;
+		m_Entry[nFree].nSequence = 0;
+		m_Entry[nFree].bSequence = false;
+		m_nActiveMask |= (1U << nFree);
+
+		return nFree;
+	}
+
+	void Remove(const uint32_t nIndex) {
+		m_nActiveMask &= ~(1U << nIndex);
+	}
+
+	void Clear() {
+		m_nActiveMask = 0;
+	}
+
+	/**
+	 * Removes the sources which did not send data for nTimeoutMillis
+	 * @return mask of the removed sources
+	 */
+	uint32_t Timeout(const uint32_t nMillis, const uint32_t nTimeoutMillis) {
+		uint32_t nRemoved = 0;
+
+		for (auto nMask = m_nActiveMask; nMask != 0; nMask &= (nMask - 1)) {
+			const auto i = static_cast<uint32_t>(__builtin_ctz(nMask));
+
+			if ((nMillis - m_Entry[i].nMillis) > nTimeoutMillis) {
+				nRemoved |= (1U << i);
+			}
+		}
+
+		m_nActiveMask &= ~nRemoved;
+		return nRemoved;
+	}
+
+	/**
+	 * @return mask of the sources with the highest priority, these are the sources merged into the output
+	 */
+	uint32_t GetOutputMask() const {
+		uint32_t nMask = 0;
+		uint8_t nPriority = 0;
+
+		for (auto nActive = m_nActiveMask; nActive != 0; nActive &= (nActive - 1)) {
+			const auto i = static_cast<uint32_t>(__builtin_ctz(nActive));
+
+			if (m_Entry[i].nPriority > nPriority) {
+				nPriority = m_Entry[i].nPriority;
+				nMask = (1U << i);
+			} else if (m_Entry[i].nPriority == nPriority) {
+				nMask |= (1U << i);
+			}
+		}
+
+		return nMask;
+	}
+
+	/**
+	 * Sets the reference, for a source added with the sequence number of its first packet.
+	 */
+	void SetSequence(const uint32_t nIndex, const uint8_t nSequence) {
+		m_Entry[nIndex].nSequence = nSequence;
+		m_Entry[nIndex].bSequence = true;
+	}
+
+	/**
+	 * When the source has no reference yet, this packet sets it.
+	 * @return false when the packet is a duplicate or is out of order, the packet must be dropped
+	 */
+	bool CheckSequence(const uint32_t nIndex, const uint8_t nSequence, const sequence::Wrap wrap) {
+		auto& entry = m_Entry[nIndex];
+
+		if (__builtin_expect((!entry.bSequence), 0)) {
+			SetSequence(nIndex, nSequence);
+			return true;
+		}
+
+		auto nDiff = static_cast<int32_t>(static_cast<int8_t>(nSequence - entry.nSequence));
+
+		if (wrap == sequence::Wrap::SKIP_ZERO) {
+			// Crossing 255 -> 1 skips the unused 0
+			if ((nDiff > 0) && (nSequence < entry.nSequence)) {
+				nDiff--;
+			} else if ((nDiff < 0) && (nSequence > entry.nSequence)) {
+				nDiff++;
+			}
+		}
+
+		if (nDiff == 1) {
+			entry.nSequence = nSequence;
+			return true;
+		}
+
+		if (nDiff == 0) {
+			m_SequenceStats.nDuplicate++;
+			return false;
+		}
+
+		if ((nDiff < 0) && (nDiff > -sequence::WINDOW)) {
+			m_SequenceStats.nOutOfOrder++;
+			return false;
+		}
+
+		if (nDiff > 1) {
+			m_SequenceStats.nLost += static_cast<uint32_t>(nDiff - 1);
+		}
+
+		entry.nSequence = nSequence;
+		return true;
+	}
+
+	const sequence::Stats& GetSequenceStats() const {
+		return m_SequenceStats;
+	}
+
+	uint32_t GetActiveMask() const {
+		return m_nActiveMask;
+	}
+
+	uint32_t GetCount() const {
+		return static_cast<uint32_t>(__builtin_popcount(m_nActiveMask));
+	}
+
+	Entry& operator[](const uint32_t nIndex) {
+		return m_Entry[nIndex];
+	}
+
+	const Entry& operator[](const uint32_t nIndex) const {
+		return m_Entry[nIndex];
+	}
+
+private:
+	Entry m_Entry[MAX];
+	uint32_t m_nActiveMask { 0 };
+	sequence::Stats m_SequenceStats {};
+};
+}  // namespace source
+}  // namespace lightset
+
+#endif /* LIGHTSETSOURCE_H_ */
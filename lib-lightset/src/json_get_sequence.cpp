@@ -0,0 +1,62 @@
+/**
+ * @file json_get_sequence.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "lightsetdata.h"
+
+namespace remoteconfig {
+namespace lightset {
+/**
+ * /json/sequence
+ * The dropped and lost packets, per output port, of the Art-Net and sACN sources.
+ */
+uint32_t json_get_sequence(char *pOutBuffer, const uint32_t nOutBufferSize) {
+	pOutBuffer[0] = '[';
+	uint32_t nLength = 1;
+
+	for (uint32_t nPortIndex = 0; (nPortIndex < ::lightset::Data::PORTS) && (nLength < nOutBufferSize); nPortIndex++) {
+		const auto& stats = ::lightset::Data::GetSequenceStats(nPortIndex);
+
+		nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength,
+				"{\"port\":\"%c\",\"sources\":%u,\"duplicate\":%u,\"out_of_order\":%u,\"lost\":%u},",
+				static_cast<char>('A' + nPortIndex),
+				static_cast<unsigned int>(::lightset::Data::GetSourceCount(nPortIndex)),
+				static_cast<unsigned int>(stats.nDuplicate),
+				static_cast<unsigned int>(stats.nOutOfOrder),
+				static_cast<unsigned int>(stats.nLost)));
+	}
+
+	if (nLength >= nOutBufferSize) {
+		return nOutBufferSize;
+	}
+
+	pOutBuffer[nLength - 1] = ']';
+
+	return nLength;
+}
+}  // namespace lightset
+}  // namespace remoteconfig
@@ -72,6 +72,18 @@ void LightSetChain::SetData(const uint32_t nPortIndex, const uint8_t *pData, uin
 	}
 }
 
+/**
+ * The range is forwarded to every member, a member that does not override
+ * SetDataRange falls back to SetData. Skipping on the footprint is left to the members.
+ */
+void LightSetChain::SetDataRange(const uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, const uint32_t nSlotFirst, const uint32_t nSlotLast, const bool doUpdate) {
+	assert(pData != nullptr);
+
+	for (uint32_t i = 0; i < m_nSize; i++) {
+		m_pTable[i].pLightSet->SetDataRange(nPortIndex, pData, nLength, nSlotFirst, nSlotLast, doUpdate);
+	}
+}
+
 void LightSetChain::Sync(const uint32_t nPortIndex) {
 	for (uint32_t i = 0; i < m_nSize; i++) {
 		m_pTable[i].pLightSet->Sync(nPortIndex);
@@ -37,6 +37,14 @@
 
 #include "networkparams.h"
 
+namespace network {
+struct RecvStats {
+	uint32_t nPackets;			///< Datagrams received
+	uint32_t nDrops;			///< Datagrams dropped by the kernel (SO_RXQ_OVFL)
+	uint32_t nPacketsPerSecond;	///< Updated once per second
+};
+}  // namespace network
+
 class Network {
 public:
 	Network(int argc, char **argv);
@@ -56,6 +64,14 @@ public:
 
 	uint32_t RecvFrom(int32_t nHandle, void *pBuffer, uint32_t nLength, uint32_t *pFromIp, uint16_t *pFromPort);
 	uint32_t RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort);
+	/**
+	 * Drains up to the free ring entries of datagrams with one recvmmsg call.
+	 * RecvFrom(nHandle, ppBuffer, ...) consumes from this ring.
+	 * @return number of datagrams queued
+	 */
+	uint32_t RecvBatch(int32_t nHandle);
+	bool IsRecvPending() const;
+	bool GetRecvStats(int32_t nHandle, network::RecvStats& stats) const;
 	void SendTo(int32_t nHandle, const void *pBuffer, uint32_t nLength, uint32_t nToIp, uint16_t nRemotePort);
 
 	void SetIp(uint32_t nIp);
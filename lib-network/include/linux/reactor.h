@@ -0,0 +1,96 @@
+/**
+ * @file reactor.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LINUX_REACTOR_H_
+#define LINUX_REACTOR_H_
+
+#if defined(__linux__)
+#else
+# error
+#endif
+
+#include <cstdint>
+
+namespace network {
+namespace reactor {
+#if !defined (CONFIG_NETWORK_REACTOR_TIMERS_COUNT)
+# define CONFIG_NETWORK_REACTOR_TIMERS_COUNT 8
+#endif
+static constexpr uint32_t TIMERS_MAX = CONFIG_NETWORK_REACTOR_TIMERS_COUNT;
+static constexpr uint32_t EVENTS_MAX = 16;
+
+typedef void (*TimerCallback)();
+}  // namespace reactor
+
+/**
+ * The main loop blocks in Reactor::Run until one of the registered
+ * file descriptors is readable or a periodic timer (timerfd) expires.
+ * Network::Begin and Network::TcpBegin register their sockets automatically.
+ */
+
+class Reactor {
+public:
+	Reactor();
+	~Reactor();
+
+	bool Add(const int32_t nFd);
+	void Remove(const int32_t nFd);
+
+	/**
+	 * A nullptr callback is allowed: the timer then only wakes up the main loop.
+	 * @return timer handle or -1
+	 */
+	int32_t TimerAdd(const uint32_t nIntervalMillis, const reactor::TimerCallback callback);
+	bool TimerDelete(int32_t& nId);
+	bool TimerChange(const int32_t nId, const uint32_t nIntervalMillis);
+
+	/**
+	 * @param nTimeoutMillis -1 is wait forever
+	 * @return number of file descriptors ready for reading
+	 */
+	uint32_t Run(const int32_t nTimeoutMillis = -1);
+
+	static Reactor *Get() {
+		return s_pThis;
+	}
+
+private:
+	bool TimerArm(const int32_t nFd, const uint32_t nIntervalMillis);
+
+private:
+	struct Timer {
+		int32_t nFd;
+		reactor::TimerCallback callback;
+	};
+
+	int32_t m_nEpollFd { -1 };
+	Timer m_Timers[reactor::TIMERS_MAX];
+	uint32_t m_nTimersCount { 0 };
+
+	static Reactor *s_pThis;
+};
+}  // namespace network
+
+#endif /* LINUX_REACTOR_H_ */
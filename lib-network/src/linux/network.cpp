@@ -34,9 +34,13 @@
 #include <net/if.h>
 #include <ifaddrs.h>
 #include <errno.h>
+#include <time.h>
 #include <cassert>
 
 #include "network.h"
+#if defined(__linux__)
+# include "linux/reactor.h"
+#endif
 
 #include "debug.h"
 
@@ -58,6 +62,55 @@ namespace max {
 static int s_ports_allowed[max::PORTS_ALLOWED];
 static int snHandles[max::PORTS_ALLOWED];
 
+#if defined(__linux__)
+namespace recvbatch {
+static constexpr uint32_t ENTRIES = (1U << 4); // Must always be a power of 2
+static constexpr uint32_t ENTRIES_MASK = (ENTRIES - 1);
+}  // namespace recvbatch
+
+struct RecvRing {
+	struct Entry {
+		uint8_t data[MAX_SEGMENT_LENGTH];
+		uint32_t nLength;
+		uint32_t nFromIp;
+		uint16_t nFromPort;
+	};
+
+	Entry entries[recvbatch::ENTRIES];
+	uint32_t nHead;	///< Next entry to consume
+	uint32_t nTail;	///< Next entry to fill
+
+	struct mmsghdr msgs[recvbatch::ENTRIES];
+	struct iovec iovecs[recvbatch::ENTRIES];
+	struct sockaddr_in from[recvbatch::ENTRIES];
+	uint8_t control[recvbatch::ENTRIES][CMSG_SPACE(sizeof(uint32_t))];
+
+	network::RecvStats stats;
+	uint32_t nKernelDrops;	///< Last cumulative SO_RXQ_OVFL value
+	uint32_t nSecondPackets;
+	uint32_t nSecondMillis;
+};
+
+static RecvRing *s_pRecvRing[max::PORTS_ALLOWED];
+static uint32_t s_nRecvPending;
+
+static uint32_t millis() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint32_t>(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+static RecvRing *get_recv_ring(const int32_t nHandle) {
+	for (uint32_t i = 0; i < max::PORTS_ALLOWED; i++) {
+		if (snHandles[i] == nHandle) {
+			return s_pRecvRing[i];
+		}
+	}
+
+	return nullptr;
+}
+#endif
+
 /**
  * END
  */
@@ -151,6 +204,12 @@ Network::Network(int argc, char **argv) {
 Network::~Network() {
 	for (unsigned i = 0; i < max::PORTS_ALLOWED; i++) {
 		if (s_ports_allowed[i] != 0) {
+#if defined(__linux__)
+			if (s_pRecvRing[i] != nullptr) {
+				const auto& stats = s_pRecvRing[i]->stats;
+				printf("Port %u: packets=%u, drops=%u, packets/sec=%u\n", s_ports_allowed[i], stats.nPackets, stats.nDrops, stats.nPacketsPerSecond);
+			}
+#endif
 			Network::End(s_ports_allowed[i]);
 		}
 	}
@@ -223,6 +282,13 @@ int32_t Network::Begin(uint16_t nPort) {
 		exit(EXIT_FAILURE);
 	}
 
+#if defined(__linux__)
+	val = 1;
+	if (setsockopt(nSocket, SOL_SOCKET, SO_RXQ_OVFL, &val, sizeof(val)) == -1) {
+		perror("setsockopt(SO_RXQ_OVFL)");
+	}
+#endif
+
     memset(&si_me, 0, sizeof(si_me));
 
     si_me.sin_family = AF_INET;
@@ -249,6 +315,18 @@ int32_t Network::Begin(uint16_t nPort) {
 
 	snHandles[i] = nSocket;
 
+#if defined(__linux__)
+	auto *pRing = new RecvRing;
+	assert(pRing != nullptr);
+	memset(pRing, 0, sizeof(RecvRing));
+	pRing->nSecondMillis = millis();
+	s_pRecvRing[i] = pRing;
+
+	if (network::Reactor::Get() != nullptr) {
+		network::Reactor::Get()->Add(nSocket);
+	}
+#endif
+
 	DEBUG_PRINTF("nSocket=%d", nSocket);
 	DEBUG_EXIT
 	return nSocket;
@@ -278,6 +356,18 @@ int32_t Network::End(uint16_t nPort) {
 			s_ports_allowed[i] = 0;
 			puts("close");
 
+#if defined(__linux__)
+			if (network::Reactor::Get() != nullptr) {
+				network::Reactor::Get()->Remove(snHandles[i]);
+			}
+
+			if (s_pRecvRing[i] != nullptr) {
+				s_nRecvPending -= (s_pRecvRing[i]->nTail - s_pRecvRing[i]->nHead);
+				delete s_pRecvRing[i];
+				s_pRecvRing[i] = nullptr;
+			}
+#endif
+
 			if (close(snHandles[i]) == -1) {
 				perror("unbind");
 				exit(EXIT_FAILURE);
@@ -386,6 +476,21 @@ uint32_t Network::RecvFrom(int32_t nHandle, void *pPacket, uint32_t nSize, uint3
 	assert(pFromIp != nullptr);
 	assert(pFromPort != nullptr);
 
+#if defined(__linux__)
+	auto *pRing = get_recv_ring(nHandle);
+
+	if ((pRing != nullptr) && (pRing->nHead != pRing->nTail)) {
+		const auto& entry = pRing->entries[pRing->nHead & recvbatch::ENTRIES_MASK];
+		const auto nLength = entry.nLength < nSize ? entry.nLength : nSize;
+		memcpy(pPacket, entry.data, nLength);
+		*pFromIp = entry.nFromIp;
+		*pFromPort = entry.nFromPort;
+		pRing->nHead++;
+		s_nRecvPending--;
+		return nLength;
+	}
+#endif
+
 	int recv_len;
 	struct sockaddr_in si_other;
 	socklen_t slen = sizeof(si_other);
@@ -406,10 +511,128 @@ uint32_t Network::RecvFrom(int32_t nHandle, void *pPacket, uint32_t nSize, uint3
 }
 
 uint32_t Network::RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort) {
+#if defined(__linux__)
+	auto *pRing = get_recv_ring(nHandle);
+
+	if (pRing != nullptr) {
+		if ((pRing->nHead == pRing->nTail) && (RecvBatch(nHandle) == 0)) {
+			return 0;
+		}
+
+		auto& entry = pRing->entries[pRing->nHead & recvbatch::ENTRIES_MASK];
+		*ppBuffer = entry.data;
+		*pFromIp = entry.nFromIp;
+		*pFromPort = entry.nFromPort;
+		pRing->nHead++;
+		s_nRecvPending--;
+		/*
+		 * As with s_ReadBuffer, the entry is only valid until the next RecvFrom for this handle.
+		 */
+		return entry.nLength;
+	}
+#endif
 	*ppBuffer = &s_ReadBuffer;
 	return RecvFrom(nHandle, s_ReadBuffer, MAX_SEGMENT_LENGTH, pFromIp, pFromPort);
 }
 
+uint32_t Network::RecvBatch([[maybe_unused]] int32_t nHandle) {
+#if defined(__linux__)
+	auto *pRing = get_recv_ring(nHandle);
+
+	if (pRing == nullptr) {
+		return 0;
+	}
+
+	const auto nFree = recvbatch::ENTRIES - (pRing->nTail - pRing->nHead);
+
+	if (nFree == 0) {
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < nFree; i++) {
+		auto& entry = pRing->entries[(pRing->nTail + i) & recvbatch::ENTRIES_MASK];
+		pRing->iovecs[i].iov_base = entry.data;
+		pRing->iovecs[i].iov_len = MAX_SEGMENT_LENGTH;
+
+		auto& hdr = pRing->msgs[i].msg_hdr;
+		hdr.msg_name = &pRing->from[i];
+		hdr.msg_namelen = sizeof(struct sockaddr_in);
+		hdr.msg_iov = &pRing->iovecs[i];
+		hdr.msg_iovlen = 1;
+		hdr.msg_control = pRing->control[i];
+		hdr.msg_controllen = sizeof(pRing->control[i]);
+		hdr.msg_flags = 0;
+	}
+
+	const auto nReceived = recvmmsg(nHandle, pRing->msgs, nFree, MSG_DONTWAIT, nullptr);
+
+	if (nReceived <= 0) {
+		if ((nReceived == -1) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			DEBUG_PRINTF("nHandle=%d", nHandle);
+			perror("recvmmsg");
+		}
+	} else {
+		for (int32_t i = 0; i < nReceived; i++) {
+			auto& entry = pRing->entries[(pRing->nTail + static_cast<uint32_t>(i)) & recvbatch::ENTRIES_MASK];
+			entry.nLength = pRing->msgs[i].msg_len;
+			entry.nFromIp = pRing->from[i].sin_addr.s_addr;
+			entry.nFromPort = ntohs(pRing->from[i].sin_port);
+
+			auto *pHdr = &pRing->msgs[i].msg_hdr;
+
+			for (auto *pCmsg = CMSG_FIRSTHDR(pHdr); pCmsg != nullptr; pCmsg = CMSG_NXTHDR(pHdr, pCmsg)) {
+				if ((pCmsg->cmsg_level == SOL_SOCKET) && (pCmsg->cmsg_type == SO_RXQ_OVFL)) {
+					uint32_t nKernelDrops;
+					memcpy(&nKernelDrops, CMSG_DATA(pCmsg), sizeof(uint32_t));
+					pRing->stats.nDrops += (nKernelDrops - pRing->nKernelDrops);
+					pRing->nKernelDrops = nKernelDrops;
+				}
+			}
+		}
+
+		pRing->nTail += static_cast<uint32_t>(nReceived);
+		pRing->stats.nPackets += static_cast<uint32_t>(nReceived);
+		pRing->nSecondPackets += static_cast<uint32_t>(nReceived);
+		s_nRecvPending += static_cast<uint32_t>(nReceived);
+	}
+
+	const auto nMillis = millis();
+
+	if ((nMillis - pRing->nSecondMillis) >= 1000) {
+		pRing->stats.nPacketsPerSecond = (pRing->nSecondPackets * 1000) / (nMillis - pRing->nSecondMillis);
+		pRing->nSecondPackets = 0;
+		pRing->nSecondMillis = nMillis;
+	}
+
+	return nReceived > 0 ? static_cast<uint32_t>(nReceived) : 0;
+#else
+	return 0;
+#endif
+}
+
+bool Network::IsRecvPending() const {
+#if defined(__linux__)
+	return s_nRecvPending != 0;
+#else
+	return false;
+#endif
+}
+
+bool Network::GetRecvStats([[maybe_unused]] int32_t nHandle, [[maybe_unused]] network::RecvStats& stats) const {
+#if defined(__linux__)
+	const auto *pRing = get_recv_ring(nHandle);
+
+	if (pRing == nullptr) {
+		return false;
+	}
+
+	stats = pRing->stats;
+	return true;
+#else
+	return false;
+#endif
+}
+
 void Network::SendTo(int32_t nHandle, const void *pPacket, uint32_t nSize, uint32_t nToIp, uint16_t nRemotePort) {
 	struct sockaddr_in si_other;
 	socklen_t slen = sizeof(si_other);
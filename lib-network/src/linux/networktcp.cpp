@@ -34,6 +34,9 @@
 #include <cassert>
 
 #include "network.h"
+#if defined(__linux__)
+# include "linux/reactor.h"
+#endif
 #include "../../config/net_config.h"
 
 #include "debug.h"
@@ -100,6 +103,12 @@ int32_t Network::TcpBegin(uint16_t nLocalPort) {
     poll_set[i][0].fd = server_sockfd[i];
     poll_set[i][0].events = POLLIN | POLLPRI;
 
+#if defined(__linux__)
+	if (network::Reactor::Get() != nullptr) {
+		network::Reactor::Get()->Add(server_sockfd[i]);
+	}
+#endif
+
     printf("Network::TcpBegin -> i=%d\n", i);
 	return i;
 }
@@ -154,6 +163,12 @@ uint16_t Network::TcpRead(const int32_t nHandle, const uint8_t **ppBuffer, uint3
 				poll_set[nHandle][empty_slot].fd = client_sockfd;
 				poll_set[nHandle][empty_slot].events = POLLIN | POLLPRI;
 
+#if defined(__linux__)
+				if (network::Reactor::Get() != nullptr) {
+					network::Reactor::Get()->Add(client_sockfd);
+				}
+#endif
+
 				DEBUG_PRINTF("Adding client on fd %d", client_sockfd);
 			} else {
 				int nread;
@@ -0,0 +1,223 @@
+/**
+ * @file reactor.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined(__linux__)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <cassert>
+
+#include "network.h"
+#include "linux/reactor.h"
+
+#include "debug.h"
+
+namespace network {
+Reactor *Reactor::s_pThis;
+
+Reactor::Reactor() {
+	DEBUG_ENTRY
+
+	assert(s_pThis == nullptr);
+	s_pThis = this;
+
+	if ((m_nEpollFd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+		perror("epoll_create1");
+		exit(EXIT_FAILURE);
+	}
+
+	DEBUG_EXIT
+}
+
+Reactor::~Reactor() {
+	for (uint32_t i = 0; i < m_nTimersCount; i++) {
+		close(m_Timers[i].nFd);
+	}
+
+	m_nTimersCount = 0;
+
+	close(m_nEpollFd);
+	m_nEpollFd = -1;
+
+	s_pThis = nullptr;
+}
+
+bool Reactor::Add(const int32_t nFd) {
+	DEBUG_PRINTF("nFd=%d", nFd);
+
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = nFd;
+
+	if (epoll_ctl(m_nEpollFd, EPOLL_CTL_ADD, nFd, &event) == -1) {
+		if (errno == EEXIST) {
+			return true;
+		}
+		perror("epoll_ctl(EPOLL_CTL_ADD)");
+		return false;
+	}
+
+	return true;
+}
+
+void Reactor::Remove(const int32_t nFd) {
+	DEBUG_PRINTF("nFd=%d", nFd);
+
+	if (epoll_ctl(m_nEpollFd, EPOLL_CTL_DEL, nFd, nullptr) == -1) {
+		if ((errno != ENOENT) && (errno != EBADF)) {
+			perror("epoll_ctl(EPOLL_CTL_DEL)");
+		}
+	}
+}
+
+bool Reactor::TimerArm(const int32_t nFd, const uint32_t nIntervalMillis) {
+	struct itimerspec spec;
+	spec.it_interval.tv_sec = static_cast<time_t>(nIntervalMillis / 1000U);
+	spec.it_interval.tv_nsec = static_cast<long>((nIntervalMillis % 1000U) * 1000000U);
+	spec.it_value = spec.it_interval;
+
+	if (timerfd_settime(nFd, 0, &spec, nullptr) == -1) {
+		perror("timerfd_settime");
+		return false;
+	}
+
+	return true;
+}
+
+int32_t Reactor::TimerAdd(const uint32_t nIntervalMillis, const reactor::TimerCallback callback) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nIntervalMillis=%u", nIntervalMillis);
+
+	if ((m_nTimersCount >= reactor::TIMERS_MAX) || (nIntervalMillis == 0)) {
+		fprintf(stderr, "Reactor::TimerAdd\n");
+		DEBUG_EXIT
+		return -1;
+	}
+
+	const auto nFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (nFd == -1) {
+		perror("timerfd_create");
+		DEBUG_EXIT
+		return -1;
+	}
+
+	if (!TimerArm(nFd, nIntervalMillis) || !Add(nFd)) {
+		close(nFd);
+		DEBUG_EXIT
+		return -1;
+	}
+
+	m_Timers[m_nTimersCount].nFd = nFd;
+	m_Timers[m_nTimersCount].callback = callback;
+	m_nTimersCount++;
+
+	DEBUG_EXIT
+	return nFd;
+}
+
+bool Reactor::TimerDelete(int32_t& nId) {
+	for (uint32_t i = 0; i < m_nTimersCount; i++) {
+		if (m_Timers[i].nFd == nId) {
+			Remove(nId);
+			close(nId);
+
+			for (uint32_t j = i; j < m_nTimersCount - 1; j++) {
+				m_Timers[j] = m_Timers[j + 1];
+			}
+
+			--m_nTimersCount;
+			nId = -1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Reactor::TimerChange(const int32_t nId, const uint32_t nIntervalMillis) {
+	for (uint32_t i = 0; i < m_nTimersCount; i++) {
+		if (m_Timers[i].nFd == nId) {
+			return TimerArm(nId, nIntervalMillis);
+		}
+	}
+
+	return false;
+}
+
+uint32_t Reactor::Run(const int32_t nTimeoutMillis) {
+	struct epoll_event events[reactor::EVENTS_MAX];
+
+	/*
+	 * Datagrams already drained into the receive rings do not make the socket readable
+	 */
+	const auto bIsRecvPending = (Network::Get() != nullptr) && Network::Get()->IsRecvPending();
+	const auto nEvents = epoll_wait(m_nEpollFd, events, reactor::EVENTS_MAX, bIsRecvPending ? 0 : nTimeoutMillis);
+
+	if (nEvents == -1) {
+		if (errno != EINTR) {
+			perror("epoll_wait");
+		}
+		return 0;
+	}
+
+	uint32_t nReadable = 0;
+
+	for (int i = 0; i < nEvents; i++) {
+		const auto nFd = events[i].data.fd;
+		uint32_t nTimer;
+
+		for (nTimer = 0; nTimer < m_nTimersCount; nTimer++) {
+			if (m_Timers[nTimer].nFd == nFd) {
+				break;
+			}
+		}
+
+		if (nTimer == m_nTimersCount) {
+			nReadable++;
+			continue;
+		}
+
+		uint64_t nExpirations;
+
+		if (read(nFd, &nExpirations, sizeof(nExpirations)) != sizeof(nExpirations)) {
+			continue;
+		}
+
+		if (m_Timers[nTimer].callback != nullptr) {
+			m_Timers[nTimer].callback();
+		}
+	}
+
+	return nReadable;
+}
+}  // namespace network
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file propertiesbundle.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PROPERTIESBUNDLE_H_
+#define PROPERTIESBUNDLE_H_
+
+#include <cstdint>
+
+namespace properties {
+namespace bundle {
+#if !defined (CONFIG_PROPERTIES_BUNDLE_SECTIONS)
+# define CONFIG_PROPERTIES_BUNDLE_SECTIONS 16
+#endif
+static constexpr uint32_t SECTIONS_MAX = CONFIG_PROPERTIES_BUNDLE_SECTIONS;
+
+/**
+ * Identifies the bundle that was parsed last time, kept in the config store by the owner
+ */
+struct Stamp {
+	uint32_t nHash;
+	uint32_t nSize;
+	int64_t nCtimeNanos;	///< st_ctim, it cannot be preserved by a copy as st_mtim can (cp -p, rsync -t)
+} __attribute__((packed));
+
+static_assert(sizeof(struct Stamp) == 16, "");
+}  // namespace bundle
+
+/**
+ * A bundle is a single file holding several configuration files, each one starting with a [name] line:
+ *
+ *  [sparkfun.txt]
+ *  sparkfun_reset_pin=22
+ *  [motor0.txt]
+ *  sparkfun_position=0
+ *  dmx_mode=2
+ *
+ * It is read with one fread, and while the bundle is open, ReadConfigFile::Read(pFileName)
+ * serves the sections from memory instead of opening the individual files.
+ *
+ * When the size and ctime, or else the content hash, match the previous Stamp, then the bundle
+ * is unchanged. A ctime within the last second is not trusted, as a change in the same
+ * timestamp tick would not be seen, the hash is compared instead. ReadConfigFile::Read(pFileName) then returns false, so the Params classes copy
+ * their values from the config store without parsing. Only open a bundle around Params
+ * classes that follow this Read/Update/Copy pattern.
+ */
+class Bundle {
+public:
+	Bundle();
+	~Bundle();
+
+	/**
+	 * @return false when there is no bundle file, the individual files are then used
+	 */
+	bool Open(const char *pFileName, const bundle::Stamp& previous);
+
+	bool Find(const char *pName, const char *& pData, uint32_t& nLength) const;
+
+	bool IsUnchanged() const {
+		return m_bUnchanged;
+	}
+
+	/**
+	 * After the owner has parsed all sections into the config store
+	 */
+	void SetUnchanged() {
+		m_bUnchanged = true;
+	}
+
+	const bundle::Stamp& GetStamp() const {
+		return m_Stamp;
+	}
+
+	static Bundle *Get() {
+		return s_pThis;
+	}
+
+private:
+	void Index();
+
+private:
+	struct Section {
+		const char *pName;
+		const char *pData;
+		uint32_t nLength;
+	};
+
+	char *m_pBuffer { nullptr };
+	Section m_Sections[bundle::SECTIONS_MAX];
+	uint32_t m_nSections { 0 };
+	bundle::Stamp m_Stamp {};
+	bool m_bUnchanged { false };
+
+	static Bundle *s_pThis;
+};
+}  // namespace properties
+
+#endif /* PROPERTIESBUNDLE_H_ */
@@ -0,0 +1,211 @@
+/**
+ * @file propertiesschema.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PROPERTIESSCHEMA_H_
+#define PROPERTIESSCHEMA_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * A constexpr key table per Params class. Each entry carries the type,
+ * the nSetList mask and the offset of the member in the (packed) Params struct.
+ * The table builds a perfect hash at compile time, so a line is matched
+ * with a single hash and a single string compare, instead of trying
+ * every known key in sequence.
+ */
+
+namespace properties {
+namespace schema {
+enum class Type : uint8_t {
+	UINT8, UINT16, UINT32, FLOAT, HANDLER
+};
+
+/**
+ * For keys which are more than a number: strings, enums and
+ * values which clear their nSetList bit again when they are the default.
+ * The handler updates nSetList itself.
+ * @param pValue points to the value, it is not empty
+ * @param nIndex the argument of the key: the port index, or the mask of a boolean key
+ */
+typedef void (*Handler)(void *pParams, const char *pValue, const uint32_t nIndex);
+
+struct Key {
+	const char *pName;
+	Type type;
+	uint16_t nOffset;
+	uint32_t nMask;
+	uint32_t nMin;	///< FLOAT: nMin != 0 rejects 0, HANDLER: the argument
+	uint32_t nMax;	///< FLOAT, HANDLER: not used
+	Handler pHandler;
+};
+
+constexpr Key Uint8(const char *pName, const size_t nOffset, const uint32_t nMask, const uint32_t nMin = 0, const uint32_t nMax = UINT8_MAX) {
+	return Key { pName, Type::UINT8, static_cast<uint16_t>(nOffset), nMask, nMin, nMax, nullptr };
+}
+
+constexpr Key Uint16(const char *pName, const size_t nOffset, const uint32_t nMask, const uint32_t nMin = 0, const uint32_t nMax = UINT16_MAX) {
+	return Key { pName, Type::UINT16, static_cast<uint16_t>(nOffset), nMask, nMin, nMax, nullptr };
+}
+
+constexpr Key Uint32(const char *pName, const size_t nOffset, const uint32_t nMask, const uint32_t nMin = 0, const uint32_t nMax = UINT32_MAX) {
+	return Key { pName, Type::UINT32, static_cast<uint16_t>(nOffset), nMask, nMin, nMax, nullptr };
+}
+
+constexpr Key Float(const char *pName, const size_t nOffset, const uint32_t nMask, const bool bNonZero = false) {
+	return Key { pName, Type::FLOAT, static_cast<uint16_t>(nOffset), nMask, bNonZero ? 1U : 0U, 0, nullptr };
+}
+
+constexpr Key Custom(const char *pName, const Handler pHandler, const uint32_t nIndex = 0) {
+	return Key { pName, Type::HANDLER, 0, 0, nIndex, 0, pHandler };
+}
+
+/**
+ * FNV-1a, stops at the '=' so that it can be run on a properties line
+ */
+constexpr uint32_t hash(const char *p, const uint32_t nSeed) {
+	uint32_t h = 2166136261U ^ nSeed;
+
+	while ((*p != '\0') && (*p != '=')) {
+		h ^= static_cast<uint8_t>(*p++);
+		h *= 16777619U;
+	}
+
+	return h ^ (h >> 15);
+}
+
+/**
+ * Parses the value and stores it in the Params struct, or calls the key handler.
+ * @return key.nMask, or 0 when the value is invalid or out of range, or the key has a handler
+ */
+uint32_t store(const Key& key, const char *pValue, void *pParams);
+
+template<size_t N>
+class Table {
+	static_assert(N != 0, "");
+	static_assert(N < 0xFF, "");
+
+	static constexpr size_t size() {
+		size_t nSize = 1;
+		while (nSize < (2 * N)) {
+			nSize <<= 1;
+		}
+		return nSize;
+	}
+
+public:
+	static constexpr size_t SIZE = size();
+	static constexpr uint8_t EMPTY = 0xFF;
+	static constexpr uint32_t SEED_MAX = 4096;
+
+	constexpr explicit Table(const Key (&keys)[N]) : m_pKeys(keys) {
+		for (uint32_t nSeed = 0; nSeed < SEED_MAX; nSeed++) {
+			if (build(nSeed)) {
+				m_nSeed = nSeed;
+				return;
+			}
+		}
+		no_perfect_hash_found();
+	}
+
+	/**
+	 * @return nullptr when the key is not in the table, otherwise the key and pValue points to the value
+	 */
+	const Key *Find(const char *pLine, const char *&pValue) const {
+		const auto nIndex = m_nSlot[hash(pLine, m_nSeed) & (SIZE - 1)];
+
+		if (nIndex == EMPTY) {
+			return nullptr;
+		}
+
+		const auto& key = m_pKeys[nIndex];
+		const auto nLength = strlen(key.pName);
+
+		if ((strncmp(pLine, key.pName, nLength) != 0) || (pLine[nLength] != '=')) {
+			return nullptr;
+		}
+
+		pValue = &pLine[nLength + 1];
+
+		if ((*pValue == ' ') || (*pValue == '\0')) {
+			return nullptr;
+		}
+
+		return &key;
+	}
+
+	/**
+	 * One pass per line: hash, compare, parse and store.
+	 * @return the mask to be or-ed into nSetList, 0 when nothing was stored or a handler was called
+	 */
+	uint32_t Parse(const char *pLine, void *pParams) const {
+		const char *pValue;
+		const auto *pKey = Find(pLine, pValue);
+
+		if (pKey == nullptr) {
+			return 0;
+		}
+
+		return store(*pKey, pValue, pParams);
+	}
+
+	constexpr uint32_t GetSeed() const {
+		return m_nSeed;
+	}
+
+private:
+	constexpr bool build(const uint32_t nSeed) {
+		for (size_t i = 0; i < SIZE; i++) {
+			m_nSlot[i] = EMPTY;
+		}
+
+		for (size_t i = 0; i < N; i++) {
+			const auto nSlot = hash(m_pKeys[i].pName, nSeed) & (SIZE - 1);
+
+			if (m_nSlot[nSlot] != EMPTY) {
+				return false;
+			}
+
+			m_nSlot[nSlot] = static_cast<uint8_t>(i);
+		}
+
+		return true;
+	}
+
+	/*
+	 * Not constexpr: reaching it in a constant expression is a compile error
+	 */
+	static void no_perfect_hash_found() {}
+
+private:
+	const Key *m_pKeys;
+	uint32_t m_nSeed { 0 };
+	uint8_t m_nSlot[SIZE] {};
+};
+}  // namespace schema
+}  // namespace properties
+
+#endif /* PROPERTIESSCHEMA_H_ */
@@ -42,6 +42,16 @@ public:
 
 	static ReturnCode Float(const char *pBuffer, const char *pName, float& fValue);
 
+	/**
+	 * Value only, for callers that already matched the name (properties::schema)
+	 */
+	static ReturnCode Uint8(const char *pValue, uint8_t& nValue);
+	static ReturnCode Uint16(const char *pValue, uint16_t& nValue);
+	static ReturnCode Uint32(const char *pValue, uint32_t& nValue);
+	static ReturnCode Float(const char *pValue, float& fValue);
+	static ReturnCode Char(const char *pValue, char *pString, uint32_t& nLength);
+	static ReturnCode IpAddress(const char *pValue, uint32_t& nIpAddress);
+
 	static ReturnCode IpAddress(const char *pBuffer, const char *pName, uint32_t& nIpAddress);
 
 	static ReturnCode HexUint16(const char *pBuffer, const char *pName, uint16_t& nValue);
@@ -0,0 +1,204 @@
+/**
+ * @file propertiesbundle.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if !defined(DISABLE_FS)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "propertiesbundle.h"
+
+#include "debug.h"
+
+namespace properties {
+Bundle *Bundle::s_pThis;
+
+static uint32_t hash(const char *pData, uint32_t nLength) {
+	uint32_t h = 2166136261U;
+
+	while (nLength-- != 0) {
+		h ^= static_cast<uint8_t>(*pData++);
+		h *= 16777619U;
+	}
+
+	return h;
+}
+
+Bundle::Bundle() {
+	DEBUG_ENTRY
+	assert(s_pThis == nullptr);
+	DEBUG_EXIT
+}
+
+Bundle::~Bundle() {
+	DEBUG_ENTRY
+
+	if (s_pThis == this) {
+		s_pThis = nullptr;
+	}
+
+	delete[] m_pBuffer;
+	m_pBuffer = nullptr;
+
+	DEBUG_EXIT
+}
+
+bool Bundle::Open(const char *pFileName, const bundle::Stamp& previous) {
+	DEBUG_ENTRY
+	assert(pFileName != nullptr);
+	assert(m_pBuffer == nullptr);
+
+	auto *fp = fopen(pFileName, "r");
+
+	if (fp == nullptr) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	struct stat sb;
+
+	if ((fstat(fileno(fp), &sb) != 0) || (sb.st_size <= 0) || (sb.st_size > UINT16_MAX)) {
+		fclose(fp);
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_Stamp.nSize = static_cast<uint32_t>(sb.st_size);
+	m_Stamp.nCtimeNanos = static_cast<int64_t>(sb.st_ctim.tv_sec) * 1000000000 + sb.st_ctim.tv_nsec;
+
+	struct timespec now;
+	const auto isSettled = (clock_gettime(CLOCK_REALTIME, &now) == 0) && (sb.st_ctim.tv_sec < (now.tv_sec - 1));
+
+	if (isSettled && (m_Stamp.nSize == previous.nSize) && (m_Stamp.nCtimeNanos == previous.nCtimeNanos) && (previous.nHash != 0)) {
+		fclose(fp);
+
+		m_Stamp.nHash = previous.nHash;
+		m_bUnchanged = true;
+		s_pThis = this;
+
+		DEBUG_PUTS("Unchanged");
+		DEBUG_EXIT
+		return true;
+	}
+
+	m_pBuffer = new char[m_Stamp.nSize + 1];
+	assert(m_pBuffer != nullptr);
+
+	const auto nBytes = fread(m_pBuffer, 1, m_Stamp.nSize, fp);
+	fclose(fp);
+
+	if (nBytes != m_Stamp.nSize) {
+		perror("fread");
+		delete[] m_pBuffer;
+		m_pBuffer = nullptr;
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_pBuffer[m_Stamp.nSize] = '\0';
+	m_Stamp.nHash = hash(m_pBuffer, m_Stamp.nSize);
+	m_bUnchanged = (m_Stamp.nHash == previous.nHash) && (m_Stamp.nSize == previous.nSize);
+
+	if (!m_bUnchanged) {
+		Index();
+	}
+
+	s_pThis = this;
+
+	DEBUG_PRINTF("nSize=%u, nHash=%.8x, m_bUnchanged=%d, m_nSections=%u", m_Stamp.nSize, m_Stamp.nHash, m_bUnchanged, m_nSections);
+	DEBUG_EXIT
+	return true;
+}
+
+/*
+ * A section runs from the line after [name] up to the next [ at the start of a line
+ */
+void Bundle::Index() {
+	auto *p = m_pBuffer;
+	Section *pCurrent = nullptr;
+
+	while (*p != '\0') {
+		if (*p == '[') {
+			auto *pEnd = strchr(p, ']');
+			auto *pEol = strpbrk(p, "\r\n");
+
+			if (pCurrent != nullptr) {
+				pCurrent->nLength = static_cast<uint32_t>(p - pCurrent->pData);
+				pCurrent = nullptr;
+			}
+
+			if ((pEnd != nullptr) && ((pEol == nullptr) || (pEnd < pEol))) {
+				if (m_nSections < bundle::SECTIONS_MAX) {
+					*pEnd = '\0';
+					pCurrent = &m_Sections[m_nSections++];
+					pCurrent->pName = p + 1;
+					pCurrent->pData = (pEol != nullptr) ? pEol : pEnd + 1;
+					pCurrent->nLength = 0;
+
+					while ((*pCurrent->pData == '\r') || (*pCurrent->pData == '\n')) {
+						pCurrent->pData++;
+					}
+
+					p = pEnd + 1;
+				} else {
+					printf("Bundle: too many sections\n");
+				}
+			}
+		}
+
+		while ((*p != '\0') && (*p != '\n')) {
+			p++;
+		}
+
+		if (*p == '\n') {
+			p++;
+		}
+	}
+
+	if (pCurrent != nullptr) {
+		pCurrent->nLength = static_cast<uint32_t>(p - pCurrent->pData);
+	}
+}
+
+bool Bundle::Find(const char *pName, const char *& pData, uint32_t& nLength) const {
+	assert(pName != nullptr);
+
+	for (uint32_t i = 0; i < m_nSections; i++) {
+		if (strcmp(m_Sections[i].pName, pName) == 0) {
+			pData = m_Sections[i].pData;
+			nLength = m_Sections[i].nLength;
+			return true;
+		}
+	}
+
+	return false;
+}
+}  // namespace properties
+
+#endif
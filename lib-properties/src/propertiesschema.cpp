@@ -0,0 +1,98 @@
+/**
+ * @file propertiesschema.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "propertiesschema.h"
+#include "sscan.h"
+
+namespace properties {
+namespace schema {
+template<typename T>
+static Sscan::ReturnCode store_integer(const Key& key, T nValue, uint8_t *pMember) {
+	if ((nValue < key.nMin) || (nValue > key.nMax)) {
+		return Sscan::VALUE_ERROR;
+	}
+
+	memcpy(pMember, &nValue, sizeof(T));
+	return Sscan::OK;
+}
+
+uint32_t store(const Key& key, const char *pValue, void *pParams) {
+	assert(pValue != nullptr);
+	assert(pParams != nullptr);
+
+	auto *pMember = reinterpret_cast<uint8_t *>(pParams) + key.nOffset;
+	Sscan::ReturnCode rc;
+
+	switch (key.type) {
+	case Type::UINT8: {
+		uint8_t nValue;
+		if ((rc = Sscan::Uint8(pValue, nValue)) == Sscan::OK) {
+			rc = store_integer(key, nValue, pMember);
+		}
+	}
+		break;
+	case Type::UINT16: {
+		uint16_t nValue;
+		if ((rc = Sscan::Uint16(pValue, nValue)) == Sscan::OK) {
+			rc = store_integer(key, nValue, pMember);
+		}
+	}
+		break;
+	case Type::UINT32: {
+		uint32_t nValue;
+		if ((rc = Sscan::Uint32(pValue, nValue)) == Sscan::OK) {
+			rc = store_integer(key, nValue, pMember);
+		}
+	}
+		break;
+	case Type::FLOAT: {
+		float fValue;
+		if ((rc = Sscan::Float(pValue, fValue)) == Sscan::OK) {
+			if ((key.nMin != 0) && (fValue == 0)) {
+				rc = Sscan::VALUE_ERROR;
+			} else {
+				memcpy(pMember, &fValue, sizeof(float));
+			}
+		}
+	}
+		break;
+	case Type::HANDLER:
+		assert(key.pHandler != nullptr);
+		key.pHandler(pParams, pValue, key.nMin);
+		return 0;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
+	}
+
+	return (rc == Sscan::OK) ? key.nMask : 0;
+}
+}  // namespace schema
+}  // namespace properties
@@ -1,7 +1,7 @@
 /**
  * @file readconfigfile.cpp
  */
-/* Copyright (C) 2017-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2017-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -22,12 +22,14 @@
  * THE SOFTWARE.
  */
 
+#include <cstdint>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <cassert>
 
 #include "readconfigfile.h"
+#include "propertiesbundle.h"
 
 #include "debug.h"
 
@@ -51,6 +53,23 @@ ReadConfigFile::~ReadConfigFile() {
 bool ReadConfigFile::Read(const char *pFileName) {
 	assert(pFileName != nullptr);
 
+	const auto *pBundle = properties::Bundle::Get();
+
+	if (pBundle != nullptr) {
+		const char *pData;
+		uint32_t nLength;
+
+		if (pBundle->IsUnchanged() || !pBundle->Find(pFileName, pData, nLength)) {
+			return false;
+		}
+
+		if (nLength != 0) {
+			Read(pData, nLength);
+		}
+
+		return true;
+	}
+
 	char buffer[MAX_LINE_LENGTH];
 
 	FILE *fp = fopen(pFileName, "r");
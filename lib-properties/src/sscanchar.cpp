@@ -2,7 +2,7 @@
  * @file sscanchar.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -44,10 +44,18 @@ Sscan::ReturnCode Sscan::Char(const char *pBuffer, const char *pName, char *pVal
 		return Sscan::NAME_ERROR;
 	}
 
+	return Char(p, pValue, nLength);
+}
+
+Sscan::ReturnCode Sscan::Char(const char *pValue, char *pString, uint32_t& nLength) {
+	assert(pValue != nullptr);
+	assert(pString != nullptr);
+
+	const auto *p = pValue;
 	uint16_t k = 0;
 
 	while ((*p != 0) && (k < nLength)) {
-		*pValue++ = *p++;
+		*pString++ = *p++;
 		k++;
 	}
 
@@ -2,7 +2,7 @@
  * @file sscanfloat.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -44,6 +44,14 @@ Sscan::ReturnCode Sscan::Float(const char *pBuffer, const char *pName, float &fV
 		return Sscan::NAME_ERROR;
 	}
 
+	return Float(p, fValue);
+}
+
+Sscan::ReturnCode Sscan::Float(const char *pValue, float& fValue) {
+	assert(pValue != nullptr);
+
+	const auto *p = pValue;
+
 	auto bIsNegatieve = false;
 
 	if (*p == '-') {
@@ -2,7 +2,7 @@
  * @file sscanipaddress.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -43,14 +43,21 @@ Sscan::ReturnCode Sscan::IpAddress(const char *pBuffer, const char *pName, uint3
 	assert(pBuffer != nullptr);
 	assert(pName != nullptr);
 
-	_pcast32 cast32;
-
 	const char *p;
 
 	if ((p = Sscan::checkName(pBuffer, pName)) == nullptr) {
 		 return Sscan::NAME_ERROR;
 	}
 
+	return IpAddress(p, nIpAddress);
+}
+
+Sscan::ReturnCode Sscan::IpAddress(const char *pValue, uint32_t& nIpAddress) {
+	assert(pValue != nullptr);
+
+	_pcast32 cast32;
+
+	const auto *p = pValue;
 	uint32_t i, j, k;
 
 	for (i = 0; i < 3; ++i) {
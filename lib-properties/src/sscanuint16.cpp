@@ -2,7 +2,7 @@
  * @file sscanuint16.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -44,6 +44,14 @@ Sscan::ReturnCode Sscan::Uint16(const char *pBuffer, const char *pName, uint16_t
 		return Sscan::NAME_ERROR;
 	}
 
+	return Uint16(p, nValue);
+}
+
+Sscan::ReturnCode Sscan::Uint16(const char *pValue, uint16_t& nValue) {
+	assert(pValue != nullptr);
+
+	const auto *p = pValue;
+
 	uint32_t k = 0;
 
 	do {
@@ -2,7 +2,7 @@
  * @file sscanuint8.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -44,6 +44,14 @@ Sscan::ReturnCode Sscan::Uint8(const char *pBuffer, const char *pName, uint8_t &
 		return Sscan::NAME_ERROR;
 	}
 
+	return Uint8(p, nValue);
+}
+
+Sscan::ReturnCode Sscan::Uint8(const char *pValue, uint8_t& nValue) {
+	assert(pValue != nullptr);
+
+	const auto *p = pValue;
+
 	uint32_t k = 0;
 
 	do {
@@ -45,3 +45,26 @@ static constexpr char date_js[] = {
 0x73, 0x65, 0x74, 0x48, 0x6F, 0x75, 0x72, 0x7D, 0x3A, 0x24, 0x7B, 0x6F, 0x66, 0x66, 0x73, 0x65,
 0x74, 0x4D, 0x69, 0x6E, 0x7D, 0x60, 0x3B, 0x20, 0x20, 0x20, 0x0A, 0x7D, 0x00
 };
+
+static constexpr uint8_t date_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9D, 0x52, 0x3D, 0x6F, 0x83, 0x30,
+0x10, 0xDD, 0xF9, 0x15, 0x37, 0xD0, 0x70, 0x56, 0x04, 0xA5, 0x1D, 0x3A, 0x84, 0xA2, 0x2E, 0x55,
+0x95, 0x05, 0x75, 0x68, 0x96, 0x76, 0x0A, 0x05, 0x13, 0x2C, 0x81, 0x2D, 0x81, 0x19, 0x52, 0xC4,
+0x7F, 0xEF, 0x5D, 0x9A, 0x0F, 0x1A, 0xE8, 0xD2, 0xC5, 0x67, 0xBD, 0x7B, 0xEF, 0xFC, 0xEE, 0xCE,
+0x45, 0xA7, 0x33, 0xAB, 0x8C, 0x86, 0xC2, 0x34, 0x75, 0x6A, 0x9F, 0x53, 0x2B, 0x37, 0xAA, 0x96,
+0x98, 0xD3, 0x45, 0x40, 0xEF, 0x64, 0x46, 0xB7, 0x16, 0xF6, 0x32, 0x6D, 0x20, 0x06, 0x06, 0x83,
+0x9D, 0xB4, 0x2F, 0x5D, 0x55, 0xBD, 0x13, 0x84, 0x22, 0x3A, 0x12, 0x6A, 0xAA, 0x10, 0x03, 0x7A,
+0xA1, 0x07, 0x4B, 0xC0, 0x13, 0x2F, 0x31, 0xDA, 0x96, 0x28, 0x08, 0xBA, 0x13, 0x22, 0x68, 0x2B,
+0x95, 0x49, 0xF4, 0xEF, 0xCF, 0xA2, 0x3C, 0xDD, 0x5F, 0x44, 0x27, 0x0D, 0x3B, 0xC0, 0x39, 0x76,
+0x69, 0xBA, 0x66, 0x4A, 0x5F, 0x13, 0xDA, 0xCE, 0xF2, 0x6B, 0xA5, 0xA7, 0xF4, 0x44, 0xE9, 0xCE,
+0xCA, 0x79, 0x41, 0x2B, 0xB3, 0xA9, 0xE0, 0x4D, 0x52, 0x32, 0x9F, 0x17, 0x98, 0xA2, 0x68, 0xA5,
+0x1D, 0xCD, 0x85, 0x27, 0xF7, 0x65, 0xB4, 0x7C, 0x3D, 0x24, 0xF0, 0x8A, 0xB8, 0xFE, 0xD5, 0x40,
+0x92, 0xDA, 0x32, 0x28, 0x2A, 0x63, 0x1A, 0x3C, 0x5C, 0xD3, 0xCF, 0x16, 0x7F, 0x78, 0x02, 0x6E,
+0xE1, 0x21, 0xFC, 0xFB, 0xC1, 0x64, 0xDC, 0xD8, 0x44, 0x7B, 0xC3, 0xDA, 0x99, 0xE6, 0xD4, 0x8E,
+0x55, 0x47, 0xCB, 0x8F, 0x31, 0x84, 0xF0, 0x04, 0xDE, 0xD2, 0x83, 0x15, 0x78, 0xBE, 0x17, 0x39,
+0xAA, 0x00, 0xC4, 0xB1, 0x4F, 0x62, 0x08, 0x58, 0x2C, 0x00, 0x47, 0x8F, 0x32, 0xC6, 0x9F, 0xA2,
+0x91, 0xB6, 0x6B, 0x34, 0x6C, 0xDD, 0x9E, 0x3F, 0xC6, 0xE0, 0xBB, 0x3D, 0xED, 0x9F, 0x03, 0x6D,
+0x74, 0xD8, 0xB8, 0x3D, 0xAF, 0x6A, 0x58, 0x11, 0xAA, 0x34, 0x07, 0x1A, 0xEC, 0xF0, 0xB1, 0x8D,
+0x00, 0x9C, 0x01, 0xFE, 0xA3, 0xA5, 0x93, 0xDC, 0x53, 0xB8, 0xF8, 0xE3, 0xD4, 0xD9, 0xD8, 0xC0,
+0xB5, 0xA9, 0xF8, 0x37, 0xCC, 0x53, 0xC1, 0xA9, 0xCC, 0x02, 0x00, 0x00, 
+};
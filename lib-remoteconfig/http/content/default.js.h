@@ -16,3 +16,20 @@ static constexpr char default_js[] = {
 0x6E, 0x73, 0x65, 0x2E, 0x6F, 0x6B, 0x29, 0x20, 0x7B, 0x20, 0x67, 0x65, 0x74, 0x5F, 0x74, 0x78,
 0x74, 0x28, 0x73, 0x65, 0x6C, 0x29, 0x3B, 0x20, 0x7D, 0x7D, 0x29, 0x3B, 0x0A, 0x7D, 0x00
 };
+
+static constexpr uint8_t default_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x3D, 0x4F, 0x31, 0x8E, 0xC2, 0x30,
+0x10, 0xEC, 0xFD, 0x8A, 0xED, 0x9C, 0x48, 0xB9, 0x5C, 0x9F, 0x08, 0x9A, 0xEB, 0xAE, 0x80, 0x93,
+0xA0, 0x3B, 0x21, 0x64, 0xE2, 0x0D, 0x31, 0xE4, 0xBC, 0x56, 0xBC, 0x20, 0xA2, 0xC8, 0x7F, 0x67,
+0x21, 0x70, 0xDD, 0xCC, 0xCE, 0x68, 0x76, 0xA6, 0xBD, 0xF8, 0x86, 0x1D, 0x79, 0x18, 0x30, 0x22,
+0x67, 0x11, 0xFB, 0x1C, 0x26, 0x75, 0x35, 0x03, 0x58, 0x58, 0xC0, 0x94, 0xEA, 0x27, 0xA6, 0x0B,
+0xBF, 0x98, 0xA0, 0x5F, 0x31, 0xED, 0x84, 0xDA, 0x59, 0x0B, 0x66, 0xEC, 0xC9, 0x3C, 0xDC, 0xDF,
+0x9B, 0xF5, 0xAA, 0x8C, 0x3C, 0x38, 0x7F, 0x74, 0xED, 0x98, 0x89, 0x35, 0xAF, 0x55, 0x8B, 0xDC,
+0x74, 0x99, 0xFE, 0x3C, 0x45, 0xF2, 0xBA, 0x90, 0xEC, 0x3F, 0xE4, 0x8E, 0x6C, 0x05, 0xFA, 0x67,
+0xBD, 0xD9, 0xEA, 0x42, 0x75, 0x68, 0x2C, 0x0E, 0xB1, 0x12, 0x49, 0x7F, 0x91, 0x67, 0xF4, 0xFC,
+0xB1, 0x1D, 0x03, 0x6A, 0xB1, 0x98, 0x10, 0x7A, 0xD7, 0x98, 0x47, 0xC1, 0x39, 0x40, 0xA5, 0x42,
+0x1D, 0xC8, 0x8E, 0xD5, 0xFB, 0xAD, 0x4A, 0x39, 0x94, 0xDC, 0xA1, 0xCF, 0x64, 0x40, 0x20, 0x1F,
+0x11, 0x16, 0x4B, 0x98, 0x5C, 0x0B, 0xFF, 0x87, 0x92, 0xCE, 0xB2, 0x09, 0x8E, 0xC8, 0x7B, 0xBE,
+0xCD, 0x13, 0x6B, 0x48, 0x49, 0xBA, 0xA5, 0x3B, 0x57, 0x00, 0x60, 0x78, 0xFE, 0x00, 0x00, 0x00,
+
+};
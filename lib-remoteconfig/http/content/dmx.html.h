@@ -34,3 +34,24 @@ static constexpr char dmx_html[] = {
 0x29, 0x3C, 0x2F, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3E, 0x0A, 0x3C, 0x2F, 0x62, 0x6F, 0x64,
 0x79, 0x3E, 0x0A, 0x3C, 0x2F, 0x68, 0x74, 0x6D, 0x6C, 0x3E, 0x00
 };
+
+static constexpr uint8_t dmx_html_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x52, 0xCD, 0x4E, 0xC3, 0x30,
+0x0C, 0xBE, 0xF7, 0x29, 0x42, 0x2E, 0xDB, 0x2E, 0x8B, 0x38, 0xE3, 0xE6, 0xC2, 0xB8, 0x81, 0x98,
+0x00, 0x21, 0x38, 0xA6, 0xA9, 0xA7, 0x66, 0xCB, 0x9A, 0x2A, 0x71, 0xAB, 0xED, 0xED, 0xF1, 0x9A,
+0x6E, 0x62, 0x20, 0x21, 0x71, 0xB2, 0x65, 0x7F, 0x3F, 0xB6, 0x13, 0xB8, 0x59, 0x3D, 0xDF, 0xBF,
+0x7D, 0xAE, 0x1F, 0x44, 0x43, 0x7B, 0xAF, 0x0B, 0x38, 0x07, 0x34, 0xB5, 0x06, 0xEF, 0xDA, 0x9D,
+0x88, 0xE8, 0x4B, 0x99, 0xE8, 0xE8, 0x31, 0x35, 0x88, 0x24, 0x45, 0x13, 0x71, 0x73, 0xAE, 0x2C,
+0x6D, 0x4A, 0x52, 0x28, 0x0D, 0xE4, 0xC8, 0xA3, 0x5E, 0x3D, 0x7D, 0x80, 0xCA, 0x29, 0xA8, 0x51,
+0xA3, 0x80, 0x2A, 0xD4, 0xC7, 0x49, 0x11, 0xA3, 0x86, 0xDE, 0x0B, 0x57, 0x97, 0xD2, 0xD5, 0x8F,
+0x2E, 0x91, 0x64, 0x58, 0xEF, 0x27, 0x2C, 0x77, 0x0B, 0xE8, 0x34, 0x54, 0x3D, 0x51, 0x68, 0x45,
+0x68, 0xAD, 0x77, 0x76, 0x57, 0x4A, 0xB6, 0x8B, 0xEC, 0x3D, 0x5F, 0x48, 0xFD, 0x92, 0x53, 0x50,
+0x19, 0xC3, 0xC4, 0x8E, 0x39, 0xB5, 0x1B, 0x84, 0xF5, 0x26, 0xA5, 0xD3, 0x54, 0x86, 0x12, 0xAB,
+0x92, 0xA9, 0x3C, 0x4E, 0x46, 0xAF, 0x63, 0x4D, 0x54, 0x21, 0xB2, 0x45, 0x39, 0xBB, 0x9D, 0x31,
+0x6D, 0xEC, 0x73, 0x64, 0xEA, 0xB5, 0x40, 0x17, 0xE2, 0x2F, 0x81, 0xF5, 0x58, 0xFB, 0x4B, 0x60,
+0x13, 0x02, 0x5D, 0x2D, 0xF7, 0x8E, 0x31, 0xB9, 0xD0, 0x5E, 0xF6, 0x9B, 0x00, 0x05, 0x24, 0x1B,
+0x5D, 0x47, 0x22, 0x45, 0x9B, 0x87, 0x75, 0x76, 0xB9, 0x65, 0x6D, 0x3A, 0x76, 0x58, 0x4A, 0xC2,
+0x03, 0xA9, 0xAD, 0x19, 0x4C, 0x46, 0x9D, 0xD8, 0x39, 0xFB, 0x41, 0xAC, 0xF7, 0x87, 0x7F, 0xB1,
+0xB4, 0xE7, 0x5B, 0xCF, 0x17, 0x77, 0x43, 0x9E, 0x8A, 0xB3, 0xCB, 0x4D, 0xBF, 0x61, 0xD5, 0xF4,
+0x52, 0x6A, 0xFC, 0x03, 0x5F, 0xF8, 0x90, 0x25, 0xF0, 0x1A, 0x02, 0x00, 0x00, 
+};
@@ -86,3 +86,42 @@ static constexpr char dmx_js[] = {
 0x63, 0x61, 0x74, 0x63, 0x68, 0x20, 0x28, 0x65, 0x72, 0x72, 0x6F, 0x72, 0x29, 0x7B, 0x7D, 0x0A,
 0x7D, 0x00
 };
+
+static constexpr uint8_t dmx_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8D, 0x54, 0x5D, 0x6F, 0x9B, 0x30,
+0x14, 0x7D, 0xE7, 0x57, 0x5C, 0xA1, 0x49, 0x80, 0x92, 0x11, 0x69, 0xD5, 0x5E, 0x92, 0xC0, 0xA4,
+0x2E, 0xD5, 0xD6, 0x69, 0xDD, 0xAA, 0x66, 0x0F, 0x7B, 0x8C, 0x8B, 0x9D, 0x82, 0x04, 0x36, 0xB2,
+0x9D, 0xB6, 0x11, 0xE2, 0xBF, 0xEF, 0xDA, 0x0E, 0x6E, 0xC2, 0x12, 0x6D, 0x79, 0x88, 0xF0, 0x39,
+0xE7, 0x7E, 0x70, 0x7D, 0x2E, 0x44, 0xED, 0x79, 0x01, 0xDB, 0x1D, 0x2F, 0x74, 0x25, 0x38, 0x48,
+0xB6, 0x95, 0x4C, 0x95, 0x71, 0x02, 0x5D, 0xA0, 0xE5, 0x1E, 0xFF, 0x6B, 0xA6, 0x81, 0x66, 0xE4,
+0x85, 0x54, 0x1A, 0x9E, 0x98, 0xFE, 0xB6, 0xFE, 0xF9, 0x23, 0x8E, 0x68, 0xF3, 0x3A, 0x6B, 0x85,
+0xD4, 0x4A, 0x13, 0xBD, 0x53, 0x51, 0x62, 0x55, 0x25, 0x95, 0x2A, 0x8B, 0x96, 0x5A, 0xE6, 0x91,
+0x3D, 0x6B, 0x4A, 0x87, 0x23, 0x4D, 0xB7, 0x42, 0xDE, 0x90, 0xA2, 0x8C, 0x2B, 0xCD, 0x1A, 0xC8,
+0x72, 0x4C, 0x6C, 0xE4, 0x93, 0x6C, 0xB3, 0xD4, 0x65, 0xFE, 0xAE, 0x33, 0x70, 0x6A, 0x32, 0xF6,
+0xCB, 0x19, 0x02, 0x9B, 0x00, 0x83, 0x2D, 0x49, 0x07, 0x92, 0x56, 0x92, 0xD9, 0x1E, 0x8D, 0x82,
+0xA2, 0xA2, 0x4F, 0x16, 0x01, 0x15, 0xC5, 0xAE, 0x61, 0x5C, 0xA7, 0xD8, 0xD9, 0x4D, 0xCD, 0xCC,
+0xE3, 0xF5, 0xFE, 0x96, 0xC6, 0x61, 0x45, 0xD7, 0xD8, 0x9A, 0x0A, 0x93, 0xB4, 0xE2, 0x9C, 0xC9,
+0xAF, 0xBF, 0xEE, 0xBE, 0x67, 0xB6, 0x60, 0x84, 0xD1, 0xD8, 0xD1, 0xC4, 0xE4, 0x3F, 0x3C, 0xBB,
+0x66, 0x25, 0x64, 0xE0, 0xDE, 0xF2, 0x5E, 0x8A, 0xA6, 0x52, 0x2C, 0x25, 0x75, 0x1D, 0x63, 0xE7,
+0x0D, 0x69, 0x7D, 0xD7, 0x27, 0x03, 0x70, 0x2F, 0xFF, 0x29, 0x82, 0x09, 0xF8, 0xF6, 0x93, 0x54,
+0x97, 0x8C, 0xC7, 0x38, 0xC3, 0xD6, 0xE8, 0xE3, 0x2E, 0x30, 0xE8, 0xFC, 0x4D, 0x30, 0x0D, 0xE8,
+0x1C, 0x3A, 0x50, 0xD8, 0xE9, 0x1C, 0x8C, 0x2C, 0xC5, 0x54, 0xA9, 0x39, 0x4E, 0xF1, 0x58, 0xB0,
+0xEA, 0x99, 0xD1, 0x23, 0x62, 0x80, 0xA0, 0x9F, 0x06, 0x12, 0x03, 0x03, 0x17, 0xD8, 0x41, 0x51,
+0x13, 0xA5, 0x0E, 0x42, 0x49, 0x1B, 0x9B, 0x21, 0xB5, 0xE0, 0x14, 0x68, 0xA5, 0x0A, 0xF1, 0xCC,
+0xE4, 0x7E, 0xCC, 0x7B, 0xC2, 0xA6, 0xF3, 0xD5, 0x3A, 0x78, 0x12, 0x82, 0x1E, 0x89, 0x07, 0x2A,
+0x35, 0xF8, 0x14, 0x1E, 0xC9, 0x59, 0x12, 0xE1, 0xF3, 0xB5, 0xBC, 0xC2, 0x93, 0x41, 0xDF, 0xF7,
+0x09, 0xFE, 0x16, 0x68, 0xAA, 0x54, 0xE1, 0x18, 0xE2, 0x98, 0x60, 0xDE, 0xC4, 0x39, 0x41, 0x32,
+0xBD, 0x93, 0x1C, 0xD0, 0x24, 0x15, 0xA7, 0xB7, 0x9C, 0xB2, 0x57, 0x3F, 0x70, 0x3F, 0x37, 0xC8,
+0x32, 0xBC, 0x1F, 0x37, 0x63, 0x78, 0xFF, 0x1F, 0xDA, 0x47, 0xA7, 0xB5, 0x36, 0x79, 0x73, 0x26,
+0xBA, 0x0D, 0xA4, 0x78, 0x51, 0x2D, 0xE1, 0x59, 0x78, 0x15, 0xE6, 0xF7, 0xA8, 0xB1, 0x8E, 0x33,
+0x44, 0x21, 0x6A, 0x47, 0x7C, 0x08, 0xF3, 0xD5, 0xDD, 0xEF, 0xBF, 0xF1, 0x8F, 0x61, 0xFE, 0xB0,
+0xBA, 0x73, 0xF8, 0xCC, 0x66, 0x1B, 0x65, 0xC4, 0xC0, 0x35, 0x0E, 0xDA, 0x47, 0x1E, 0x13, 0x0F,
+0x87, 0xA9, 0x9C, 0x2D, 0x77, 0x12, 0xE5, 0x89, 0xAB, 0x71, 0xD4, 0x51, 0xD1, 0xFC, 0xB3, 0xB9,
+0xEC, 0x21, 0x26, 0x5F, 0x0D, 0xA3, 0xF6, 0xC8, 0x17, 0xBC, 0x3B, 0x7F, 0xB8, 0x26, 0xF4, 0x92,
+0xD4, 0xED, 0x80, 0x5D, 0xD6, 0xC8, 0x5C, 0xCF, 0xB0, 0xA9, 0xAD, 0xBB, 0x9C, 0x61, 0x11, 0x4D,
+0x51, 0xB3, 0x8C, 0xAD, 0x5F, 0x53, 0xEA, 0x11, 0x6A, 0xED, 0x35, 0xC6, 0x06, 0x1B, 0x9C, 0xE2,
+0xF2, 0xC8, 0xAA, 0x67, 0x19, 0x6F, 0x9A, 0x31, 0x7B, 0xE2, 0xCA, 0x8B, 0x24, 0xBA, 0xF2, 0x22,
+0x37, 0x4E, 0x6D, 0x5E, 0x7D, 0xB3, 0xF8, 0xD7, 0x97, 0xC4, 0x78, 0xE4, 0xCC, 0x97, 0x04, 0x07,
+0x13, 0xF4, 0x50, 0x10, 0x5D, 0x94, 0x10, 0x33, 0x29, 0x85, 0x4C, 0xBA, 0x3E, 0xE8, 0xFF, 0x00,
+0xD4, 0x61, 0x89, 0xD8, 0x51, 0x05, 0x00, 0x00, 
+};
@@ -28,3 +28,23 @@ static constexpr char dsa_html[] = {
 0x65, 0x73, 0x68, 0x28, 0x29, 0x3C, 0x2F, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3E, 0x0A, 0x3C,
 0x2F, 0x62, 0x6F, 0x64, 0x79, 0x3E, 0x0A, 0x3C, 0x2F, 0x68, 0x74, 0x6D, 0x6C, 0x3E, 0x0A, 0x00
 };
+
+static constexpr uint8_t dsa_html_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x91, 0xB1, 0x6E, 0x03, 0x21,
+0x0C, 0x86, 0xF7, 0x7B, 0x0A, 0xCA, 0x92, 0x64, 0x09, 0xEA, 0x5C, 0x60, 0x69, 0xBB, 0x55, 0x4A,
+0x54, 0x45, 0x95, 0x3A, 0x72, 0xE0, 0xE8, 0x48, 0xE8, 0x71, 0x02, 0x5F, 0x94, 0x7B, 0xFB, 0x1A,
+0x41, 0xA2, 0xB6, 0x5B, 0x27, 0x5B, 0xF8, 0xFB, 0xED, 0xDF, 0x46, 0x3E, 0xBC, 0xEC, 0x9E, 0x0F,
+0x9F, 0xFB, 0x57, 0x36, 0xE0, 0x57, 0xD0, 0x9D, 0xBC, 0x05, 0x30, 0x8E, 0x42, 0xF0, 0xE3, 0x99,
+0x25, 0x08, 0x8A, 0x67, 0x5C, 0x02, 0xE4, 0x01, 0x00, 0x39, 0x1B, 0x12, 0x1C, 0x6F, 0x2F, 0x5B,
+0x9B, 0x33, 0x67, 0x82, 0x58, 0xF4, 0x18, 0x40, 0x4B, 0x51, 0x63, 0x27, 0x45, 0xEB, 0xD1, 0x47,
+0xB7, 0xB4, 0x8E, 0x90, 0xB4, 0x9C, 0x03, 0xF3, 0x4E, 0x71, 0xEF, 0xDE, 0x7C, 0x46, 0x4E, 0xFC,
+0x1C, 0x74, 0x65, 0xA9, 0xDA, 0xC9, 0x49, 0xCB, 0x7E, 0x46, 0x8C, 0x23, 0x8B, 0xA3, 0x0D, 0xDE,
+0x9E, 0x15, 0xA7, 0x69, 0x89, 0x46, 0xAF, 0x37, 0x5C, 0xBF, 0xD7, 0x54, 0x8A, 0xCA, 0x90, 0x70,
+0x2A, 0x93, 0x4D, 0x1F, 0xA0, 0x75, 0x3D, 0x5C, 0xC9, 0x60, 0x1F, 0x13, 0x75, 0x53, 0xAB, 0xC7,
+0x55, 0xF1, 0x53, 0xAA, 0x44, 0x1D, 0x63, 0xC4, 0x5F, 0x06, 0x3E, 0x20, 0x65, 0x1F, 0xC7, 0xBB,
+0x87, 0x06, 0x74, 0x32, 0xDB, 0xE4, 0x27, 0x64, 0x39, 0xD9, 0xB2, 0xA5, 0x41, 0x6F, 0xB7, 0x27,
+0x5A, 0x12, 0x97, 0x09, 0x14, 0x47, 0xB8, 0xA2, 0x38, 0x99, 0x8B, 0xA9, 0x54, 0x51, 0xD7, 0xEC,
+0x8F, 0xD0, 0x65, 0xF3, 0x2F, 0x95, 0x0E, 0x74, 0x8F, 0xF5, 0xE6, 0xE9, 0x52, 0x5D, 0x51, 0x76,
+0xDF, 0xFB, 0x07, 0x2B, 0xDA, 0x35, 0x45, 0xFD, 0xA7, 0x6F, 0x39, 0x97, 0xDC, 0x94, 0xBF, 0x01,
+0x00, 0x00, 
+};
@@ -39,3 +39,25 @@ static constexpr char dsa_js[] = {
 0x78, 0x74, 0x22, 0x29, 0x2E, 0x69, 0x6E, 0x6E, 0x65, 0x72, 0x48, 0x54, 0x4D, 0x4C, 0x20, 0x3D,
 0x20, 0x68, 0x3B, 0x0A, 0x7D, 0x00
 };
+
+static constexpr uint8_t dsa_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xAD, 0x90, 0x5D, 0x4B, 0xC3, 0x30,
+0x14, 0x86, 0xEF, 0xFB, 0x2B, 0xC2, 0x10, 0xDA, 0x22, 0xB4, 0x3F, 0xA0, 0x1F, 0xE0, 0xC7, 0x44,
+0xA5, 0x4E, 0x61, 0xC3, 0xEB, 0x65, 0x4D, 0x6A, 0x82, 0x59, 0x52, 0x92, 0x53, 0xB7, 0x31, 0xF6,
+0xDF, 0x3D, 0x69, 0x67, 0x11, 0x8A, 0x7A, 0xE3, 0x45, 0x21, 0xEF, 0x7B, 0x3E, 0xFA, 0x9C, 0x97,
+0xBA, 0x83, 0xAE, 0x49, 0xD3, 0xE9, 0x1A, 0xA4, 0xD1, 0xC4, 0xF2, 0xC6, 0x72, 0x27, 0xA2, 0x98,
+0x1C, 0x03, 0xC5, 0x81, 0x30, 0x0A, 0x94, 0x14, 0x84, 0xEE, 0xA8, 0x04, 0xF2, 0xC6, 0xE1, 0x71,
+0xF9, 0xBC, 0x88, 0x42, 0xE6, 0x68, 0xDA, 0x1A, 0x0B, 0x0E, 0x28, 0x74, 0x2E, 0x8C, 0xFB, 0x56,
+0x81, 0x7D, 0x61, 0x0E, 0x74, 0xA3, 0x78, 0x99, 0x83, 0xC5, 0x4F, 0x94, 0x2F, 0xD8, 0x94, 0xA7,
+0xF8, 0xF0, 0xA2, 0x92, 0xFA, 0x7D, 0x14, 0xCB, 0x96, 0x73, 0x36, 0xAA, 0xDB, 0xAE, 0x55, 0x7C,
+0x3F, 0xCA, 0x3B, 0x65, 0x76, 0xE4, 0xC6, 0x68, 0xB0, 0x46, 0x0D, 0x66, 0x8A, 0x0B, 0xC3, 0x2C,
+0xF0, 0x38, 0x49, 0x63, 0xEC, 0x9C, 0xD6, 0x22, 0x92, 0xC0, 0xB7, 0xA4, 0x28, 0x91, 0x54, 0x90,
+0xCB, 0x82, 0xAC, 0x87, 0x9F, 0xB2, 0xF2, 0xE2, 0xE8, 0x2B, 0x89, 0x07, 0x3C, 0xE1, 0x20, 0xFB,
+0x6E, 0x2A, 0x64, 0x98, 0x98, 0xCE, 0xB3, 0x4C, 0x5C, 0xD6, 0x33, 0x4D, 0xEC, 0x06, 0xD9, 0xEA,
+0x01, 0xED, 0x5C, 0xF3, 0x6C, 0xEB, 0x2C, 0x38, 0xC5, 0xD9, 0x00, 0x12, 0xA2, 0xD3, 0xA7, 0x10,
+0x7E, 0xE9, 0x0D, 0xC2, 0x07, 0x3F, 0x47, 0xF9, 0xA1, 0xA8, 0xEE, 0x27, 0x30, 0xC9, 0xF3, 0xC4,
+0x2F, 0x31, 0xBE, 0x56, 0x57, 0x8B, 0x95, 0x2F, 0xFF, 0x6F, 0x32, 0xE3, 0xDA, 0xBF, 0xAF, 0x62,
+0xA6, 0xEE, 0xB6, 0x5C, 0x43, 0x82, 0x57, 0xCC, 0x15, 0xF7, 0xCF, 0xEB, 0xC3, 0x03, 0x8B, 0x66,
+0x92, 0xAD, 0xF6, 0x30, 0x8B, 0x13, 0xA9, 0x35, 0xB7, 0xF7, 0xAB, 0xA7, 0x0A, 0xEF, 0x15, 0xB8,
+0xE3, 0x13, 0xEB, 0x00, 0x0C, 0xC1, 0x65, 0x02, 0x00, 0x00, 
+};
@@ -44,6 +44,9 @@ static constexpr char content_header[] =
 		"\tconst char *pFileName;\n"
 		"\tconst char *pContent;\n"
 		"\tconst uint32_t nContentLength;\n"
+		"\tconst uint8_t *pContentGzip;\n"
+		"\tconst uint32_t nContentGzipLength;\n"
+		"\tconst uint32_t nETag;\n"
 		"\tconst http::contentTypes contentType;\n"
 		"};\n\n"
 		"static constexpr struct FilesContent HttpContent[] = {\n";
@@ -86,6 +89,58 @@ static http::contentTypes getContentType(const char *pFileName) {
 	return http::contentTypes::NOT_DEFINED;
 }
 
+static void write_array(FILE *pFileOut, const char *pData, const int nSize) {
+	char buffer[8];
+
+	for (int nOffset = 0; nOffset < nSize; nOffset++) {
+		const auto i = snprintf(buffer, sizeof(buffer) - 1, "0x%02X,%c", static_cast<uint8_t>(pData[nOffset]), (nOffset + 1) % 16 == 0 ? '\n' : ' ');
+		assert(i < static_cast<int>(sizeof(buffer)));
+
+		fwrite(buffer, sizeof(char), i, pFileOut);
+	}
+}
+
+static int write_gzip(FILE *pFileOut, const char *pConstantName, const char *pData, const int nSize) {
+	static constexpr char TMP_FILE_NAME[] = "generate_content.tmp";
+
+	auto *pFileTmp = fopen(TMP_FILE_NAME, "w");
+	assert(pFileTmp != nullptr);
+
+	fwrite(pData, sizeof(char), nSize, pFileTmp);
+	fclose(pFileTmp);
+
+	char command[64];
+	snprintf(command, sizeof(command) - 1, "gzip -9 -n -c %s", TMP_FILE_NAME);
+
+	auto *pPipe = popen(command, "r");
+	assert(pPipe != nullptr);
+
+	fwrite("\nstatic constexpr uint8_t ", sizeof(char), 26, pFileOut);
+	fwrite(pConstantName, sizeof(char), strlen(pConstantName), pFileOut);
+	fwrite("_gz[] = {\n", sizeof(char), 10, pFileOut);
+
+	char buffer[8];
+	int nGzipSize = 0;
+	int c;
+
+	while ((c = fgetc(pPipe)) != EOF) {
+		const auto i = snprintf(buffer, sizeof(buffer) - 1, "0x%02X,%c", c, ++nGzipSize % 16 == 0 ? '\n' : ' ');
+		assert(i < static_cast<int>(sizeof(buffer)));
+
+		fwrite(buffer, sizeof(char), i, pFileOut);
+	}
+
+	const auto nStatus = pclose(pPipe);
+	assert(nStatus == 0);
+	(void)nStatus;
+
+	fwrite("\n};\n", sizeof(char), 4, pFileOut);
+
+	remove(TMP_FILE_NAME);
+
+	return nGzipSize;
+}
+
 static int convert_to_h(const char *pFileName) {
 	printf("File to convert: %s, ", pFileName);
 
@@ -95,6 +150,10 @@ static int convert_to_h(const char *pFileName) {
 		return 0;
 	}
 
+	fseek(pFileIn, 0, SEEK_END);
+	const auto nFileSize = ftell(pFileIn);
+	fseek(pFileIn, 0, SEEK_SET);
+
 	const auto nFileNameLength = strlen(pFileName);
 
 	auto *pFileNameOut = new char[nFileNameLength + 3];
@@ -112,7 +171,7 @@ static int convert_to_h(const char *pFileName) {
 		return 0;
 	}
 
-	char buffer[64];
+	char buffer[128];
 
 	const auto bHasDSA = (strstr(pFileNameOut, "dsa") != nullptr);
 
@@ -196,12 +255,13 @@ static int convert_to_h(const char *pFileName) {
 	printf("Constant name: %s, ", pConstantName);
 
 	fwrite(pConstantName, sizeof(char), strlen(pConstantName), pFileOut);
-	fwrite(pConstantName, sizeof(char), strlen(pConstantName), pFileContent);
 	fwrite("[] = {\n", sizeof(char), 7, pFileOut);
 
-	unsigned nOffset = 0;
+	auto *pStripped = new char[nFileSize + 1];
+	assert(pStripped != nullptr);
+
 	auto doRemoveWhiteSpaces = true;
-	int nFileSize = 0;
+	int nStrippedSize = 0;
 	int c;
 
 	while ((c = fgetc (pFileIn)) != EOF) {
@@ -217,25 +277,34 @@ static int convert_to_h(const char *pFileName) {
 			}
 		}
 
-		i = snprintf(buffer, sizeof(buffer) - 1, "0x%02X,%c", c, ++nOffset % 16 == 0 ? '\n' : ' ');
-		assert(i < static_cast<int>(sizeof(buffer)));
-
-		fwrite(buffer, sizeof(char), i, pFileOut);
-
-		nFileSize++;
+		pStripped[nStrippedSize++] = static_cast<char>(c);
 	}
 
+	write_array(pFileOut, pStripped, nStrippedSize);
 	fwrite("0x00\n};\n", sizeof(char), 8, pFileOut);
 
+	/*
+	 * The gzip variant is served when the client sends "Accept-Encoding: gzip".
+	 * -n leaves out the name and time stamp, so the output is reproducible.
+	 */
+
+	const auto nGzipSize = write_gzip(pFileOut, pConstantName, pStripped, nStrippedSize);
+	const auto nETag = http::etag(pStripped, static_cast<uint32_t>(nStrippedSize));
+
+	i = snprintf(buffer, sizeof(buffer) - 1, "%s, %d, %s_gz, %d, 0x%08x", pConstantName, nStrippedSize, pConstantName, nGzipSize, nETag);
+	assert(i < static_cast<int>(sizeof(buffer)));
+	fwrite(buffer, sizeof(char), i, pFileContent);
+
+	delete [] pStripped;
 	delete [] pFileNameOut;
 	delete [] pConstantName;
 
 	fclose(pFileIn);
 	fclose(pFileOut);
 
-	printf("File size: %d\n", nFileSize);
+	printf("File size: %d, gzip: %d, ETag: %08x\n", nStrippedSize, nGzipSize, nETag);
 
-	return nFileSize;
+	return nStrippedSize;
 }
 
 int main() {
@@ -299,10 +368,10 @@ int main() {
 				fwrite(pFileName, sizeof(char), i, pFileContent);
 				delete[] pFileName;
 
-				auto nContentLength = convert_to_h(pDirEntry->d_name);
+				convert_to_h(pDirEntry->d_name);
 
 				char buffer[64];
-				i = snprintf(buffer, sizeof(buffer) - 1, ", %d, static_cast<http::contentTypes>(%d)", nContentLength, static_cast<int>(contentType));
+				i = snprintf(buffer, sizeof(buffer) - 1, ", static_cast<http::contentTypes>(%d)", static_cast<int>(contentType));
 				assert(i < static_cast<int>(sizeof(buffer)));
 				fwrite(buffer, sizeof(char), i, pFileContent);
 
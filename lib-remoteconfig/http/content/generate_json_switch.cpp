@@ -48,7 +48,10 @@ static constexpr char JSON_ENDPOINTS[][MAX_LENGTH] = {
 		"timedate",
 		"rtcalarm",
 		"polltable",
-		"types"
+		"types",
+		"sequence",
+		"jitter",
+		"spibus"
 };
 
 inline uint16_t get_uint(const char *pString) {					/* djb2 */
@@ -22,6 +22,9 @@ static constexpr uint16_t TIMEDATE    = 0x2472;
 static constexpr uint16_t RTCALARM    = 0x817b;
 static constexpr uint16_t POLLTABLE   = 0x0864;
 static constexpr uint16_t TYPES       = 0x5e5a;
+static constexpr uint16_t SEQUENCE    = 0x489e;
+static constexpr uint16_t JITTER      = 0x7b37;
+static constexpr uint16_t SPIBUS      = 0x41bb;
 }
 }
 }
@@ -72,3 +72,44 @@ static constexpr char rdm_html[] = {
 0x63, 0x72, 0x69, 0x70, 0x74, 0x3E, 0x0A, 0x3C, 0x2F, 0x62, 0x6F, 0x64, 0x79, 0x3E, 0x0A, 0x3C,
 0x2F, 0x68, 0x74, 0x6D, 0x6C, 0x3E, 0x00
 };
+
+static constexpr uint8_t rdm_html_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x61, 0x6B, 0xDB, 0x30,
+0x10, 0xFD, 0xEE, 0x5F, 0x71, 0x13, 0x0C, 0x3B, 0xD0, 0xDA, 0xED, 0x60, 0x30, 0x12, 0xDB, 0x83,
+0xB5, 0xFD, 0xB0, 0xD1, 0xB5, 0x5D, 0x57, 0x3A, 0xF6, 0x51, 0x91, 0xCF, 0x89, 0x5A, 0x59, 0xF2,
+0x24, 0xD9, 0x6D, 0x56, 0xFA, 0xDF, 0x77, 0xB1, 0x95, 0xA4, 0x59, 0x61, 0x30, 0xB0, 0xD1, 0xF9,
+0xF4, 0xDE, 0xBB, 0xA7, 0x93, 0xE4, 0xFC, 0xCD, 0xE9, 0xE5, 0xC9, 0xCD, 0xCF, 0xAB, 0x33, 0x58,
+0xFA, 0x46, 0x95, 0x51, 0xBE, 0x19, 0x90, 0x57, 0x65, 0xAE, 0xA4, 0xBE, 0x07, 0x8B, 0xAA, 0x60,
+0xCE, 0xAF, 0x14, 0xBA, 0x25, 0xA2, 0x67, 0xB0, 0xB4, 0x58, 0x6F, 0x32, 0xA9, 0x70, 0x8E, 0x41,
+0x56, 0xE6, 0x5E, 0x7A, 0x85, 0xE5, 0xF5, 0xE9, 0xD7, 0x3C, 0x1B, 0xC3, 0x3C, 0x1B, 0x34, 0xA2,
+0x7C, 0x6E, 0xAA, 0x55, 0x50, 0x44, 0x5B, 0xE6, 0x9D, 0x02, 0x59, 0x15, 0x4C, 0x56, 0xE7, 0xD2,
+0x79, 0x46, 0xB0, 0x4E, 0x05, 0x2C, 0xCD, 0x46, 0x79, 0x5B, 0xE6, 0xF3, 0xCE, 0x7B, 0xA3, 0xC1,
+0x68, 0xA1, 0xA4, 0xB8, 0x2F, 0x18, 0x95, 0xB3, 0x54, 0x3B, 0x99, 0xB0, 0xF2, 0x7A, 0x0C, 0xF3,
+0x6C, 0xC4, 0x6C, 0xB1, 0x83, 0x99, 0x22, 0x6E, 0xB8, 0x5D, 0x48, 0x7D, 0xA8, 0xB0, 0xF6, 0x53,
+0x78, 0xF7, 0xBE, 0x7D, 0x9C, 0xC5, 0x43, 0xB1, 0xB9, 0xD7, 0xAC, 0x3C, 0x37, 0xBC, 0x92, 0x7A,
+0x91, 0xA6, 0xE9, 0x8E, 0x9E, 0xB5, 0x54, 0xB2, 0x92, 0x3D, 0x08, 0xC5, 0x9D, 0x2B, 0x98, 0xA8,
+0x17, 0x64, 0xC9, 0xF3, 0xB9, 0xC2, 0xE0, 0xF2, 0x84, 0x32, 0x30, 0x37, 0x96, 0xDC, 0x15, 0xF1,
+0x71, 0x4C, 0x94, 0x61, 0x96, 0x46, 0xA2, 0xED, 0x93, 0x7F, 0x75, 0xC8, 0xCA, 0x1F, 0xC6, 0xDE,
+0x53, 0x15, 0xF8, 0xD6, 0x61, 0x87, 0xF9, 0xDC, 0x52, 0x6F, 0xA2, 0x20, 0x18, 0x4C, 0xD6, 0x46,
+0xFB, 0xC3, 0x9A, 0x37, 0x52, 0xAD, 0xA6, 0xEC, 0xC4, 0x74, 0x56, 0xA2, 0x85, 0x0B, 0x7C, 0x60,
+0x07, 0x10, 0xBE, 0x0E, 0xA0, 0x31, 0xDA, 0xB8, 0x96, 0x0B, 0x9C, 0xC1, 0x00, 0x77, 0xF2, 0x37,
+0x4E, 0x3F, 0x1C, 0xBD, 0x8D, 0x83, 0x2B, 0x52, 0xDF, 0xB9, 0x3A, 0xDA, 0xB9, 0x8A, 0x5E, 0xD8,
+0x2A, 0x4F, 0xA5, 0x13, 0xA6, 0x47, 0x8B, 0x15, 0x54, 0xD8, 0x4B, 0x81, 0x6E, 0xF4, 0xB3, 0xB7,
+0x3E, 0x02, 0xFD, 0x73, 0x7D, 0xB5, 0x31, 0x7E, 0x6F, 0xDB, 0x6E, 0xD1, 0x3A, 0x69, 0xF4, 0x76,
+0xE7, 0x02, 0x20, 0xCA, 0x9D, 0xB0, 0xB2, 0xF5, 0xE0, 0xAC, 0x58, 0x1F, 0x0E, 0xEE, 0xA5, 0x48,
+0xEF, 0x48, 0xDB, 0xAF, 0x5A, 0x2C, 0x98, 0xC7, 0x47, 0x9F, 0xDD, 0xF1, 0x9E, 0x8F, 0xA8, 0x35,
+0x7B, 0x8C, 0xFE, 0x22, 0xDA, 0xAA, 0xF9, 0x2F, 0x56, 0x19, 0x71, 0xB7, 0xD2, 0x02, 0xEA, 0x4E,
+0x0B, 0x4F, 0xB6, 0xA0, 0x6B, 0x2B, 0xEE, 0x31, 0x99, 0xC0, 0x53, 0x24, 0x8C, 0x76, 0x1E, 0x2C,
+0x14, 0xC0, 0x1F, 0xB8, 0xF4, 0xB0, 0x40, 0xFF, 0xE5, 0xFB, 0xE5, 0x45, 0x12, 0x53, 0x91, 0x78,
+0x32, 0x0B, 0xF3, 0x3D, 0x57, 0x1D, 0x12, 0xC6, 0xA6, 0x94, 0xDE, 0x24, 0xE9, 0xC0, 0x50, 0xAA,
+0x32, 0xA2, 0x6B, 0x50, 0xFB, 0x94, 0x98, 0x67, 0x0A, 0xD7, 0xE1, 0xA7, 0xD5, 0xE7, 0x2A, 0x89,
+0x69, 0x7A, 0x2D, 0x40, 0x43, 0x2A, 0xB5, 0x46, 0x7B, 0x43, 0x3E, 0x09, 0x1F, 0xA4, 0x8A, 0x02,
+0x68, 0x4F, 0xE0, 0x23, 0xC4, 0x67, 0x7A, 0xDD, 0xCB, 0x18, 0xA6, 0x10, 0x53, 0x9F, 0x87, 0x78,
+0x64, 0x85, 0xB3, 0xBD, 0xB6, 0xB6, 0x6F, 0xFF, 0x85, 0x71, 0x8D, 0x0F, 0xB7, 0xC1, 0xDB, 0x2B,
+0xE1, 0xE3, 0x41, 0xF3, 0x88, 0xD4, 0xC6, 0xA5, 0x11, 0x16, 0xAE, 0xAC, 0x69, 0xA4, 0xC3, 0x84,
+0x2E, 0x88, 0x51, 0x3D, 0xC1, 0x4B, 0x92, 0x6A, 0x8D, 0xF3, 0xC9, 0x13, 0xD0, 0xD2, 0xA6, 0x3B,
+0xC1, 0xE7, 0x49, 0xEA, 0x97, 0xA8, 0x13, 0x2A, 0x36, 0x80, 0x02, 0x23, 0xA1, 0x25, 0x3D, 0x87,
+0x77, 0xD3, 0x46, 0xFA, 0xA2, 0x27, 0x7A, 0xDD, 0x77, 0x45, 0xB7, 0x97, 0xA6, 0xFB, 0xF1, 0x34,
+0x50, 0xB4, 0xBD, 0xA5, 0xB3, 0x2D, 0xF7, 0x05, 0x2B, 0x0B, 0x7F, 0x81, 0x6C, 0xF8, 0xBF, 0xFC,
+0x01, 0xB8, 0x79, 0x87, 0x89, 0x76, 0x04, 0x00, 0x00, 
+};
@@ -62,3 +62,37 @@ static constexpr char rdm_js[] = {
 0x3D, 0x68, 0x64, 0x72, 0x73, 0x20, 0x2B, 0x20, 0x74, 0x64, 0x64, 0x0A, 0x7D, 0x20, 0x63, 0x61,
 0x74, 0x63, 0x68, 0x20, 0x28, 0x65, 0x72, 0x72, 0x6F, 0x72, 0x29, 0x7B, 0x7D, 0x0A, 0x7D, 0x00
 };
+
+static constexpr uint8_t rdm_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8D, 0x93, 0xDD, 0x6E, 0xDB, 0x30,
+0x0C, 0x85, 0xEF, 0xFD, 0x14, 0x44, 0x50, 0xC0, 0x12, 0xD2, 0x39, 0x17, 0xBB, 0x6B, 0x62, 0x0F,
+0xD8, 0x5A, 0x60, 0x1D, 0xF6, 0xD3, 0xA1, 0x7B, 0x80, 0x28, 0x96, 0x52, 0x09, 0xB0, 0xE5, 0x84,
+0x92, 0xB1, 0x05, 0x86, 0xDF, 0x7D, 0x94, 0xE4, 0xB8, 0xEB, 0xB2, 0x0D, 0xBB, 0x31, 0x24, 0x8A,
+0x47, 0xA4, 0xBE, 0x43, 0x0B, 0x77, 0xB2, 0x35, 0xEC, 0x7B, 0x5B, 0x7B, 0xD3, 0x59, 0x40, 0xB5,
+0x47, 0xE5, 0x34, 0xE3, 0x30, 0x64, 0x1E, 0x4F, 0xF4, 0x6D, 0x94, 0x07, 0x29, 0xBC, 0x28, 0xC5,
+0x77, 0x61, 0x3C, 0x3C, 0x29, 0xFF, 0xE1, 0xF1, 0xCB, 0x67, 0x96, 0xA3, 0x6C, 0x57, 0x87, 0x0E,
+0xBD, 0xF3, 0xC2, 0xF7, 0x2E, 0xE7, 0x31, 0x51, 0x97, 0xF9, 0xC6, 0x63, 0xB5, 0xF1, 0xBA, 0x7A,
+0xA0, 0xB3, 0xCD, 0x8A, 0x16, 0x61, 0x73, 0x6B, 0x50, 0xC5, 0x02, 0x73, 0xE4, 0x31, 0xCA, 0xD2,
+0x76, 0x45, 0x92, 0x3C, 0x0B, 0x45, 0x8A, 0x7D, 0x87, 0x77, 0xA2, 0xD6, 0xCC, 0x78, 0xD5, 0x42,
+0x59, 0x51, 0x7D, 0xBD, 0x2C, 0xB7, 0xE9, 0x4E, 0x59, 0x5D, 0x0D, 0x21, 0x5E, 0x84, 0xB2, 0x23,
+0xA9, 0xE4, 0xAF, 0x41, 0x79, 0x2E, 0x71, 0x71, 0x92, 0x3A, 0x9C, 0xC2, 0xA1, 0xD6, 0x36, 0x1B,
+0xF9, 0x3A, 0x93, 0x5D, 0xDD, 0xB7, 0xCA, 0xFA, 0x82, 0x9E, 0x74, 0xD7, 0xA8, 0xB0, 0x7C, 0x7B,
+0xBA, 0x97, 0x6C, 0x61, 0xE4, 0xBB, 0xFD, 0xD3, 0x82, 0x17, 0xC6, 0x5A, 0x85, 0xEF, 0xBF, 0x7D,
+0xFA, 0x58, 0xEA, 0xF8, 0x38, 0x8F, 0x13, 0x83, 0x07, 0xEC, 0x5A, 0xE3, 0x54, 0x21, 0x9A, 0x86,
+0xA5, 0xB6, 0x5B, 0x71, 0x98, 0x5B, 0x7E, 0x41, 0xC8, 0x77, 0xF2, 0x4D, 0x0E, 0x4B, 0x98, 0xFB,
+0xE6, 0x85, 0xD7, 0xCA, 0x32, 0x82, 0x7C, 0xE8, 0xAC, 0x53, 0x41, 0xC0, 0x06, 0x08, 0x27, 0x37,
+0xCF, 0x49, 0xD7, 0x40, 0xBA, 0x1B, 0x38, 0x27, 0x15, 0xB4, 0x83, 0x91, 0x73, 0x9E, 0x51, 0xDB,
+0xCF, 0xAE, 0x1C, 0xFF, 0x64, 0xC9, 0xB1, 0x57, 0xBD, 0x22, 0x37, 0xC8, 0x89, 0x7C, 0x9D, 0x1D,
+0x8B, 0xDE, 0xC8, 0x19, 0x2A, 0xAD, 0x2F, 0x98, 0x42, 0xDD, 0x35, 0xEE, 0x20, 0x6C, 0xB9, 0x78,
+0xBD, 0x20, 0x60, 0x94, 0x72, 0x01, 0x6A, 0x84, 0x5A, 0xF8, 0x5A, 0x03, 0x53, 0x88, 0x1D, 0xF2,
+0x21, 0x5C, 0x3D, 0xFE, 0x0B, 0xDF, 0xD7, 0x5E, 0xFD, 0x86, 0xCF, 0x63, 0xE1, 0xE8, 0x5D, 0x8C,
+0x89, 0x6B, 0xD8, 0xF1, 0xD4, 0x04, 0x2A, 0xDF, 0xA3, 0x85, 0x64, 0xBB, 0xB1, 0xF2, 0xDE, 0x4A,
+0xF5, 0x63, 0xA6, 0x38, 0xB3, 0x80, 0xB2, 0x2C, 0x41, 0x24, 0x76, 0xF0, 0xEA, 0xFF, 0xD2, 0x77,
+0x29, 0x7D, 0x1D, 0xDB, 0x8F, 0x73, 0x29, 0xD1, 0xA5, 0xD1, 0xCC, 0x93, 0x95, 0x52, 0x9E, 0xB7,
+0xD4, 0xDA, 0x99, 0x0F, 0x4E, 0x74, 0x28, 0x39, 0x02, 0xD2, 0x04, 0x04, 0xE7, 0x69, 0xD3, 0xD5,
+0x96, 0xE8, 0x4B, 0xB9, 0x0C, 0x4A, 0x59, 0x11, 0x5D, 0x0C, 0xC6, 0xCC, 0xEA, 0x60, 0x52, 0xD4,
+0xC7, 0x9C, 0xED, 0xD5, 0x40, 0x81, 0x71, 0xB3, 0xC3, 0xD5, 0x84, 0x71, 0x92, 0x06, 0xB8, 0x79,
+0x0C, 0xA4, 0x3A, 0xF9, 0x34, 0xFE, 0xF3, 0x71, 0xFC, 0x17, 0xFE, 0x0E, 0xF7, 0xD6, 0xB8, 0x97,
+0x70, 0xE9, 0x16, 0x1A, 0x30, 0x92, 0x5F, 0x18, 0x35, 0x66, 0xE3, 0x4F, 0x62, 0x61, 0x45, 0xD2,
+0xDF, 0x03, 0x00, 0x00, 
+};
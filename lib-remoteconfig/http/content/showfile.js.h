@@ -90,3 +90,43 @@ static constexpr char showfile_js[] = {
 0x63, 0x61, 0x74, 0x63, 0x68, 0x20, 0x28, 0x65, 0x72, 0x72, 0x6F, 0x72, 0x29, 0x7B, 0x7D, 0x0A,
 0x7D, 0x00
 };
+
+static constexpr uint8_t showfile_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8D, 0x54, 0xDF, 0x4F, 0xDB, 0x30,
+0x10, 0x7E, 0xF7, 0x5F, 0x71, 0xB3, 0x10, 0x71, 0x94, 0x29, 0x85, 0xB1, 0x17, 0x68, 0x9C, 0x49,
+0x93, 0x90, 0xC6, 0x04, 0xE5, 0x81, 0xBD, 0x4C, 0x08, 0xA9, 0x69, 0x7C, 0x21, 0xD9, 0x52, 0xBB,
+0xB2, 0xDD, 0xA2, 0xD2, 0xE5, 0x7F, 0x9F, 0xE3, 0x94, 0xFE, 0x80, 0xAA, 0xED, 0x4B, 0xE2, 0xB3,
+0xBF, 0xBB, 0xEF, 0xBE, 0xF3, 0x9D, 0x33, 0x33, 0x97, 0x39, 0x14, 0x53, 0x99, 0xDB, 0x4A, 0x49,
+0xD0, 0x58, 0x68, 0x34, 0x25, 0x0B, 0x61, 0x41, 0xAC, 0x9E, 0xBB, 0xAF, 0xA8, 0x34, 0xE6, 0x56,
+0xE9, 0x39, 0x0B, 0x49, 0x8D, 0x16, 0x04, 0xCF, 0x5E, 0xB2, 0xCA, 0xC2, 0x33, 0xDA, 0x9F, 0x0F,
+0xF7, 0x03, 0x16, 0x98, 0x52, 0xBD, 0x14, 0x55, 0x8D, 0x3D, 0x63, 0x33, 0x3B, 0x35, 0x41, 0x07,
+0x33, 0x9C, 0x4D, 0x32, 0x6D, 0xF0, 0x46, 0x5A, 0x26, 0xE2, 0x16, 0x13, 0x42, 0xCA, 0xE1, 0x0C,
+0x4E, 0x4F, 0xE1, 0xC3, 0x41, 0xC2, 0xE1, 0xF2, 0x32, 0x84, 0x6F, 0xD0, 0x6D, 0xC0, 0x15, 0x04,
+0x03, 0x25, 0x31, 0xF0, 0x91, 0x6A, 0xA5, 0x26, 0x5C, 0xC4, 0xED, 0x0F, 0x38, 0xE7, 0x40, 0xCF,
+0xA9, 0x43, 0xD2, 0xDF, 0x68, 0xA8, 0x03, 0xD2, 0x81, 0xA2, 0xA4, 0xE4, 0xC3, 0xC4, 0xEA, 0x34,
+0xB1, 0x22, 0xBD, 0x53, 0x02, 0x93, 0x9E, 0x5B, 0xB4, 0xC6, 0xC9, 0x42, 0xC4, 0x63, 0xB7, 0xD1,
+0xF8, 0x1D, 0x70, 0x5F, 0x9D, 0x0E, 0x49, 0x19, 0xAD, 0xE1, 0x0F, 0x8E, 0x6E, 0x03, 0x6E, 0xF6,
+0x20, 0xBD, 0xBA, 0xAD, 0xD0, 0x9D, 0xE0, 0xCE, 0x65, 0x87, 0xC7, 0xAD, 0xCB, 0xB8, 0x92, 0xCF,
+0x1B, 0x2E, 0xAD, 0x86, 0x2D, 0xB8, 0x50, 0xF9, 0x74, 0x8C, 0xD2, 0xC6, 0xAE, 0x9A, 0xD7, 0x35,
+0xB6, 0xCB, 0xEF, 0xF3, 0x1B, 0xC1, 0x68, 0x25, 0x3A, 0x3E, 0x1A, 0xC6, 0x95, 0x94, 0xA8, 0x7F,
+0xFC, 0xBA, 0xBB, 0xE5, 0x41, 0x62, 0xB3, 0x51, 0x8D, 0x69, 0x10, 0x95, 0x51, 0xE0, 0x22, 0x74,
+0x86, 0x2F, 0xD2, 0x68, 0x47, 0x85, 0x06, 0xCA, 0xD7, 0xCE, 0x57, 0x69, 0x99, 0x0B, 0xDD, 0xC7,
+0xF8, 0x75, 0x8B, 0x6C, 0x44, 0x1A, 0xC8, 0x33, 0x9B, 0x97, 0xC0, 0x50, 0x6B, 0xA5, 0xC3, 0x45,
+0x43, 0x1A, 0x92, 0x6D, 0xB7, 0x8B, 0xC1, 0xDA, 0xB7, 0x4A, 0xAE, 0xA4, 0xB1, 0x30, 0xE3, 0x7B,
+0xA2, 0x9F, 0xBB, 0xE8, 0xB3, 0xAC, 0x9E, 0x22, 0xE9, 0xFA, 0x67, 0xA2, 0x8C, 0x65, 0x0B, 0x68,
+0xEF, 0xFB, 0x6A, 0x78, 0xB2, 0x98, 0x35, 0x43, 0x68, 0x42, 0xB2, 0xEA, 0xBF, 0x8F, 0x5C, 0xAE,
+0x0D, 0x8F, 0xE5, 0xBA, 0xD8, 0x54, 0xB2, 0x83, 0x8F, 0xD2, 0xCF, 0x2E, 0x9A, 0xD2, 0x02, 0xF5,
+0x71, 0xDC, 0xE2, 0x78, 0x9D, 0x5F, 0xDE, 0xE9, 0x74, 0xAE, 0x78, 0x40, 0xE8, 0x8A, 0xA6, 0x28,
+0x98, 0x58, 0xD3, 0x18, 0xE0, 0xCB, 0x81, 0x30, 0xF1, 0x38, 0x9B, 0x30, 0x3F, 0x1A, 0x3C, 0xF5,
+0x91, 0xBA, 0xC1, 0xF1, 0x57, 0x8F, 0x0E, 0x76, 0xD6, 0x27, 0x85, 0xD2, 0xC0, 0x5A, 0x5B, 0x82,
+0x2A, 0xC0, 0xB4, 0x61, 0xAA, 0x02, 0x98, 0x84, 0x4F, 0xAE, 0x23, 0xD0, 0x99, 0xAE, 0x80, 0x76,
+0xAA, 0x25, 0x60, 0xBF, 0x21, 0x18, 0x45, 0x7D, 0x47, 0xFC, 0xB6, 0xB3, 0x43, 0xF0, 0x7A, 0xEA,
+0x57, 0x2F, 0xC1, 0xFE, 0xE9, 0x5F, 0x79, 0x2C, 0x1F, 0x80, 0x92, 0x53, 0xEA, 0x17, 0x05, 0xBF,
+0x1F, 0xFD, 0x71, 0x47, 0xF1, 0x5F, 0x9C, 0x1B, 0x26, 0x1E, 0xA9, 0x57, 0x44, 0x9F, 0x42, 0x52,
+0xC4, 0x2E, 0xE9, 0xEB, 0x2C, 0x2F, 0xD9, 0x1B, 0x2F, 0x73, 0x98, 0x96, 0x70, 0x96, 0x69, 0x98,
+0xB5, 0xF2, 0x57, 0xE8, 0x47, 0x77, 0xF2, 0x44, 0x4A, 0x88, 0x5C, 0x7B, 0x27, 0x6A, 0xE2, 0x93,
+0xF4, 0x65, 0xE6, 0x34, 0x9A, 0xF9, 0x6A, 0x44, 0x34, 0x5D, 0x2F, 0xE1, 0x1F, 0x78, 0xA3, 0x7A,
+0xC5, 0x88, 0x26, 0xBD, 0xCE, 0x21, 0xA5, 0xA4, 0x09, 0xFB, 0xE4, 0x40, 0x93, 0xAE, 0x1A, 0xC7,
+0xF1, 0x97, 0xE4, 0xC0, 0x4D, 0x1F, 0x0D, 0xBE, 0x78, 0x07, 0xF6, 0x57, 0xBD, 0x6B, 0xC4, 0xFE,
+0x03, 0xCF, 0x5C, 0xFD, 0x1D, 0x91, 0x05, 0x00, 0x00, 
+};
@@ -38,3 +38,26 @@ static constexpr char time_html[] = {
 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3E, 0x0A, 0x3C, 0x2F, 0x62, 0x6F, 0x64, 0x79, 0x3E, 0x0A,
 0x3C, 0x2F, 0x68, 0x74, 0x6D, 0x6C, 0x3E, 0x00
 };
+
+static constexpr uint8_t time_html_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9D, 0x52, 0x31, 0x52, 0xC3, 0x30,
+0x10, 0xEC, 0xFD, 0x8A, 0x43, 0x55, 0xD2, 0x44, 0x0F, 0x40, 0x56, 0x03, 0x74, 0x99, 0xC0, 0x40,
+0x06, 0x86, 0x52, 0x96, 0x2E, 0x63, 0x25, 0x8A, 0xE5, 0x91, 0xCE, 0x01, 0xFF, 0x1E, 0xC9, 0x72,
+0x32, 0x04, 0x2A, 0xA8, 0xBC, 0x73, 0xDA, 0xDD, 0xDB, 0xBB, 0xB3, 0xB8, 0xB9, 0x7F, 0xBC, 0xDB,
+0xBE, 0x3F, 0x3D, 0x40, 0x4B, 0x47, 0x27, 0x2B, 0x71, 0xFE, 0xA0, 0x32, 0x52, 0x38, 0xDB, 0x1D,
+0x20, 0xA0, 0xAB, 0x59, 0xA4, 0xD1, 0x61, 0x6C, 0x11, 0x89, 0x41, 0x1B, 0x70, 0x77, 0xAE, 0xAC,
+0x74, 0x8C, 0x0C, 0xB8, 0x14, 0x64, 0xC9, 0xA1, 0xDC, 0x78, 0x83, 0xB0, 0xB5, 0x47, 0x14, 0xBC,
+0x14, 0x04, 0x9F, 0x9C, 0x2A, 0xD1, 0x78, 0x33, 0xCE, 0xBE, 0x18, 0xA4, 0x18, 0x1C, 0x58, 0x53,
+0x33, 0x6B, 0xD6, 0x36, 0x12, 0x4B, 0xB4, 0xC1, 0xCD, 0xDC, 0xF4, 0x5A, 0x89, 0x5E, 0x8A, 0x66,
+0x20, 0xF2, 0x1D, 0xF8, 0x4E, 0x3B, 0xAB, 0x0F, 0x35, 0x4B, 0x4D, 0x43, 0x4A, 0xB0, 0x58, 0x32,
+0xF9, 0x5C, 0xA0, 0xE0, 0x85, 0x93, 0x84, 0x7D, 0xD6, 0x4C, 0x8E, 0x5D, 0x4A, 0x90, 0x03, 0xB0,
+0x92, 0x85, 0x12, 0x84, 0x0F, 0xEB, 0x1C, 0x34, 0x08, 0xC6, 0xC6, 0xDE, 0xA9, 0x11, 0x0D, 0xB4,
+0x18, 0x70, 0x56, 0xFD, 0xEE, 0x14, 0xC7, 0x4E, 0xBF, 0x59, 0x6A, 0xD7, 0x5E, 0x2B, 0x97, 0xBD,
+0x72, 0xCF, 0x97, 0x54, 0x4C, 0x46, 0xD4, 0xC2, 0x54, 0x9E, 0x87, 0xBC, 0x0A, 0xB0, 0xF3, 0x9E,
+0xAE, 0x66, 0x7B, 0xC5, 0x10, 0xAD, 0xEF, 0x2E, 0xE3, 0xCD, 0x84, 0x4A, 0x44, 0x1D, 0x6C, 0x4F,
+0x10, 0x83, 0xCE, 0x7B, 0x54, 0x64, 0xF5, 0x6A, 0x9F, 0xD6, 0x48, 0x63, 0x8F, 0x35, 0x23, 0xFC,
+0x24, 0xBE, 0x57, 0x27, 0x55, 0x58, 0x59, 0x5D, 0xD0, 0x0F, 0xA1, 0x51, 0x84, 0xFF, 0x90, 0xE5,
+0x8D, 0xFC, 0x49, 0x26, 0x5D, 0x3A, 0xD1, 0x62, 0x79, 0x7B, 0x2A, 0xD3, 0x24, 0x74, 0x39, 0xC5,
+0x37, 0x2E, 0x9F, 0x0F, 0xCC, 0xA7, 0x1F, 0xE8, 0x0B, 0x70, 0xDD, 0x1A, 0x0D, 0x57, 0x02, 0x00,
+0x00, 
+};
@@ -25,3 +25,20 @@ static constexpr char time_js[] = {
 0x70, 0x6F, 0x73, 0x74, 0x28, 0x64, 0x61, 0x74, 0x61, 0x29, 0x0A, 0x72, 0x65, 0x66, 0x72, 0x65,
 0x73, 0x68, 0x28, 0x29, 0x0A, 0x7D, 0x00
 };
+
+static constexpr uint8_t time_js_gz[] = {
+0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xAD, 0x50, 0xBB, 0x0A, 0xC2, 0x40,
+0x10, 0xEC, 0xEF, 0x2B, 0xB6, 0x10, 0x72, 0xD7, 0xE4, 0x03, 0x04, 0x1B, 0x1F, 0x85, 0x22, 0xB1,
+0x50, 0xB0, 0xCD, 0x71, 0xD9, 0x98, 0x40, 0x72, 0x27, 0xC9, 0x86, 0x18, 0x42, 0xFE, 0xDD, 0xDD,
+0x28, 0x82, 0x9D, 0x85, 0xDD, 0x2E, 0x33, 0x3B, 0x33, 0x3B, 0xB6, 0x1D, 0xBC, 0x83, 0xBC, 0xF3,
+0x8E, 0xCA, 0xE0, 0xA1, 0xC1, 0xBC, 0xC1, 0xB6, 0xD0, 0x06, 0x46, 0x55, 0x21, 0x41, 0x66, 0xC9,
+0xC2, 0x0A, 0x6C, 0x6F, 0x4B, 0x82, 0x1B, 0xD2, 0xE1, 0x7C, 0x4A, 0x74, 0x44, 0x65, 0x8D, 0x8C,
+0x60, 0x64, 0x94, 0x0B, 0xBE, 0x25, 0xF0, 0x21, 0x43, 0xA6, 0xE5, 0xA1, 0xA9, 0x2D, 0x6D, 0x19,
+0xB9, 0x30, 0x43, 0x7B, 0xEC, 0x41, 0x16, 0x2D, 0x2A, 0xB1, 0x1C, 0x18, 0xA3, 0xB2, 0xE0, 0xBA,
+0x1A, 0x3D, 0xC5, 0xAC, 0xB6, 0xAB, 0x50, 0xC6, 0xF5, 0xB0, 0xCF, 0x74, 0x24, 0x1A, 0x72, 0x16,
+0x99, 0x98, 0xF0, 0x41, 0x9B, 0xE0, 0x89, 0x31, 0x56, 0x4D, 0x13, 0x51, 0x17, 0x68, 0x09, 0x8B,
+0x51, 0x68, 0x53, 0xAA, 0x26, 0x65, 0xBF, 0x93, 0xCB, 0x76, 0x2D, 0xA9, 0x38, 0x06, 0x67, 0xAB,
+0xD9, 0x5E, 0x7E, 0xF8, 0x29, 0xDE, 0xFF, 0x52, 0xBD, 0xEC, 0xDE, 0xA5, 0x8D, 0x32, 0x30, 0x3A,
+0xBB, 0x73, 0xDE, 0xB9, 0xC3, 0x7B, 0x68, 0x69, 0xEE, 0xC3, 0xA8, 0x4F, 0xD7, 0x6A, 0x7A, 0x02,
+0x72, 0x97, 0x64, 0x6F, 0x86, 0x01, 0x00, 0x00, 
+};
@@ -26,10 +26,13 @@
 #ifndef HTTPD_HTTP_H_
 #define HTTPD_HTTP_H_
 
+#include <cstdint>
+
 namespace http {
 static constexpr uint32_t BUFSIZE = 1440; //TODO We need the TCP max segment size here
 enum class Status {
 	OK = 200,
+	NOT_MODIFIED = 304,
 	BAD_REQUEST = 400,
 	NOT_FOUND = 404,
 	REQUEST_TIMEOUT = 408,
@@ -47,6 +50,21 @@ enum class RequestMethod {
 enum class contentTypes {
 	TEXT_HTML, TEXT_CSS, TEXT_JS, APPLICATION_JSON, APPLICATION_OCTET_STREAM, NOT_DEFINED
 };
+
+/**
+ * FNV-1a of the (uncompressed) content, used as entity tag.
+ * Also used by generate_content, so it must stay C++11.
+ */
+inline uint32_t etag(const char *pContent, const uint32_t nLength) {
+	uint32_t nHash = 2166136261U;
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		nHash ^= static_cast<uint8_t>(pContent[i]);
+		nHash *= 16777619U;
+	}
+
+	return nHash;
+}
 }  // namespace http
 
 #endif /* HTTPD_HTTP_H_ */
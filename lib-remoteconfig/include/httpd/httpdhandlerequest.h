@@ -47,6 +47,7 @@ private:
 	http::Status ParseMethod(char *pLine);
 	http::Status ParseHeaderField(char *pLine);
 	http::Status HandleGet();
+	uint32_t GetJsonCached(const uint32_t nId, const uint64_t nGeneration, uint32_t (*pGetJson)(char *, const uint32_t));
 	http::Status HandleGetTxt();
 	http::Status HandlePost(const bool hasDataOnly);
 	http::Status HandleDelete(const bool hasDataOnly);
@@ -58,6 +59,8 @@ private:
 	uint32_t m_nFileDataLength { 0 };
 	uint32_t m_nRequestContentSize { 0 };
 	uint32_t m_nBytesReceived { 0 };
+	uint32_t m_nETag { 0 };
+	uint32_t m_nIfNoneMatch { 0 };
 
 	char *m_pUri { nullptr };
 	char *m_pFileData { nullptr };
@@ -69,6 +72,9 @@ private:
 	http::contentTypes m_ContentType { http::contentTypes::NOT_DEFINED };
 
 	bool m_IsAction { false };
+	bool m_bAcceptGzip { false };
+	bool m_bIsGzip { false };
+	bool m_bHasIfNoneMatch { false };
 
 	static char m_DynamicContent[http::BUFSIZE];
 };
@@ -1,8 +1,8 @@
 /**
- * @file artnetparamsconst.cpp
+ * @file jsoncache.h
  *
  */
-/* Copyright (C) 2019-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -23,37 +23,32 @@
  * THE SOFTWARE.
  */
 
-#include "artnetparamsconst.h"
-#include "artnet.h"
+#ifndef HTTPD_JSONCACHE_H_
+#define HTTPD_JSONCACHE_H_
 
-const char ArtNetParamsConst::FILE_NAME[] = "artnet.txt";
-
-const char ArtNetParamsConst::ENABLE_RDM[] = "enable_rdm";
-
-const char ArtNetParamsConst::DESTINATION_IP_PORT[artnet::PORTS][24] = {
-		"destination_ip_port_a",
-		"destination_ip_port_b",
-		"destination_ip_port_c",
-		"destination_ip_port_d"
-};
+#include <cstdint>
 
+/**
+ * Cache for JSON responses that only change with a state change.
+ * An entry is valid as long as the generation it was built for equals the current generation.
+ * Responses with live counters (uptime, port status, stepper status) are not cached.
+ */
 
-const char ArtNetParamsConst::RDM_ENABLE_PORT[artnet::PORTS][18] = {
-		"rdm_enable_port_a",
-		"rdm_enable_port_b",
-		"rdm_enable_port_c",
-		"rdm_enable_port_d"
-};
+namespace http {
+namespace json {
+namespace cache {
+#if !defined (CONFIG_HTTP_JSON_CACHE_ENTRIES)
+# define CONFIG_HTTP_JSON_CACHE_ENTRIES 4
+#endif
+static constexpr uint32_t ENTRIES = CONFIG_HTTP_JSON_CACHE_ENTRIES;
 
 /**
- * Art-Net 4
+ * @return the cached response or nullptr
  */
+const char *find(const uint32_t nId, const uint64_t nGeneration, uint32_t& nLength);
+void store(const uint32_t nId, const uint64_t nGeneration, const char *pContent, const uint32_t nLength);
+}  // namespace cache
+}  // namespace json
+}  // namespace http
 
-const char ArtNetParamsConst::PROTOCOL_PORT[artnet::PORTS][16] = {
-		"protocol_port_a",
-		"protocol_port_b",
-		"protocol_port_c",
-		"protocol_port_d"
-};
-
-const char ArtNetParamsConst::MAP_UNIVERSE0[] = "map_universe0";
+#endif /* HTTPD_JSONCACHE_H_ */
@@ -34,6 +34,7 @@ uint32_t json_get_version(char *pOutBuffer, const uint32_t nOutBufferSize);
 uint32_t json_get_uptime(char *pOutBuffer, const uint32_t nOutBufferSize);
 uint32_t json_get_display(char *pOutBuffer, const uint32_t nOutBufferSize);
 uint32_t json_get_directory(char *pOutBuffer, const uint32_t nOutBufferSize);
+uint32_t json_get_spibus(char *pOutBuffer, const uint32_t nOutBufferSize);
 namespace net {
 uint32_t json_get_phystatus(char *pOutBuffer, const uint32_t nOutBufferSize);
 }  // namespace net
@@ -57,6 +58,7 @@ uint32_t json_get_vlantable(char *pOutBuffer, const uint32_t nOutBufferSize);
 namespace showfile {
 uint32_t json_get_status(char *pOutBuffer, const uint32_t nOutBufferSize);
 uint32_t json_get_directory(char *pOutBuffer, const uint32_t nOutBufferSize);
+uint32_t json_get_jitter(char *pOutBuffer, const uint32_t nOutBufferSize);
 void json_set_status(const char *pBuffer, const uint32_t nBufferSize);
 void json_delete(const char *pBuffer, const uint32_t nBufferSize);
 }  // namespace showfile
@@ -77,6 +79,12 @@ namespace pixel {
 uint32_t json_get_types(char *pOutBuffer, const uint32_t nOutBufferSize);
 uint32_t json_get_status(char *pOutBuffer, const uint32_t nOutBufferSize);
 }  // namespace pixel
+namespace lightset {
+uint32_t json_get_sequence(char *pOutBuffer, const uint32_t nOutBufferSize);
+}  // namespace lightset
+namespace stepper {
+uint32_t json_get_status(char *pOutBuffer, const uint32_t nOutBufferSize);
+}  // namespace stepper
 }  // namespace remoteconfig
 
 #endif /* REMOTECONFIGJSON_H_ */
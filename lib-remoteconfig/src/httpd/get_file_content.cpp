@@ -2,7 +2,7 @@
  * @file get_file_content.cpp
  *
  */
-/* Copyright (C) 2021-2023 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2021-2024 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -34,6 +34,7 @@
 
 #if defined (CONFIG_HTTP_CONTENT_FS)
 #include <cstdio>
+#include <sys/stat.h>
 
 static constexpr char supported_extensions[static_cast<int>(http::contentTypes::NOT_DEFINED)][8] = {
 		"html",
@@ -59,19 +60,36 @@ static http::contentTypes getContentType(const char *pFileName) {
 	return http::contentTypes::NOT_DEFINED;
 }
 
-uint32_t get_file_content(const char *fileName, char *pDst, http::contentTypes& contentType) {
-	auto *pFile = fopen(fileName, "r");
+/*
+ * The files are whitespace stripped once and kept until their modification time or size changes.
+ */
 
-	if (pFile == nullptr) {
-		DEBUG_EXIT
-		return 0;
-	}
+#if !defined (CONFIG_HTTP_CONTENT_FS_CACHE_ENTRIES)
+# define CONFIG_HTTP_CONTENT_FS_CACHE_ENTRIES 8
+#endif
+
+namespace content {
+static constexpr uint32_t CACHE_ENTRIES = CONFIG_HTTP_CONTENT_FS_CACHE_ENTRIES;
+
+struct Entry {
+	char aFileName[32];
+	time_t mtime;
+	off_t size;
+	uint32_t nLength;
+	uint32_t nETag;
+	http::contentTypes contentType;
+	char content[http::BUFSIZE];
+};
 
-	contentType = getContentType(fileName);
+static Entry s_Cache[CACHE_ENTRIES];
+static uint32_t s_nNext;
+}  // namespace content
 
-	if (contentType == http::contentTypes::NOT_DEFINED) {
+static uint32_t get_file_content(const char *fileName, char *pDst) {
+	auto *pFile = fopen(fileName, "r");
+
+	if (pFile == nullptr) {
 		DEBUG_EXIT
-		fclose(pFile);
 		return 0;
 	}
 
@@ -104,36 +122,79 @@ uint32_t get_file_content(const char *fileName, char *pDst, http::contentTypes&
 	return static_cast<uint32_t>(p - pDst);
 }
 
-static char s_StaticContent[http::BUFSIZE];
-
-const char *get_file_content(const char *pFileName, uint32_t& nSize, http::contentTypes& contentType) {
+const char *get_file_content(const char *pFileName, [[maybe_unused]] const bool bAcceptGzip, uint32_t& nSize, http::contentTypes& contentType, uint32_t& nETag, bool& bIsGzip) {
 	DEBUG_ENTRY
 	DEBUG_PUTS(pFileName);
 
-	nSize = get_file_content(pFileName, s_StaticContent, contentType);
+	nSize = 0;
+	bIsGzip = false;
+	contentType = getContentType(pFileName);
+
+	struct stat sb;
+
+	if ((contentType == http::contentTypes::NOT_DEFINED) || (strlen(pFileName) >= sizeof(content::Entry::aFileName)) || (stat(pFileName, &sb) != 0)) {
+		DEBUG_EXIT
+		return nullptr;
+	}
+
+	for (auto& entry : content::s_Cache) {
+		if ((entry.nLength != 0) && (strcmp(entry.aFileName, pFileName) == 0)) {
+			if ((entry.mtime == sb.st_mtime) && (entry.size == sb.st_size)) {
+				nSize = entry.nLength;
+				nETag = entry.nETag;
+				DEBUG_EXIT
+				return entry.content;
+			}
 
-	if (nSize != 0) {
-		return s_StaticContent;
+			entry.nLength = 0;
+		}
+	}
+
+	auto& entry = content::s_Cache[content::s_nNext];
+	content::s_nNext = (content::s_nNext + 1) % content::CACHE_ENTRIES;
+
+	entry.nLength = get_file_content(pFileName, entry.content);
+
+	if (entry.nLength == 0) {
+		DEBUG_EXIT
+		return nullptr;
 	}
 
+	strcpy(entry.aFileName, pFileName);
+	entry.mtime = sb.st_mtime;
+	entry.size = sb.st_size;
+	entry.nETag = http::etag(entry.content, entry.nLength);
+
+	nSize = entry.nLength;
+	nETag = entry.nETag;
+
 	DEBUG_EXIT
-	return nullptr;
+	return entry.content;
 }
 #else
-const char *get_file_content(const char *pFileName, uint32_t& nSize, http::contentTypes& contentType) {
+const char *get_file_content(const char *pFileName, const bool bAcceptGzip, uint32_t& nSize, http::contentTypes& contentType, uint32_t& nETag, bool& bIsGzip) {
 	DEBUG_ENTRY
 	DEBUG_PUTS(pFileName);
 
 	for (auto& content : HttpContent) {
 		if (strcmp(pFileName, content.pFileName) == 0) {
-			nSize = content.nContentLength;
 			contentType = content.contentType;
+			nETag = content.nETag;
+			bIsGzip = bAcceptGzip;
+
+			if (bIsGzip) {
+				nSize = content.nContentGzipLength;
+				return reinterpret_cast<const char *>(content.pContentGzip);
+			}
+
+			nSize = content.nContentLength;
 			return content.pContent;
 		}
 	}
 
 	nSize = 0;
 	contentType = http::contentTypes::NOT_DEFINED;
+	bIsGzip = false;
 
 	DEBUG_EXIT
 	return nullptr;
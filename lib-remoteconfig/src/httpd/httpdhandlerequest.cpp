@@ -35,6 +35,7 @@
 #include <cassert>
 
 #include "httpd/httpdhandlerequest.h"
+#include "httpd/jsoncache.h"
 
 #include "../http/content/json_switch.h"
 
@@ -43,6 +44,7 @@
 #include "properties.h"
 #include "sscan.h"
 #include "propertiesconfig.h"
+#include "configstore.h"
 
 #include "hardware.h"
 #include "network.h"
@@ -69,8 +71,7 @@
 #include "debug.h"
 
 #if defined ENABLE_CONTENT
-//uint32_t get_file_content(const char *fileName, char *pDst, http::contentTypes& contentType);
-const char *get_file_content(const char *fileName, uint32_t& nSize, http::contentTypes& contentType);
+const char *get_file_content(const char *pFileName, const bool bAcceptGzip, uint32_t& nSize, http::contentTypes& contentType, uint32_t& nETag, bool& bIsGzip);
 #endif
 
 char HttpDeamonHandleRequest::m_DynamicContent[http::BUFSIZE];
@@ -133,7 +134,10 @@ void HttpDeamonHandleRequest::HandleRequest(const uint32_t nBytesReceived, char
 	}
 #endif
 
-	if (m_Status != http::Status::OK) {
+	if (m_Status == http::Status::NOT_MODIFIED) {
+		pStatusMsg = "Not Modified";
+		m_nContentSize = 0;
+	} else if (m_Status != http::Status::OK) {
 		switch (m_Status) {
 		case http::Status::BAD_REQUEST:
 			pStatusMsg = "Bad Request";
@@ -162,6 +166,8 @@ void HttpDeamonHandleRequest::HandleRequest(const uint32_t nBytesReceived, char
 		}
 
 		m_ContentType = http::contentTypes::TEXT_HTML;
+		m_nETag = 0;
+		m_bIsGzip = false;
 		m_pContent = m_DynamicContent;
 		m_nContentSize = static_cast<uint32_t>(snprintf(m_DynamicContent, http::BUFSIZE - 1U,
 				"<!DOCTYPE html>\n"
@@ -171,16 +177,38 @@ void HttpDeamonHandleRequest::HandleRequest(const uint32_t nBytesReceived, char
 				"</html>\n", static_cast<unsigned int>(m_Status), pStatusMsg, pStatusMsg));
 	}
 
-	const auto nHeaderLength = snprintf(m_RequestHeaderResponse, http::BUFSIZE - 1U,
+	auto nHeaderLength = snprintf(m_RequestHeaderResponse, http::BUFSIZE - 1U,
 			"HTTP/1.1 %u %s\r\n"
 			"Server: %s\r\n"
 			"Content-Type: %s\r\n"
-			"Content-Length: %u\r\n"
+			"Content-Length: %u\r\n",
+			static_cast<unsigned int>(m_Status), pStatusMsg, Network::Get()->GetHostName(), s_contentType[static_cast<uint32_t>(m_ContentType)], static_cast<unsigned int>(m_nContentSize));
+
+	if (m_bIsGzip) {
+		nHeaderLength += snprintf(&m_RequestHeaderResponse[nHeaderLength], http::BUFSIZE - 1U - static_cast<uint32_t>(nHeaderLength), "Content-Encoding: gzip\r\n");
+	}
+
+	/*
+	 * The ETag is a hash of the content.
+	 * no-cache makes the browser revalidate, which costs a 304 without a body.
+	 */
+	if (m_nETag != 0) {
+		nHeaderLength += snprintf(&m_RequestHeaderResponse[nHeaderLength], http::BUFSIZE - 1U - static_cast<uint32_t>(nHeaderLength),
+				"ETag: \"%08x%s\"\r\n"
+				"Cache-Control: no-cache\r\n"
+				"Vary: Accept-Encoding\r\n",
+				static_cast<unsigned int>(m_nETag), m_bIsGzip ? "-gz" : "");
+	}
+
+	nHeaderLength += snprintf(&m_RequestHeaderResponse[nHeaderLength], http::BUFSIZE - 1U - static_cast<uint32_t>(nHeaderLength),
 			"Connection: close\r\n"
-			"\r\n", static_cast<unsigned int>(m_Status), pStatusMsg, Network::Get()->GetHostName(), s_contentType[static_cast<uint32_t>(m_ContentType)], static_cast<unsigned int>(m_nContentSize));
+			"\r\n");
+
+	Network::Get()->TcpWrite(m_nHandle, reinterpret_cast<uint8_t *>(m_RequestHeaderResponse), static_cast<uint32_t>(nHeaderLength), m_nConnectionHandle);
 
-	Network::Get()->TcpWrite(m_nHandle, reinterpret_cast<uint8_t *>(m_RequestHeaderResponse), nHeaderLength, m_nConnectionHandle);
-	Network::Get()->TcpWrite(m_nHandle, reinterpret_cast<const uint8_t *>(m_pContent), m_nContentSize, m_nConnectionHandle);
+	if (m_nContentSize != 0) {
+		Network::Get()->TcpWrite(m_nHandle, reinterpret_cast<const uint8_t *>(m_pContent), m_nContentSize, m_nConnectionHandle);
+	}
 	DEBUG_PRINTF("m_nContentLength=%u", m_nContentSize);
 
 	m_Status = http::Status::UNKNOWN_ERROR;
@@ -196,6 +224,10 @@ http::Status HttpDeamonHandleRequest::ParseRequest() {
 	m_ContentType = http::contentTypes::NOT_DEFINED;
 	m_nRequestContentSize = 0;
 	m_nFileDataLength = 0;
+	m_nETag = 0;
+	m_bAcceptGzip = false;
+	m_bIsGzip = false;
+	m_bHasIfNoneMatch = false;
 
 	for (uint32_t i = 0; i < m_nBytesReceived; i++) {
 		if (m_RequestHeaderResponse[i] == '\n') {
@@ -277,7 +309,7 @@ http::Status HttpDeamonHandleRequest::ParseMethod(char *pLine) {
 }
 
 /**
- * Only interested in "Content-Type" and "Content-Length"
+ * Only interested in "Content-Type", "Content-Length", "Accept-Encoding" and "If-None-Match"
  * Where we check for "Content-Type: application/json" and "Content-Type: application/octet-stream"
  */
 
@@ -324,6 +356,34 @@ http::Status HttpDeamonHandleRequest::ParseHeaderField(char *pLine) {
 		}
 
 		m_nRequestContentSize = nTmp;
+	} else if (strcasecmp(pToken, "Accept-Encoding") == 0) {
+		if ((pToken = strtok(nullptr, "")) != nullptr) {
+			m_bAcceptGzip = (strstr(pToken, "gzip") != nullptr);
+		}
+	} else if (strcasecmp(pToken, "If-None-Match") == 0) {
+		// Skips a weak W/ prefix and the quotes, the ETag is lower case hex
+		if ((pToken = strtok(nullptr, " \"W/")) == nullptr) {
+			return http::Status::OK;
+		}
+
+		uint32_t nTmp = 0;
+		uint32_t i;
+
+		for (i = 0; i < 8; i++) {
+			const auto c = pToken[i];
+			if ((c >= '0') && (c <= '9')) {
+				nTmp = (nTmp << 4) | static_cast<uint32_t>(c - '0');
+			} else if ((c >= 'a') && (c <= 'f')) {
+				nTmp = (nTmp << 4) | static_cast<uint32_t>(c - 'a' + 10);
+			} else {
+				break;
+			}
+		}
+
+		if (i == 8) {
+			m_nIfNoneMatch = nTmp;
+			m_bHasIfNoneMatch = true;
+		}
 	}
 
 	DEBUG_EXIT
@@ -345,10 +405,11 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 		const auto *pGet = &m_pUri[6];
 		switch (http::get_uint(pGet)) {
 		case http::json::get::LIST:
-			nLength = remoteconfig::json_get_list(m_DynamicContent, sizeof(m_DynamicContent));
+			// The address is not in the store, it can change with DHCP
+			nLength = GetJsonCached(http::json::get::LIST, (static_cast<uint64_t>(Network::Get()->GetIp()) << 32) | ConfigStore::GetGeneration(), remoteconfig::json_get_list);
 			break;
 		case http::json::get::VERSION:
-			nLength = remoteconfig::json_get_version(m_DynamicContent, sizeof(m_DynamicContent));
+			nLength = GetJsonCached(http::json::get::VERSION, 0, remoteconfig::json_get_version);
 			break;
 		case http::json::get::UPTIME:
 			if (!RemoteConfig::Get()->IsEnableUptime()) {
@@ -361,7 +422,7 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 			nLength = remoteconfig::json_get_display(m_DynamicContent, sizeof(m_DynamicContent));
 			break;
 		case http::json::get::DIRECTORY:
-			nLength = remoteconfig::json_get_directory(m_DynamicContent, sizeof(m_DynamicContent));
+			nLength = GetJsonCached(http::json::get::DIRECTORY, 0, remoteconfig::json_get_directory);
 			break;
 		case http::json::get::TIMEDATE:
 			nLength = remoteconfig::timedate::json_get_timeofday(m_DynamicContent, sizeof(m_DynamicContent));
@@ -380,6 +441,14 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 		case http::json::get::POLLTABLE:
 			nLength = remoteconfig::artnet::controller::json_get_polltable(m_DynamicContent, sizeof(m_DynamicContent));
 			break;
+#endif
+		case http::json::get::SPIBUS:
+			nLength = remoteconfig::json_get_spibus(m_DynamicContent, sizeof(m_DynamicContent));
+			break;
+#if defined (NODE_ARTNET) || defined (NODE_E131)
+		case http::json::get::SEQUENCE:
+			nLength = remoteconfig::lightset::json_get_sequence(m_DynamicContent, sizeof(m_DynamicContent));
+			break;
 #endif
 #if defined (ENABLE_NET_PHYSTATUS)
 		case http::json::get::PHYSTATUS:
@@ -426,6 +495,18 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 					}
 				} else
 #endif
+#if defined (OUTPUT_DMX_STEPPER)
+				if (memcmp(pGet, "stepper/", 8) == 0) {
+					const auto *pStepper = &pGet[8];
+					switch (http::get_uint(pStepper)) {
+					case http::json::get::STATUS:
+						nLength = remoteconfig::stepper::json_get_status(m_DynamicContent, sizeof(m_DynamicContent));
+						break;
+					default:
+						break;
+					}
+				} else
+#endif
 #if defined (RDM_CONTROLLER) && !defined (CONFIG_HTTP_HTML_NO_RDM)
 					if (memcmp(pGet, "rdm/", 4) == 0) {
 						const auto *pRdm = &pGet[4];
@@ -490,6 +571,9 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 									case http::json::get::DIRECTORY:
 										nLength = remoteconfig::showfile::json_get_directory(m_DynamicContent, sizeof(m_DynamicContent));
 										break;
+									case http::json::get::JITTER:
+										nLength = remoteconfig::showfile::json_get_jitter(m_DynamicContent, sizeof(m_DynamicContent));
+										break;
 									default:
 										break;
 									}
@@ -503,41 +587,49 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 		}
 	}
 #if defined (ENABLE_CONTENT)
-	else if (strcmp(m_pUri, "/") == 0) {
-		m_pContent = get_file_content("index.html", nLength, m_ContentType);
-	}
+	else {
+		const char *pFileName = &m_pUri[1];
+
+		if (strcmp(m_pUri, "/") == 0) {
+			pFileName = "index.html";
+		}
 #if defined (HAVE_DMX)
-	else if (strcmp(m_pUri, "/dmx") == 0) {
-		m_pContent = get_file_content("dmx.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/dmx") == 0) {
+			pFileName = "dmx.html";
+		}
 #endif
 #if defined (RDM_CONTROLLER) && !defined (CONFIG_HTTP_HTML_NO_RDM)
-	else if (strcmp(m_pUri, "/rdm") == 0) {
-		m_pContent = get_file_content("rdm.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/rdm") == 0) {
+			pFileName = "rdm.html";
+		}
 #endif
 #if defined (NODE_SHOWFILE)
-	else if (strcmp(m_pUri, "/showfile") == 0) {
-		m_pContent = get_file_content("showfile.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/showfile") == 0) {
+			pFileName = "showfile.html";
+		}
 #endif
 #if defined (ENABLE_PHY_SWITCH)
-	else if (strcmp(m_pUri, "/dsa") == 0) {
-		m_pContent = get_file_content("dsa.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/dsa") == 0) {
+			pFileName = "dsa.html";
+		}
 #endif
 #if !defined (CONFIG_HTTP_HTML_NO_TIME)
-	else if (strcmp(m_pUri, "/time") == 0) {
-		m_pContent = get_file_content("time.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/time") == 0) {
+			pFileName = "time.html";
+		}
 #endif
 #if !defined (CONFIG_HTTP_HTML_NO_RTC) && !defined (DISABLE_RTC)
-	else if (strcmp(m_pUri, "/rtc") == 0) {
-		m_pContent = get_file_content("rtc.html", nLength, m_ContentType);
-	}
+		else if (strcmp(m_pUri, "/rtc") == 0) {
+			pFileName = "rtc.html";
+		}
 #endif
-	else {
-		m_pContent = get_file_content(&m_pUri[1], nLength, m_ContentType);
+
+		m_pContent = get_file_content(pFileName, m_bAcceptGzip, nLength, m_ContentType, m_nETag, m_bIsGzip);
+
+		if ((nLength != 0) && m_bHasIfNoneMatch && (m_nIfNoneMatch == m_nETag)) {
+			DEBUG_EXIT
+			return http::Status::NOT_MODIFIED;
+		}
 	}
 #endif
 
@@ -552,6 +644,21 @@ http::Status HttpDeamonHandleRequest::HandleGet() {
 	return http::Status::OK;
 }
 
+uint32_t HttpDeamonHandleRequest::GetJsonCached(const uint32_t nId, const uint64_t nGeneration, uint32_t (*pGetJson)(char *, const uint32_t)) {
+	uint32_t nLength;
+
+	if ((m_pContent = http::json::cache::find(nId, nGeneration, nLength)) != nullptr) {
+		return nLength;
+	}
+
+	m_pContent = m_DynamicContent;
+	nLength = pGetJson(m_DynamicContent, sizeof(m_DynamicContent));
+
+	http::json::cache::store(nId, nGeneration, m_DynamicContent, nLength);
+
+	return nLength;
+}
+
 http::Status HttpDeamonHandleRequest::HandleGetTxt() {
 	auto *pFileName = &m_pUri[6];
 	const auto nLength = strlen(pFileName);
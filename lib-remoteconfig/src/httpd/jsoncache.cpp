@@ -0,0 +1,88 @@
+/**
+ * @file jsoncache.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "httpd/jsoncache.h"
+#include "httpd/http.h"
+
+#include "debug.h"
+
+namespace http {
+namespace json {
+namespace cache {
+struct Entry {
+	uint64_t nGeneration;
+	uint32_t nId;
+	uint32_t nLength;
+	uint32_t nHits;
+	char content[http::BUFSIZE];
+};
+
+static Entry s_Entries[ENTRIES];
+
+const char *find(const uint32_t nId, const uint64_t nGeneration, uint32_t& nLength) {
+	for (auto& entry : s_Entries) {
+		if ((entry.nLength != 0) && (entry.nId == nId) && (entry.nGeneration == nGeneration)) {
+			entry.nHits++;
+			nLength = entry.nLength;
+			return entry.content;
+		}
+	}
+
+	return nullptr;
+}
+
+void store(const uint32_t nId, const uint64_t nGeneration, const char *pContent, const uint32_t nLength) {
+	if ((nLength == 0) || (nLength >= http::BUFSIZE)) {
+		return;
+	}
+
+	// A stale entry for the same response first, then the least used
+	auto *pEntry = &s_Entries[0];
+
+	for (auto& entry : s_Entries) {
+		if (entry.nId == nId) {
+			pEntry = &entry;
+			break;
+		}
+
+		if (entry.nHits < pEntry->nHits) {
+			pEntry = &entry;
+		}
+	}
+
+	DEBUG_PRINTF("nId=%x, nLength=%u", nId, nLength);
+
+	memcpy(pEntry->content, pContent, nLength);
+	pEntry->nGeneration = nGeneration;
+	pEntry->nId = nId;
+	pEntry->nLength = nLength;
+	pEntry->nHits = 0;
+}
+}  // namespace cache
+}  // namespace json
+}  // namespace http
@@ -0,0 +1,137 @@
+/**
+ * @file showfilebin.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef FORMATS_SHOWFILEBIN_H_
+#define FORMATS_SHOWFILEBIN_H_
+
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * Binary show file, little-endian, all structures are packed.
+ *
+ * Header | Record [payload] ... | Index ...
+ *
+ * A record is one universe update (KEY or DELTA) or the end of a frame (SYNC).
+ * Record times are relative to the start of the show.
+ * Every KEYFRAME_INTERVAL_MILLIS a key frame is written: a KEY record for all universes,
+ * its offset is added to the index. Playback can start at any index entry.
+ */
+
+#if  !defined (PACKED)
+# define PACKED __attribute__((packed))
+#endif
+
+namespace showfile {
+namespace bin {
+static constexpr char MAGIC[4] = { 'S', 'H', 'O', 'W' };
+static constexpr uint16_t VERSION = 1;
+static constexpr uint32_t MAX_UNIVERSES = 32;
+static constexpr uint32_t UNIVERSE_SIZE = 512;
+static constexpr uint32_t KEYFRAME_INTERVAL_MILLIS = 1000;
+static constexpr uint32_t RUN_GAP_MIN = 4;	///< Unchanged slots needed to start a new run, a run costs 4 bytes
+
+enum class Type : uint8_t {
+	KEY,	///< Payload is the complete universe
+	DELTA,	///< Payload is nRuns times Run followed by Run::nCount slots
+	SYNC	///< End of the frame, no payload
+};
+
+struct Header {
+	char aMagic[4];
+	uint16_t nVersion;
+	uint16_t nUniverses;
+	uint32_t nRecordsOffset;
+	uint32_t nRecordsSize;
+	uint32_t nIndexOffset;
+	uint32_t nIndexEntries;
+	uint32_t nDurationMillis;
+	uint16_t nUniverse[MAX_UNIVERSES];
+} PACKED;
+
+struct Record {
+	uint32_t nMillis;
+	uint16_t nLength;		///< Slots of the universe after applying this record
+	uint16_t nPayload;		///< Bytes following this record
+	uint16_t nRuns;
+	uint8_t nUniverseIndex;	///< Index into Header::nUniverse
+	Type type;
+} PACKED;
+
+struct Run {
+	uint16_t nOffset;
+	uint16_t nCount;
+} PACKED;
+
+struct Index {
+	uint32_t nMillis;
+	uint32_t nOffset;		///< File offset of the first KEY record of a key frame
+} PACKED;
+
+/**
+ * Used by the recorder and by the OLA converter (tools/ola2bin)
+ */
+class Writer {
+public:
+	~Writer();
+
+	bool Begin(FILE *pFile);
+	/**
+	 * A change of nMillis ends the current frame.
+	 */
+	bool Write(const uint16_t nUniverse, const uint8_t *pData, const uint32_t nLength, const uint32_t nMillis);
+	bool Sync();
+	/**
+	 * Writes the index and the final header
+	 * @param nMillis end of the show, used as the loop point
+	 */
+	bool End(const uint32_t nMillis);
+
+private:
+	uint32_t GetUniverseIndex(const uint16_t nUniverse);
+	bool WriteKey(const uint32_t nUniverseIndex, const uint32_t nMillis);
+	bool WriteDelta(const uint32_t nUniverseIndex, const uint8_t *pData, const uint32_t nLength, const uint32_t nMillis);
+	bool WriteRecord(const Record& record, const uint8_t *pPayload);
+	bool AddIndex(const uint32_t nMillis);
+
+private:
+	FILE *m_pFile { nullptr };
+	Header m_Header;
+	Index *m_pIndex { nullptr };
+	uint32_t m_nIndexSize { 0 };
+	uint32_t m_nOffset { 0 };
+	uint32_t m_nStartMillis { 0 };
+	uint32_t m_nFrameMillis { 0 };
+	uint32_t m_nKeyMillis { 0 };
+	bool m_bStarted { false };
+	bool m_bFrameStart { true };
+	uint16_t m_nLength[MAX_UNIVERSES];
+	uint8_t m_Shadow[MAX_UNIVERSES][UNIVERSE_SIZE];
+	uint8_t m_Payload[UNIVERSE_SIZE + (UNIVERSE_SIZE / 2) * sizeof(Run)];
+};
+}  // namespace bin
+}  // namespace showfile
+
+#endif /* FORMATS_SHOWFILEBIN_H_ */
@@ -0,0 +1,174 @@
+/**
+ * @file showfileformatbin.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef FORMATS_SHOWFILEFORMATBIN_H_
+#define FORMATS_SHOWFILEFORMATBIN_H_
+
+#if !(defined (__linux__) || defined (__APPLE__))
+# error The binary show file format needs mmap
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cassert>
+
+#include "formats/showfilebin.h"
+#include "showfileclock.h"
+#include "showfileprotocol.h"
+#include "showfileconst.h"
+
+#include "debug.h"
+
+#define SHOWFILE_PREFIX	"show"
+#define SHOWFILE_SUFFIX	".bin"
+
+namespace showfile {
+static constexpr uint32_t FILE_NAME_LENGTH = sizeof(SHOWFILE_PREFIX "NN" SHOWFILE_SUFFIX) - 1U;
+static constexpr uint32_t FILE_MAX_NUMBER = 99;
+}  // namespace showfile
+
+/**
+ * The show file is mapped into memory, playback is walking the records.
+ * KEY records are handed to DmxOut straight from the mapping.
+ * Looping and seeking only set the record offset and clear the shadow.
+ */
+class ShowFileFormat: ShowFileProtocol {
+public:
+	ShowFileFormat() {
+		DEBUG_ENTRY
+
+		assert(s_pThis == nullptr);
+		s_pThis = this;
+
+		ShowFileProtocol::Start();
+
+		DEBUG_EXIT
+	}
+
+	~ShowFileFormat() {
+		Unmap();
+	}
+
+	void ShowFileStart();
+
+	void ShowFileStop();
+
+	void ShowFileResume();
+
+	/**
+	 * Playback continues from the last key frame at or before nMillis.
+	 * @param nMillis time from the start of the show
+	 * @return false when there is no show mapped or no index
+	 */
+	bool ShowFileSeek(const uint32_t nMillis);
+
+	void ShowFileRecord() {
+		DEBUG_ENTRY
+		DEBUG_PRINTF("m_pShowFile%snullptr", m_pShowFile != nullptr ? "!=" : "==");
+
+		m_bRecording = (m_pShowFile != nullptr) && m_Writer.Begin(m_pShowFile);
+
+		ShowFileProtocol::Record();
+
+		DEBUG_EXIT
+	}
+
+	void ShowFilePrint() {
+		puts(" Format: Binary");
+		ShowFileProtocol::Print();
+	}
+
+	void ShowFileRun(const bool doRun) {
+		if (doRun) {
+			Run();
+		}
+
+		ShowFileProtocol::Run();
+	}
+
+	void DoRunCleanupProcess(const bool bDoRun) {
+		ShowFileProtocol::DoRunCleanupProcess(bDoRun);
+	}
+
+	void ShowfileWrite(const uint8_t *pDmxData, const uint32_t nSize, const uint32_t nUniverse, const uint32_t nMillis) {
+		if (m_bRecording) {
+			m_Writer.Write(static_cast<uint16_t>(nUniverse), pDmxData, nSize, nMillis);
+		}
+	}
+
+	void BlackOut() {
+#if defined (CONFIG_SHOWFILE_ENABLE_MASTER)
+		ShowFileProtocol::DmxBlackout();
+#endif
+	}
+
+	void SetMaster([[maybe_unused]] const uint32_t nMaster) {
+#if defined (CONFIG_SHOWFILE_ENABLE_MASTER)
+		ShowFileProtocol::DmxMaster(nMaster);
+#endif
+	}
+
+	bool IsSyncDisabled() {
+		return ShowFileProtocol::IsSyncDisabled();
+	}
+
+	const showfile::Clock& GetClock() const {
+		return m_Clock;
+	}
+
+	static ShowFileFormat *Get() {
+		return s_pThis;
+	}
+
+private:
+	void Run();
+	bool Map();
+	void Unmap();
+	void Rewind(const uint32_t nOffset);
+	bool PlayRecord(const showfile::bin::Record& record, const uint8_t *pPayload);
+
+protected:
+	uint32_t m_nShowFileCurrent { showfile::FILE_MAX_NUMBER + 1 };
+	bool m_bDoLoop { false };
+	FILE *m_pShowFile { nullptr };
+
+private:
+	static constexpr uint32_t RECORDS_PER_RUN = 64;
+
+	showfile::bin::Writer m_Writer;
+	showfile::Clock m_Clock;
+	const uint8_t *m_pMap { nullptr };
+	uint32_t m_nMapSize { 0 };
+	showfile::bin::Header m_Header;
+	uint32_t m_nOffset { 0 };
+	uint32_t m_nRecordsEnd { 0 };
+	bool m_bRecording { false };
+	uint16_t m_nLength[showfile::bin::MAX_UNIVERSES];
+	uint8_t m_Shadow[showfile::bin::MAX_UNIVERSES][showfile::bin::UNIVERSE_SIZE];
+
+	static ShowFileFormat *s_pThis;
+};
+
+#endif /* FORMATS_SHOWFILEFORMATBIN_H_ */
@@ -36,6 +36,7 @@
 
 #include "showfileprotocol.h"
 #include "showfileconst.h"
+#include "showfileclock.h"
 
 #include "debug.h"
 
@@ -71,29 +72,41 @@ public:
 
 		m_nDelayMillis = 0;
 		m_nLastMillis = 0;
+		m_nShowMillis = 0;
 
 		fseek(m_pShowFile, 0L, SEEK_SET);
 
 		m_OlaState = OlaState::IDLE;
 
+		m_Clock.ResetJitter();
+		m_Clock.Start();
+
 		DEBUG_EXIT
 	}
 
 	void ShowFileStop() {
 		DEBUG_ENTRY
 
+		m_Clock.Stop();
+
 		DEBUG_EXIT
 	}
 
 	void ShowFileResume() {
 		DEBUG_ENTRY
 
-		m_nDelayMillis = 0;
-		m_nLastMillis = 0;
+		m_Clock.Resume();
 
 		DEBUG_EXIT
 	}
 
+	/**
+	 * The OLA format has no index
+	 */
+	bool ShowFileSeek([[maybe_unused]] const uint32_t nMillis) {
+		return false;
+	}
+
 	void ShowFileRecord() {
 		DEBUG_ENTRY
 		DEBUG_PRINTF("m_pShowFile%snullptr", m_pShowFile != nullptr ? "!=" : "==");
@@ -183,6 +196,10 @@ public:
 		return ShowFileProtocol::IsSyncDisabled();
 	}
 
+	const showfile::Clock& GetClock() const {
+		return m_Clock;
+	}
+
 	static ShowFileFormat *Get() {
 		return s_pThis;
 	}
@@ -295,8 +312,10 @@ private:
 	OlaState m_OlaState { OlaState::IDLE };
 	char m_buffer[2048];
 	char m_digitsTable[200];
+	showfile::Clock m_Clock;
 	uint32_t m_nDelayMillis { 0 };
 	uint32_t m_nLastMillis { 0 };
+	uint32_t m_nShowMillis { 0 };
 	uint32_t m_nDmxDataLength { 0 };
 	uint16_t m_nUniverse { 0 };
 	uint8_t m_DmxData[512];
@@ -111,6 +111,24 @@ public:
 		DEBUG_EXIT
 	}
 
+	/**
+	 * @param nMillis time from the start of the show
+	 * @return false when the format has no index or there is no show playing or stopped
+	 */
+	bool Seek(const uint32_t nMillis) {
+		DEBUG_ENTRY
+
+		if ((m_pShowFile == nullptr) || ((m_Status != showfile::Status::PLAYING) && (m_Status != showfile::Status::STOPPED))) {
+			DEBUG_EXIT
+			return false;
+		}
+
+		const auto isSeek = ShowFileFormat::ShowFileSeek(nMillis);
+
+		DEBUG_EXIT
+		return isSeek;
+	}
+
 #if !defined (CONFIG_SHOWFILE_DISABLE_RECORD)
 	void Record() {
 		DEBUG_ENTRY
@@ -0,0 +1,194 @@
+/**
+ * @file showfileclock.h
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILECLOCK_H_
+#define SHOWFILECLOCK_H_
+
+#include <cstdint>
+#include <cstring>
+#if defined (__linux__) || defined (__APPLE__)
+# include <time.h>
+# include <errno.h>
+#else
+# include "hardware.h"
+#endif
+
+namespace showfile {
+namespace jitter {
+static constexpr uint32_t BUCKETS = 8;
+static constexpr uint32_t LIMIT_MICROS[BUCKETS - 1] = { 100, 250, 500, 1000, 2000, 5000, 10000 };
+
+struct Histogram {
+	uint32_t nCount[BUCKETS];	///< Frames released later than LIMIT_MICROS[i - 1] and at most LIMIT_MICROS[i]
+	uint32_t nMaxMicros;
+	uint32_t nFrames;
+};
+}  // namespace jitter
+
+/**
+ * Playback is scheduled against absolute deadlines: show time nMillis is
+ * due at start + nMillis. A late frame does not delay the following frames.
+ * On Linux the clock is CLOCK_MONOTONIC, which is not affected by NTP or RTC
+ * corrections.
+ */
+class Clock {
+public:
+	Clock() {
+		ResetJitter();
+	}
+
+	/**
+	 * @param nShowMillis the show time now
+	 */
+	void Start(const uint32_t nShowMillis = 0) {
+		m_nStopMicros = Now();
+		m_nStartMicros = m_nStopMicros - static_cast<uint64_t>(nShowMillis) * 1000U;
+		m_bFrame = false;
+	}
+
+	void Stop() {
+		m_nStopMicros = Now();
+	}
+
+	void Resume() {
+		m_nStartMicros += (Now() - m_nStopMicros);
+	}
+
+	/**
+	 * Move the start forward, the show time is then counted from the new start.
+	 * Used when looping: deadlines stay on the same grid.
+	 */
+	void Advance(const uint32_t nMillis) {
+		m_nStartMicros += static_cast<uint64_t>(nMillis) * 1000U;
+		m_bFrame = false;
+	}
+
+	/**
+	 * When the deadline is less than SLEEP_MAX_MICROS away, the call sleeps
+	 * until the deadline (Linux only), otherwise it returns immediately.
+	 * The lateness of each new show time is added to the jitter histogram.
+	 * @return true when show time nMillis is due
+	 */
+	bool IsDue(const uint32_t nMillis) {
+		const auto nDeadline = m_nStartMicros + static_cast<uint64_t>(nMillis) * 1000U;
+		auto nNow = Now();
+
+		if (nNow < nDeadline) {
+#if defined (__linux__)
+			if ((nDeadline - nNow) > SLEEP_MAX_MICROS) {
+				return false;
+			}
+
+			struct timespec ts;
+			ts.tv_sec = static_cast<time_t>(nDeadline / 1000000U);
+			ts.tv_nsec = static_cast<long>((nDeadline % 1000000U) * 1000U);
+
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+			}
+
+			nNow = Now();
+#else
+			return false;
+#endif
+		}
+
+		if (m_bFrame && (nMillis == m_nFrameMillis)) {
+			return true;
+		}
+
+		m_bFrame = true;
+		m_nFrameMillis = nMillis;
+
+		const auto nLateMicros = nNow - nDeadline;
+
+		Add(nLateMicros);
+
+		/*
+		 * The system has been stalled, restart the grid instead of
+		 * bursting all the frames that are overdue.
+		 */
+		if (nLateMicros > RESYNC_MICROS) {
+			m_nStartMicros += nLateMicros;
+		}
+
+		return true;
+	}
+
+	void ResetJitter() {
+		memset(&m_Histogram, 0, sizeof(m_Histogram));
+	}
+
+	const jitter::Histogram& GetJitter() const {
+		return m_Histogram;
+	}
+
+private:
+	uint64_t Now() {
+#if defined (__linux__) || defined (__APPLE__)
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<uint64_t>(ts.tv_sec) * 1000000U + static_cast<uint64_t>(ts.tv_nsec) / 1000U;
+#else
+		const auto nMicros = Hardware::Get()->Micros();
+		m_nNowMicros += (nMicros - m_nMicrosPrevious);
+		m_nMicrosPrevious = nMicros;
+		return m_nNowMicros;
+#endif
+	}
+
+	void Add(const uint64_t nLateMicros) {
+		const auto nMicros = nLateMicros > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(nLateMicros);
+
+		uint32_t nBucket = 0;
+
+		while ((nBucket < (jitter::BUCKETS - 1)) && (nMicros > jitter::LIMIT_MICROS[nBucket])) {
+			nBucket++;
+		}
+
+		m_Histogram.nCount[nBucket]++;
+		m_Histogram.nFrames++;
+
+		if (nMicros > m_Histogram.nMaxMicros) {
+			m_Histogram.nMaxMicros = nMicros;
+		}
+	}
+
+private:
+	static constexpr uint64_t SLEEP_MAX_MICROS = 1000;
+	static constexpr uint64_t RESYNC_MICROS = 1000000;
+
+	uint64_t m_nStartMicros { 0 };
+	uint64_t m_nStopMicros { 0 };
+#if !(defined (__linux__) || defined (__APPLE__))
+	uint64_t m_nNowMicros { 0 };
+	uint32_t m_nMicrosPrevious { 0 };
+#endif
+	uint32_t m_nFrameMillis { 0 };
+	bool m_bFrame { false };
+	jitter::Histogram m_Histogram;
+};
+}  // namespace showfile
+
+#endif /* SHOWFILECLOCK_H_ */
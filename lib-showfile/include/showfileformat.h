@@ -28,8 +28,14 @@
 
 #if defined (CONFIG_SHOWFILE_FORMAT_OLA)
 # include "formats/showfileformatola.h"
+#elif defined (CONFIG_SHOWFILE_FORMAT_BIN)
+# include "formats/showfileformatbin.h"
 #else
 # error Format is not supported
 #endif
 
+#if defined (CONFIG_SHOWFILE_FORMAT_OLA) && defined (CONFIG_SHOWFILE_FORMAT_BIN)
+# error Format configuration error
+#endif
+
 #endif /* SHOWFILEFORMAT_H_ */
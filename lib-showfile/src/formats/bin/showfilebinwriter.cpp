@@ -0,0 +1,312 @@
+/**
+ * @file showfilebinwriter.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+#include "formats/showfilebin.h"
+
+#include "debug.h"
+
+namespace showfile {
+namespace bin {
+Writer::~Writer() {
+	free(m_pIndex);
+	m_pIndex = nullptr;
+}
+
+bool Writer::Begin(FILE *pFile) {
+	DEBUG_ENTRY
+	assert(pFile != nullptr);
+
+	m_pFile = pFile;
+
+	memset(&m_Header, 0, sizeof(m_Header));
+	memcpy(m_Header.aMagic, MAGIC, sizeof(MAGIC));
+	m_Header.nVersion = VERSION;
+	m_Header.nRecordsOffset = sizeof(Header);
+	m_nOffset = sizeof(Header);
+	m_bStarted = false;
+	m_bFrameStart = true;
+
+	if (fwrite(&m_Header, sizeof(Header), 1, m_pFile) != 1) {
+		perror("fwrite");
+		DEBUG_EXIT
+		return false;
+	}
+
+	DEBUG_EXIT
+	return true;
+}
+
+uint32_t Writer::GetUniverseIndex(const uint16_t nUniverse) {
+	for (uint32_t i = 0; i < m_Header.nUniverses; i++) {
+		if (m_Header.nUniverse[i] == nUniverse) {
+			return i;
+		}
+	}
+
+	if (m_Header.nUniverses == MAX_UNIVERSES) {
+		return MAX_UNIVERSES;
+	}
+
+	const auto nIndex = m_Header.nUniverses++;
+
+	m_Header.nUniverse[nIndex] = nUniverse;
+	m_nLength[nIndex] = 0;
+
+	return nIndex;
+}
+
+bool Writer::WriteRecord(const Record& record, const uint8_t *pPayload) {
+	if (fwrite(&record, sizeof(Record), 1, m_pFile) != 1) {
+		perror("fwrite");
+		return false;
+	}
+
+	if ((record.nPayload != 0) && (fwrite(pPayload, record.nPayload, 1, m_pFile) != 1)) {
+		perror("fwrite");
+		return false;
+	}
+
+	m_nOffset += static_cast<uint32_t>(sizeof(Record) + record.nPayload);
+	return true;
+}
+
+bool Writer::WriteKey(const uint32_t nUniverseIndex, const uint32_t nMillis) {
+	Record record;
+	record.nMillis = nMillis;
+	record.nLength = m_nLength[nUniverseIndex];
+	record.nPayload = m_nLength[nUniverseIndex];
+	record.nRuns = 0;
+	record.nUniverseIndex = static_cast<uint8_t>(nUniverseIndex);
+	record.type = Type::KEY;
+
+	return WriteRecord(record, m_Shadow[nUniverseIndex]);
+}
+
+/**
+ * Runs of changed slots, runs closer than RUN_GAP_MIN are joined.
+ * When the runs are not smaller than the universe, a KEY record is written.
+ */
+bool Writer::WriteDelta(const uint32_t nUniverseIndex, const uint8_t *pData, const uint32_t nLength, const uint32_t nMillis) {
+	auto *pShadow = m_Shadow[nUniverseIndex];
+
+	if (nLength > m_nLength[nUniverseIndex]) {
+		memset(&pShadow[m_nLength[nUniverseIndex]], 0, nLength - m_nLength[nUniverseIndex]);
+	}
+
+	uint32_t nPayload = 0;
+	uint32_t nRuns = 0;
+	uint32_t i = 0;
+
+	while (i < nLength) {
+		if (pData[i] == pShadow[i]) {
+			i++;
+			continue;
+		}
+
+		const auto nFirst = i;
+		auto nLast = i;
+
+		for (uint32_t nGap = 0; (i < nLength) && (nGap < RUN_GAP_MIN); i++) {
+			if (pData[i] != pShadow[i]) {
+				nLast = i;
+				nGap = 0;
+			} else {
+				nGap++;
+			}
+		}
+
+		const auto nCount = nLast - nFirst + 1;
+
+		if ((nPayload + sizeof(Run) + nCount) >= nLength) {
+			nPayload = nLength;
+			break;
+		}
+
+		Run run;
+		run.nOffset = static_cast<uint16_t>(nFirst);
+		run.nCount = static_cast<uint16_t>(nCount);
+
+		memcpy(&m_Payload[nPayload], &run, sizeof(Run));
+		memcpy(&m_Payload[nPayload + sizeof(Run)], &pData[nFirst], nCount);
+		nPayload += static_cast<uint32_t>(sizeof(Run) + nCount);
+		nRuns++;
+
+		i = nLast + 1;
+	}
+
+	memcpy(pShadow, pData, nLength);
+	m_nLength[nUniverseIndex] = static_cast<uint16_t>(nLength);
+
+	if (nPayload >= nLength) {
+		return WriteKey(nUniverseIndex, nMillis);
+	}
+
+	Record record;
+	record.nMillis = nMillis;
+	record.nLength = static_cast<uint16_t>(nLength);
+	record.nPayload = static_cast<uint16_t>(nPayload);
+	record.nRuns = static_cast<uint16_t>(nRuns);
+	record.nUniverseIndex = static_cast<uint8_t>(nUniverseIndex);
+	record.type = Type::DELTA;
+
+	return WriteRecord(record, m_Payload);
+}
+
+bool Writer::AddIndex(const uint32_t nMillis) {
+	if ((m_Header.nIndexEntries % 64) == 0) {
+		auto *pIndex = static_cast<Index *>(realloc(m_pIndex, (m_Header.nIndexEntries + 64) * sizeof(Index)));
+
+		if (pIndex == nullptr) {
+			perror("realloc");
+			return false;
+		}
+
+		m_pIndex = pIndex;
+	}
+
+	m_pIndex[m_Header.nIndexEntries].nMillis = nMillis;
+	m_pIndex[m_Header.nIndexEntries].nOffset = m_nOffset;
+	m_Header.nIndexEntries++;
+
+	return true;
+}
+
+bool Writer::Write(const uint16_t nUniverse, const uint8_t *pData, const uint32_t nLength, const uint32_t nMillis) {
+	assert(m_pFile != nullptr);
+	assert(pData != nullptr);
+
+	if (nLength > UNIVERSE_SIZE) {
+		return false;
+	}
+
+	if (!m_bStarted) {
+		m_bStarted = true;
+		m_nStartMillis = nMillis;
+		m_nKeyMillis = nMillis - KEYFRAME_INTERVAL_MILLIS;
+	}
+
+	if (!m_bFrameStart && (nMillis != m_nFrameMillis)) {
+		if (!Sync()) {
+			return false;
+		}
+	}
+
+	const auto nUniverseIndex = GetUniverseIndex(nUniverse);
+
+	if (nUniverseIndex == MAX_UNIVERSES) {
+		DEBUG_PRINTF("Universe %u ignored", nUniverse);
+		return true;
+	}
+
+	const auto nRelativeMillis = nMillis - m_nStartMillis;
+
+	if (m_bFrameStart) {
+		m_bFrameStart = false;
+		m_nFrameMillis = nMillis;
+
+		if ((nMillis - m_nKeyMillis) >= KEYFRAME_INTERVAL_MILLIS) {
+			m_nKeyMillis = nMillis;
+
+			if (!AddIndex(nRelativeMillis)) {
+				return false;
+			}
+
+			memcpy(m_Shadow[nUniverseIndex], pData, nLength);
+			m_nLength[nUniverseIndex] = static_cast<uint16_t>(nLength);
+
+			for (uint32_t i = 0; i < m_Header.nUniverses; i++) {
+				if (!WriteKey(i, nRelativeMillis)) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	return WriteDelta(nUniverseIndex, pData, nLength, nRelativeMillis);
+}
+
+bool Writer::Sync() {
+	if (m_bFrameStart) {
+		return true;
+	}
+
+	m_bFrameStart = true;
+
+	Record record;
+	record.nMillis = m_nFrameMillis - m_nStartMillis;
+	record.nLength = 0;
+	record.nPayload = 0;
+	record.nRuns = 0;
+	record.nUniverseIndex = 0;
+	record.type = Type::SYNC;
+
+	return WriteRecord(record, nullptr);
+}
+
+bool Writer::End(const uint32_t nMillis) {
+	DEBUG_ENTRY
+	assert(m_pFile != nullptr);
+
+	if (!Sync()) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_Header.nRecordsSize = m_nOffset - m_Header.nRecordsOffset;
+	m_Header.nIndexOffset = m_nOffset;
+	m_Header.nDurationMillis = m_bStarted ? nMillis - m_nStartMillis : 0;
+
+	if ((m_Header.nIndexEntries != 0) && (fwrite(m_pIndex, sizeof(Index), m_Header.nIndexEntries, m_pFile) != m_Header.nIndexEntries)) {
+		perror("fwrite");
+		DEBUG_EXIT
+		return false;
+	}
+
+	if ((fseek(m_pFile, 0L, SEEK_SET) != 0) || (fwrite(&m_Header, sizeof(Header), 1, m_pFile) != 1)) {
+		perror("fwrite");
+		DEBUG_EXIT
+		return false;
+	}
+
+	fflush(m_pFile);
+
+	free(m_pIndex);
+	m_pIndex = nullptr;
+	m_pFile = nullptr;
+
+	DEBUG_PRINTF("nRecordsSize=%u, nIndexEntries=%u, nDurationMillis=%u", m_Header.nRecordsSize, m_Header.nIndexEntries, m_Header.nDurationMillis);
+	DEBUG_EXIT
+	return true;
+}
+}  // namespace bin
+}  // namespace showfile
@@ -0,0 +1,301 @@
+/**
+ * @file showfileformatbin.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cassert>
+
+#include "formats/showfileformatbin.h"
+#include "showfile.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+ShowFileFormat *ShowFileFormat::s_pThis;
+
+using namespace showfile::bin;
+
+bool ShowFileFormat::Map() {
+	DEBUG_ENTRY
+
+	Unmap();
+
+	struct stat st;
+
+	if (fstat(fileno(m_pShowFile), &st) != 0) {
+		perror("fstat");
+		DEBUG_EXIT
+		return false;
+	}
+
+	if (static_cast<size_t>(st.st_size) < sizeof(Header)) {
+		puts("Show file is too small");
+		DEBUG_EXIT
+		return false;
+	}
+
+	auto *pMap = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fileno(m_pShowFile), 0);
+
+	if (pMap == MAP_FAILED) {
+		perror("mmap");
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_pMap = static_cast<const uint8_t *>(pMap);
+	m_nMapSize = static_cast<uint32_t>(st.st_size);
+
+	memcpy(&m_Header, m_pMap, sizeof(Header));
+
+	const auto isValid = (memcmp(m_Header.aMagic, MAGIC, sizeof(MAGIC)) == 0)
+			&& (m_Header.nVersion == VERSION)
+			&& (m_Header.nUniverses <= MAX_UNIVERSES)
+			&& (m_Header.nRecordsOffset >= sizeof(Header))
+			&& (m_Header.nRecordsOffset <= m_nMapSize)
+			&& (m_Header.nRecordsSize <= (m_nMapSize - m_Header.nRecordsOffset))
+			&& (m_Header.nIndexOffset <= m_nMapSize)
+			&& (m_Header.nIndexEntries <= ((m_nMapSize - m_Header.nIndexOffset) / sizeof(Index)));
+
+	if (!isValid) {
+		puts("Show file is not valid");
+		Unmap();
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_nRecordsEnd = m_Header.nRecordsOffset + m_Header.nRecordsSize;
+
+	madvise(pMap, m_nMapSize, MADV_SEQUENTIAL);
+
+	DEBUG_PRINTF("nUniverses=%u, nRecordsSize=%u, nIndexEntries=%u", m_Header.nUniverses, m_Header.nRecordsSize, m_Header.nIndexEntries);
+	DEBUG_EXIT
+	return true;
+}
+
+void ShowFileFormat::Unmap() {
+	if (m_pMap != nullptr) {
+		munmap(const_cast<uint8_t *>(m_pMap), m_nMapSize);
+		m_pMap = nullptr;
+		m_nMapSize = 0;
+	}
+}
+
+/**
+ * The writer records a universe which first appears after frame 0 as a delta
+ * against a zero shadow, so the shadow must be zero again at the start of the records.
+ * A key frame has a KEY record for every universe seen so far, so the same holds for an index entry.
+ */
+void ShowFileFormat::Rewind(const uint32_t nOffset) {
+	memset(m_nLength, 0, sizeof(m_nLength));
+	memset(m_Shadow, 0, sizeof(m_Shadow));
+
+	m_nOffset = nOffset;
+}
+
+void ShowFileFormat::ShowFileStart() {
+	DEBUG_ENTRY
+
+	/*
+	 * Always mapped again, the show file could have been replaced.
+	 */
+	if (!Map()) {
+		DEBUG_EXIT
+		return;
+	}
+
+	Rewind(m_Header.nRecordsOffset);
+	m_Clock.ResetJitter();
+	m_Clock.Start();
+
+	DEBUG_EXIT
+}
+
+void ShowFileFormat::ShowFileStop() {
+	DEBUG_ENTRY
+
+	if (m_bRecording) {
+		m_bRecording = false;
+		m_Writer.End(Hardware::Get()->Millis());
+	}
+
+	m_Clock.Stop();
+
+	DEBUG_EXIT
+}
+
+void ShowFileFormat::ShowFileResume() {
+	DEBUG_ENTRY
+
+	m_Clock.Resume();
+
+	DEBUG_EXIT
+}
+
+bool ShowFileFormat::ShowFileSeek(const uint32_t nMillis) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nMillis=%u", nMillis);
+
+	if ((m_pMap == nullptr) || (m_Header.nIndexEntries == 0)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	const auto *pIndex = &m_pMap[m_Header.nIndexOffset];
+
+	uint32_t nLow = 0;
+	uint32_t nHigh = m_Header.nIndexEntries;
+
+	while ((nHigh - nLow) > 1) {
+		const auto nMiddle = (nLow + nHigh) / 2;
+		Index index;
+		memcpy(&index, &pIndex[nMiddle * sizeof(Index)], sizeof(Index));
+
+		if (index.nMillis <= nMillis) {
+			nLow = nMiddle;
+		} else {
+			nHigh = nMiddle;
+		}
+	}
+
+	Index index;
+	memcpy(&index, &pIndex[nLow * sizeof(Index)], sizeof(Index));
+
+	if ((index.nOffset < m_Header.nRecordsOffset) || ((index.nOffset + sizeof(showfile::bin::Record)) > m_nRecordsEnd)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	showfile::bin::Record record;
+	memcpy(&record, &m_pMap[index.nOffset], sizeof(showfile::bin::Record));
+
+	if (record.type != Type::KEY) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	Rewind(index.nOffset);
+	m_Clock.Start(index.nMillis);
+
+	DEBUG_PRINTF("index.nMillis=%u, index.nOffset=%u", index.nMillis, index.nOffset);
+	DEBUG_EXIT
+	return true;
+}
+
+bool ShowFileFormat::PlayRecord(const showfile::bin::Record& record, const uint8_t *pPayload) {
+	if (record.type == Type::SYNC) {
+		ShowFileProtocol::DmxSync();
+		return true;
+	}
+
+	if ((record.nUniverseIndex >= m_Header.nUniverses) || (record.nLength > UNIVERSE_SIZE)) {
+		return false;
+	}
+
+	const auto nUniverse = m_Header.nUniverse[record.nUniverseIndex];
+	auto *pShadow = m_Shadow[record.nUniverseIndex];
+
+	if (record.type == Type::KEY) {
+		if (record.nPayload != record.nLength) {
+			return false;
+		}
+
+		ShowFileProtocol::DmxOut(nUniverse, pPayload, record.nLength);
+		memcpy(pShadow, pPayload, record.nLength);
+		m_nLength[record.nUniverseIndex] = record.nLength;
+		return true;
+	}
+
+	if (record.type != Type::DELTA) {
+		return false;
+	}
+
+	if (record.nLength > m_nLength[record.nUniverseIndex]) {
+		memset(&pShadow[m_nLength[record.nUniverseIndex]], 0, record.nLength - m_nLength[record.nUniverseIndex]);
+	}
+
+	uint32_t nPayload = 0;
+
+	for (uint32_t i = 0; i < record.nRuns; i++) {
+		if ((nPayload + sizeof(showfile::bin::Run)) > record.nPayload) {
+			return false;
+		}
+
+		showfile::bin::Run run;
+		memcpy(&run, &pPayload[nPayload], sizeof(showfile::bin::Run));
+		nPayload += static_cast<uint32_t>(sizeof(showfile::bin::Run));
+
+		if (((run.nOffset + run.nCount) > record.nLength) || ((nPayload + run.nCount) > record.nPayload)) {
+			return false;
+		}
+
+		memcpy(&pShadow[run.nOffset], &pPayload[nPayload], run.nCount);
+		nPayload += run.nCount;
+	}
+
+	m_nLength[record.nUniverseIndex] = record.nLength;
+	ShowFileProtocol::DmxOut(nUniverse, pShadow, record.nLength);
+
+	return true;
+}
+
+void ShowFileFormat::Run() {
+	if (__builtin_expect((m_pMap == nullptr), 0)) {
+		ShowFile::Get()->SetStatus(showfile::Status::ENDED);
+		return;
+	}
+
+	for (uint32_t nRecords = 0; nRecords < RECORDS_PER_RUN; nRecords++) {
+		if ((m_nOffset + sizeof(showfile::bin::Record)) > m_nRecordsEnd) {
+			if (m_bDoLoop) {
+				Rewind(m_Header.nRecordsOffset);
+				m_Clock.Advance(m_Header.nDurationMillis);
+			} else {
+				ShowFile::Get()->SetStatus(showfile::Status::ENDED);
+			}
+			return;
+		}
+
+		showfile::bin::Record record;
+		memcpy(&record, &m_pMap[m_nOffset], sizeof(showfile::bin::Record));
+
+		if (!m_Clock.IsDue(record.nMillis)) {
+			return;
+		}
+
+		const auto nNext = m_nOffset + static_cast<uint32_t>(sizeof(showfile::bin::Record)) + record.nPayload;
+
+		if ((nNext > m_nRecordsEnd) || !PlayRecord(record, &m_pMap[m_nOffset + sizeof(showfile::bin::Record)])) {
+			printf("Show file error at offset %u\n", static_cast<unsigned int>(m_nOffset));
+			ShowFile::Get()->SetStatus(showfile::Status::ENDED);
+			return;
+		}
+
+		m_nOffset = nNext;
+	}
+}
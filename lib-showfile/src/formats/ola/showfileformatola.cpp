@@ -31,8 +31,6 @@
 #include "formats/showfileformatola.h"
 #include "showfile.h"
 
-#include "hardware.h"
-
 #include "debug.h"
 
 ShowFileFormat *ShowFileFormat::s_pThis;
@@ -51,20 +49,20 @@ void ShowFileFormat::Run() {
 					ShowFileProtocol::DmxSync();
 				}
 			}
+			m_nShowMillis += m_nDelayMillis;
 			m_OlaState = OlaState::TIME_WAITING;
 		} else if (m_OlaParseCode == OlaParseCode::EOFILE) {
 			if (m_bDoLoop) {
 				fseek(m_pShowFile, 0L, SEEK_SET);
+				m_Clock.Advance(m_nShowMillis);
+				m_nShowMillis = 0;
 			} else {
 				ShowFile::Get()->SetStatus(showfile::Status::ENDED);
 			}
 		}
 	}
 
-	const auto nMillis = Hardware::Get()->Millis();
-
-	if ((nMillis - m_nLastMillis) >= m_nDelayMillis) {
-		m_nLastMillis = nMillis;
+	if (m_Clock.IsDue(m_nShowMillis)) {
 		m_OlaState = OlaState::PARSING_DMX;
 	}
 }
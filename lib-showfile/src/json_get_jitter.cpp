@@ -0,0 +1,66 @@
+/**
+ * @file json_get_jitter.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "showfile.h"
+#include "showfileclock.h"
+
+namespace remoteconfig {
+namespace showfile {
+/**
+ * /json/showfile/jitter
+ * How late the frames of the current show have been released, in microseconds.
+ */
+uint32_t json_get_jitter(char *pOutBuffer, const uint32_t nOutBufferSize) {
+	const auto& histogram = ShowFile::Get()->GetClock().GetJitter();
+
+	auto nLength = static_cast<uint32_t>(snprintf(pOutBuffer, nOutBufferSize,
+			"{\"frames\":%u,\"max_us\":%u,\"histogram\":[",
+			static_cast<unsigned int>(histogram.nFrames),
+			static_cast<unsigned int>(histogram.nMaxMicros)));
+
+	for (uint32_t i = 0; (i < ::showfile::jitter::BUCKETS) && (nLength < nOutBufferSize); i++) {
+		if (i < (::showfile::jitter::BUCKETS - 1)) {
+			nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength,
+					"{\"le_us\":%u,\"count\":%u},",
+					static_cast<unsigned int>(::showfile::jitter::LIMIT_MICROS[i]),
+					static_cast<unsigned int>(histogram.nCount[i])));
+		} else {
+			nLength += static_cast<uint32_t>(snprintf(&pOutBuffer[nLength], nOutBufferSize - nLength,
+					"{\"le_us\":\"inf\",\"count\":%u}]}",
+					static_cast<unsigned int>(histogram.nCount[i])));
+		}
+	}
+
+	if (nLength >= nOutBufferSize) {
+		return nOutBufferSize;
+	}
+
+	return nLength;
+}
+}  // namespace showfile
+}  // namespace remoteconfig
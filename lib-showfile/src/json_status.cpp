@@ -62,6 +62,13 @@ static void staticCallbackFunction([[maybe_unused]] void *p, const char *s) {
 		return;
 	}
 
+	uint32_t nValue32;
+
+	if (Sscan::Uint32(s, "seek", nValue32) == Sscan::OK) {
+		ShowFile::Get()->Seek(nValue32);
+		return;
+	}
+
 	char action[8];
 	uint32_t nLength = sizeof(action) - 1;
 
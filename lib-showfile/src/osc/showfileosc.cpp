@@ -43,6 +43,7 @@ namespace cmd {
 	static constexpr char START[] = "start";
 	static constexpr char STOP[] = "stop";
 	static constexpr char RESUME[] = "resume";
+	static constexpr char SEEK[] = "seek";
 	static constexpr char SHOW[] = "show";
 	static constexpr char LOOP[] = "loop";
 	static constexpr char BO[] = "blackout";
@@ -60,6 +61,7 @@ namespace length {
 	static constexpr uint32_t START = sizeof(cmd::START) - 1;
 	static constexpr uint32_t STOP = sizeof(cmd::STOP) - 1;
 	static constexpr uint32_t RESUME = sizeof(cmd::RESUME) - 1;
+	static constexpr uint32_t SEEK = sizeof(cmd::SEEK) - 1;
 	static constexpr uint32_t SHOW = sizeof(cmd::SHOW) - 1;
 	static constexpr uint32_t LOOP = sizeof(cmd::LOOP) - 1;
 	static constexpr uint32_t BO = sizeof(cmd::BO) - 1;
@@ -114,6 +116,31 @@ void ShowFileOSC::Process() {
 		return;
 	}
 
+	/*
+	 * Time from the start of the show in milliseconds
+	 */
+	if (memcmp(&m_pBuffer[length::PATH], cmd::SEEK, length::SEEK) == 0) {
+		OscSimpleMessage Msg(m_pBuffer, m_nBytesReceived);
+
+		int nValue;
+
+		if (Msg.GetType(0) == osc::type::INT32) {
+			nValue = Msg.GetInt(0);
+		} else if (Msg.GetType(0) == osc::type::FLOAT) { // TouchOSC
+			nValue = static_cast<int>(Msg.GetFloat(0));
+		} else {
+			return;
+		}
+
+		if (nValue >= 0) {
+			ShowFile::Get()->Seek(static_cast<uint32_t>(nValue));
+			SendStatus();
+		}
+
+		DEBUG_PRINTF("Seek %d", nValue);
+		return;
+	}
+
 	if (memcmp(&m_pBuffer[length::PATH], cmd::SHOW, length::SHOW) == 0) {
 		OscSimpleMessage Msg(m_pBuffer, m_nBytesReceived);
 
@@ -38,7 +38,7 @@ bool filename_copyto(char *pShowFileName, const uint32_t nLength, const uint32_t
 	assert(nLength == showfile::FILE_NAME_LENGTH + 1);
 
 	if (nShowFileNumber <= showfile::FILE_MAX_NUMBER) {
-		snprintf(pShowFileName, nLength, "show%.2u.txt", static_cast<unsigned int>(nShowFileNumber));
+		snprintf(pShowFileName, nLength, SHOWFILE_PREFIX "%.2u" SHOWFILE_SUFFIX, static_cast<unsigned int>(nShowFileNumber));
 		return true;
 	}
 
@@ -0,0 +1,141 @@
+/**
+ * @file ola2bin.cpp
+ *
+ */
+/* Copyright (C) 2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * Converts an OLA text show file into the binary show file format.
+ * Usage: ola2bin show01.txt show01.bin
+ *
+ * OLA show file:
+ * OLA Show
+ * <universe> <slot>,<slot>,...
+ * <delay in milliseconds>
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+
+#include "formats/showfilebin.h"
+
+static char s_Line[4096];
+
+static bool parse_dmx(const char *pLine, uint8_t *pData, uint32_t& nLength) {
+	nLength = 0;
+
+	while (isdigit(static_cast<int>(*pLine))) {
+		char *pEnd;
+		const auto nValue = strtoul(pLine, &pEnd, 10);
+
+		if ((nValue > 255) || (nLength == showfile::bin::UNIVERSE_SIZE)) {
+			return false;
+		}
+
+		pData[nLength++] = static_cast<uint8_t>(nValue);
+		pLine = (*pEnd == ',') ? pEnd + 1 : pEnd;
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv) {
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s <show.txt> <show.bin>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	auto *pIn = fopen(argv[1], "r");
+
+	if (pIn == nullptr) {
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	auto *pOut = fopen(argv[2], "wb");
+
+	if (pOut == nullptr) {
+		perror(argv[2]);
+		fclose(pIn);
+		return EXIT_FAILURE;
+	}
+
+	auto *pWriter = new showfile::bin::Writer;
+	uint8_t data[showfile::bin::UNIVERSE_SIZE];
+	uint32_t nMillis = 0;
+	uint32_t nLines = 0;
+	uint32_t nFrames = 0;
+	auto isOk = pWriter->Begin(pOut);
+
+	while (isOk && (fgets(s_Line, sizeof(s_Line), pIn) != nullptr)) {
+		nLines++;
+
+		if (!isdigit(static_cast<int>(s_Line[0]))) {
+			continue;
+		}
+
+		char *pEnd;
+		const auto nValue = strtoul(s_Line, &pEnd, 10);
+
+		if (*pEnd == ' ') {
+			uint32_t nLength;
+
+			if ((nValue > UINT16_MAX) || !parse_dmx(pEnd + 1, data, nLength)) {
+				fprintf(stderr, "%s:%u: invalid DMX data\n", argv[1], static_cast<unsigned int>(nLines));
+				isOk = false;
+				break;
+			}
+
+			if (nLength != 0) {
+				isOk = pWriter->Write(static_cast<uint16_t>(nValue), data, nLength, nMillis);
+			}
+		} else {
+			isOk = pWriter->Sync();
+			nMillis += static_cast<uint32_t>(nValue);
+			nFrames++;
+		}
+	}
+
+	if (isOk) {
+		isOk = pWriter->End(nMillis);
+	}
+
+	delete pWriter;
+	fclose(pIn);
+
+	if (fclose(pOut) != 0) {
+		perror(argv[2]);
+		isOk = false;
+	}
+
+	if (!isOk) {
+		fprintf(stderr, "Conversion failed\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %u lines, %u frames, %u ms -> %s\n", argv[1], static_cast<unsigned int>(nLines), static_cast<unsigned int>(nFrames), static_cast<unsigned int>(nMillis), argv[2]);
+
+	return EXIT_SUCCESS;
+}
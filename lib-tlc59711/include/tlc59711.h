@@ -2,7 +2,7 @@
  * @file tlc59711.h
  *
  */
-/* Copyright (C) 2018-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2018-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -78,6 +78,13 @@ public:
 
 	void SetRgb(uint8_t nOut, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
 
+	/**
+	 * Expands 8-bit values for channel 0 up to nChannels into the board ordered buffer.
+	 * @param pMaxValue upper limit per channel, nullptr is no limit
+	 * @return true when at least one channel has changed
+	 */
+	bool SetData(const uint8_t *pData, uint32_t nChannels, const uint16_t *pMaxValue = nullptr);
+
 	void Update();
 	void Blackout();
 
@@ -89,6 +96,7 @@ private:
 private:
 	uint8_t m_nBoards;
 	uint32_t m_nSpiSpeedHz;
+	int32_t m_nSpiDevice { -1 };
 	uint32_t m_nFirst32 { 0 };
 	uint16_t *m_pBuffer { nullptr };
 	uint16_t *m_pBufferBlackout { nullptr };
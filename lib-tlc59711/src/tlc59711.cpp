@@ -2,7 +2,7 @@
  * @file tlc59711.cpp
  *
  */
-/* Copyright (C) 2018-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2018-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -29,10 +29,16 @@
 #endif
 #include <cstring>
 #include <cassert>
+#if defined (__ARM_NEON)
+# include <arm_neon.h>
+#elif defined (__SSE2__)
+# include <emmintrin.h>
+#endif
 
 #include "tlc59711.h"
 
 #include "hal_spi.h"
+#include "hal_spibus.h"
 
 #define TLC59711_RGB_8BIT_VALUE(x)	((uint8_t)(x))
 #define TLC59711_RGB_16BIT_VALUE(x)	((uint16_t)(x))
@@ -72,6 +78,9 @@ TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz):
 		m_nSpiSpeedHz = TLC59711SpiSpeed::MAX;
 	}
 
+	m_nSpiDevice = hal::spi::Bus::Get().Register("TLC59711", SPI_CS_NONE, m_nSpiSpeedHz, SPI_MODE0);
+	assert(m_nSpiDevice >= 0);
+
 	if (nBoards == 0) {
 		nBoards = 1;
 	}
@@ -103,6 +112,12 @@ TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz):
 }
 
 TLC59711::~TLC59711() {
+	// A queued write still points to one of the buffers, it is done by Unregister()
+	hal::spi::Bus::Get().Unregister(m_nSpiDevice);
+
+	delete[] m_pBufferBlackout;
+	m_pBufferBlackout = nullptr;
+
 	delete[] m_pBuffer;
 	m_pBuffer = nullptr;
 }
@@ -199,6 +214,111 @@ void TLC59711::SetRgb(uint8_t nOut, uint8_t nRed, uint8_t nGreen, uint8_t nBlue)
 #endif
 }
 
+/*
+ * One board: the 12 channels are shifted out in reverse order, each as a big endian 16-bit value.
+ * pOut[11 - i] = bswap16(min(pIn[i] * 0x0101, pMax[i]))
+ */
+static bool set_board(uint16_t *pOut, const uint8_t *pIn, const uint16_t *pMax) {
+	uint8_t in[16];
+	uint16_t max[16];
+
+	memcpy(in, pIn, TLC59711Channels::OUT);
+
+	if (pMax != nullptr) {
+		memcpy(max, pMax, TLC59711Channels::OUT * sizeof(uint16_t));
+	} else {
+		memset(max, 0xFF, TLC59711Channels::OUT * sizeof(uint16_t));
+	}
+
+#if defined (__ARM_NEON)
+	const auto in8 = vld1q_u8(in);
+	const auto zip = vzipq_u8(in8, in8);
+	// Channels 0-7 and 8-11
+	auto w0 = vminq_u16(vreinterpretq_u16_u8(zip.val[0]), vld1q_u16(&max[0]));
+	auto w1 = vminq_u16(vreinterpretq_u16_u8(zip.val[1]), vld1q_u16(&max[8]));
+	w0 = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(w0)));
+	w1 = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(w1)));
+	// Reverse the lanes
+	w0 = vrev64q_u16(w0);
+	w0 = vextq_u16(w0, w0, 4);
+	const auto w1Reversed = vrev64_u16(vget_low_u16(w1));
+
+	const auto diff = vorrq_u16(veorq_u16(vld1q_u16(&pOut[4]), w0), vcombine_u16(veor_u16(vld1_u16(&pOut[0]), w1Reversed), vdup_n_u16(0)));
+
+	vst1_u16(&pOut[0], w1Reversed);
+	vst1q_u16(&pOut[4], w0);
+
+	const auto d = vreinterpretq_u64_u16(diff);
+	return (vgetq_lane_u64(d, 0) | vgetq_lane_u64(d, 1)) != 0;
+#elif defined (__SSE2__)
+	const auto in8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+	const auto signBit = _mm_set1_epi16(static_cast<short>(0x8000));
+	// Channels 0-7 and 8-11, unsigned min with the signed SSE2 instruction
+	auto w0 = _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(_mm_unpacklo_epi8(in8, in8), signBit), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&max[0])), signBit)), signBit);
+	auto w1 = _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(_mm_unpackhi_epi8(in8, in8), signBit), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&max[8])), signBit)), signBit);
+	w0 = _mm_or_si128(_mm_slli_epi16(w0, 8), _mm_srli_epi16(w0, 8));
+	w1 = _mm_or_si128(_mm_slli_epi16(w1, 8), _mm_srli_epi16(w1, 8));
+	// Reverse the lanes
+	w0 = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(w0, 0x1B), 0x1B), 0x4E);
+	w1 = _mm_shufflelo_epi16(w1, 0x1B);
+
+	const auto diff = _mm_or_si128(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOut[4])), w0), _mm_move_epi64(_mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(&pOut[0])), w1)));
+
+	_mm_storel_epi64(reinterpret_cast<__m128i *>(&pOut[0]), w1);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(&pOut[4]), w0);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF;
+#else
+	uint16_t nChanged = 0;
+
+	for (uint32_t i = 0; i < TLC59711Channels::OUT; i++) {
+		auto nValue = static_cast<uint16_t>((in[i] << 8) | in[i]);
+
+		if (nValue > max[i]) {
+			nValue = max[i];
+		}
+
+		nValue = __builtin_bswap16(nValue);
+		nChanged |= static_cast<uint16_t>(pOut[11 - i] ^ nValue);
+		pOut[11 - i] = nValue;
+	}
+
+	return nChanged != 0;
+#endif
+}
+
+bool TLC59711::SetData(const uint8_t *pData, uint32_t nChannels, const uint16_t *pMaxValue) {
+	assert(pData != nullptr);
+
+	if (nChannels > (m_nBoards * TLC59711Channels::OUT)) {
+		nChannels = m_nBoards * TLC59711Channels::OUT;
+	}
+
+	bool bChanged = false;
+	uint32_t nChannel = 0;
+	auto *pOut = &m_pBuffer[2];
+
+	for (; (nChannel + TLC59711Channels::OUT) <= nChannels; nChannel += TLC59711Channels::OUT) {
+		bChanged |= set_board(pOut, &pData[nChannel], pMaxValue != nullptr ? &pMaxValue[nChannel] : nullptr);
+		pOut += TLC59711Channels::U16BIT;
+	}
+
+	// The remaining channels of a partially used board
+	for (uint32_t i = 0; nChannel < nChannels; nChannel++, i++) {
+		auto nValue = static_cast<uint16_t>((pData[nChannel] << 8) | pData[nChannel]);
+
+		if ((pMaxValue != nullptr) && (nValue > pMaxValue[nChannel])) {
+			nValue = pMaxValue[nChannel];
+		}
+
+		nValue = __builtin_bswap16(nValue);
+		bChanged |= (pOut[11 - i] != nValue);
+		pOut[11 - i] = nValue;
+	}
+
+	return bChanged;
+}
+
 int TLC59711::GetBlank() const {
 	return (m_nFirst32 & (1U << TLC59711_BLANK_SHIFT)) == (1U << TLC59711_BLANK_SHIFT);
 }
@@ -352,17 +472,11 @@ void TLC59711::Dump() {
 void TLC59711::Update() {
 	assert(m_pBuffer != nullptr);
 
-	FUNC_PREFIX(spi_chipSelect(SPI_CS_NONE));
-	FUNC_PREFIX(spi_set_speed_hz(m_nSpiSpeedHz));
-	FUNC_PREFIX(spi_setDataMode(SPI_MODE0));
-	FUNC_PREFIX(spi_writenb(reinterpret_cast<char *>(m_pBuffer), m_nBufSize * 2));
+	hal::spi::Bus::Get().Queue(m_nSpiDevice, reinterpret_cast<char *>(m_pBuffer), m_nBufSize * 2);
 }
 
 void TLC59711::Blackout() {
 	assert(m_pBufferBlackout != nullptr);
 
-	FUNC_PREFIX(spi_chipSelect(SPI_CS_NONE));
-	FUNC_PREFIX(spi_set_speed_hz(m_nSpiSpeedHz));
-	FUNC_PREFIX(spi_setDataMode(SPI_MODE0));
-	FUNC_PREFIX(spi_writenb(reinterpret_cast<char *>(m_pBufferBlackout), m_nBufSize * 2));
+	hal::spi::Bus::Get().Queue(m_nSpiDevice, reinterpret_cast<char *>(m_pBufferBlackout), m_nBufSize * 2);
 }
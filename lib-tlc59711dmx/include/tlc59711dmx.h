@@ -2,7 +2,7 @@
  * @file tlc59711dmx.h
  *
  */
-/* Copyright (C) 2018-2023 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2018-2024 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -100,6 +100,7 @@ private:
 	uint16_t m_nDmxStartAddress { 1 };
 	bool m_bIsStarted { false };
 	bool m_bBlackout { false };
+	bool m_bChanged { true };
 	TLC59711 *m_pTLC59711 { nullptr };
 #if defined (CONFIG_TLC59711DMX_ENABLE_PCT)
 	uint16_t *m_ArrayMaxValue { nullptr };
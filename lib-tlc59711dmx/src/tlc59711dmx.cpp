@@ -154,33 +154,28 @@ void TLC59711Dmx::SetData([[maybe_unused]] uint32_t nPortIndex, const uint8_t *p
 		Start();
 	}
 
-	auto *p = const_cast<uint8_t *>(pDmxData) + m_nDmxStartAddress - 1;
-	auto nDmxAddress = m_nDmxStartAddress;
+	if (__builtin_expect((nLength < m_nDmxStartAddress), 0)) {
+		return;
+	}
 
-	for (uint32_t i = 0; i < m_nDmxFootprint; i++) {
-		if (nDmxAddress > nLength) {
-			break;
-		}
+	auto nChannels = nLength - m_nDmxStartAddress + 1U;
 
-		auto nValue = static_cast<uint16_t>((*p << 8) | *p);
+	if (nChannels > m_nDmxFootprint) {
+		nChannels = m_nDmxFootprint;
+	}
 
 #if defined (CONFIG_TLC59711DMX_ENABLE_PCT)
-		if (nValue > m_ArrayMaxValue[i]) {
-			nValue = m_ArrayMaxValue[i];
-		}
+	m_bChanged |= m_pTLC59711->SetData(&pDmxData[m_nDmxStartAddress - 1], nChannels, m_ArrayMaxValue);
+#else
+	m_bChanged |= m_pTLC59711->SetData(&pDmxData[m_nDmxStartAddress - 1], nChannels);
 #endif
-		m_pTLC59711->Set(i, nValue);
-
-		p++;
-		nDmxAddress++;
-	}
-
-	if (__builtin_expect((nDmxAddress == m_nDmxStartAddress), 0)) {
-		return;
-	}
 
-	if ((doUpdate) && (!m_bBlackout)) {
+	/*
+	 * When no slot has changed since the last update, the SPI bus is left free.
+	 */
+	if ((doUpdate) && (!m_bBlackout) && (m_bChanged)) {
 		m_pTLC59711->Update();
+		m_bChanged = false;
 	}
 }
 
@@ -189,8 +184,9 @@ void TLC59711Dmx::Sync([[maybe_unused]] uint32_t const nPortIndex) {
 }
 
 void TLC59711Dmx::Sync() {
-	if (!m_bBlackout) {
+	if ((!m_bBlackout) && (m_bChanged)) {
 		m_pTLC59711->Update();
+		m_bChanged = false;
 	}
 }
 
@@ -223,6 +219,7 @@ void TLC59711Dmx::Blackout(bool bBlackout) {
 		m_pTLC59711->Blackout();
 	} else {
 		m_pTLC59711->Update();
+		m_bChanged = false;
 	}
 }
 
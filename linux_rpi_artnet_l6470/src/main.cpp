@@ -31,8 +31,10 @@
 #include <signal.h>
 
 #include "hardware.h"
+#include "hal_spibus.h"
 #include "network.h"
 #include "networkconst.h"
+#include "linux/reactor.h"
 
 #include "net/apps/mdns.h"
 
@@ -48,6 +50,7 @@
 #include "rdmpersonality.h"
 #include "rdmdeviceparams.h"
 #include "rdmsensorsparams.h"
+#include "rdmsensors.h"
 #if defined (CONFIG_RDM_ENABLE_SUBDEVICES)
 # include "rdmsubdevicesparams.h"
 #endif
@@ -71,6 +74,7 @@
 
 #include "sparkfundmx.h"
 #include "sparkfundmxconst.h"
+#include "rdmsensorl6470.h"
 
 #include "firmwareversion.h"
 #include "software_version.h"
@@ -83,6 +87,18 @@ void intHandler(int) {
     keepRunning = false;
 }
 
+/*
+ * The subsystems are serviced at least every HOUSEKEEPING_MILLIS,
+ * otherwise only when a packet arrives.
+ */
+static constexpr uint32_t HOUSEKEEPING_MILLIS = 10;
+
+/*
+ * The datagrams already received are handled as one batch before the SPI bus is flushed,
+ * so a TLC59711 frame is written once per batch. Bounded, to keep servicing the motors.
+ */
+static constexpr uint32_t DATAGRAMS_PER_BATCH = 16;
+
 namespace artnetnode {
 namespace configstore {
 uint32_t DMXPORT_OFFSET = 0;
@@ -96,6 +112,7 @@ int main(int argc, char **argv) {
 	Hardware hw;
 	DisplayUdf display;
 	ConfigStore configStore;
+	network::Reactor reactor;
 	Network nw(argc, argv);
 	MDNS mDns;
 	FirmwareVersion fw(SOFTWARE_VERSION, __DATE__, __TIME__);
@@ -164,6 +181,14 @@ int main(int argc, char **argv) {
 	rdmSensorsParams.Load();
 	rdmSensorsParams.Set();
 
+#if defined (RDM_SENSORS_ENABLE) || defined (RDMSENSOR_CPU_ENABLE)
+	for (uint32_t nMotor = 0; nMotor < SPARKFUN_DMX_MAX_MOTORS; nMotor++) {
+		if ((L6470DmxStatus::Get()->GetMotorsMask() & (1U << nMotor)) != 0) {
+			RDMSensors::Get()->Add(new RDMSensorL6470(RDMSensors::Get()->GetCount(), nMotor));
+		}
+	}
+#endif
+
 #if defined (CONFIG_RDM_ENABLE_SUBDEVICES)
 	RDMSubDevicesParams rdmSubDevicesParams;
 	rdmSubDevicesParams.Load();
@@ -228,8 +253,14 @@ int main(int argc, char **argv) {
 
 	display.TextStatus(ArtNetMsgConst::STARTED, CONSOLE_GREEN);
 
+	reactor.TimerAdd(HOUSEKEEPING_MILLIS, nullptr);
+
 	while (keepRunning) {
-		node.Run();
+		reactor.Run();
+		for (uint32_t i = 0; (i < DATAGRAMS_PER_BATCH) && node.Run(); i++)
+			;
+		sparkFunDmx.Run();
+		hal::spi::Bus::Get().Flush();
 		remoteConfig.Run();
 		configStore.Flash();
 		display.Run();